@@ -1,6 +1,48 @@
 #include "Riftline.h"
+#include "Misc/CoreDelegates.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE(FDefaultGameModuleImpl, Riftline, "Riftline");
+namespace
+{
+    class FRiftlineModule : public FDefaultGameModuleImpl
+    {
+    public:
+        virtual void StartupModule() override
+        {
+            // The stats system clears counter stats every frame; clearing the trace counter too keeps Insights in step.
+            BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddLambda([]()
+            {
+                TRACE_COUNTER_SET(RiftlineDelegateBroadcasts, 0);
+            });
+        }
+
+        virtual void ShutdownModule() override
+        {
+            FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+        }
+
+    private:
+        FDelegateHandle BeginFrameHandle;
+    };
+}
+
+IMPLEMENT_PRIMARY_GAME_MODULE(FRiftlineModule, Riftline, "Riftline");
 
 DEFINE_LOG_CATEGORY(LogRiftline);
+
+DEFINE_STAT(STAT_RiftlineHttpInFlight);
+DEFINE_STAT(STAT_RiftlineHttpQueued);
+DEFINE_STAT(STAT_RiftlineTelemetryQueueDepth);
+DEFINE_STAT(STAT_RiftlineDelegateBroadcasts);
+DEFINE_STAT(STAT_RiftlineInteractionQueries);
+
+UE_TRACE_CHANNEL_DEFINE(RiftlineChannel);
+
+TRACE_DECLARE_INT_COUNTER(RiftlineHttpInFlight, TEXT("Riftline/HTTP In Flight"));
+TRACE_DECLARE_INT_COUNTER(RiftlineHttpQueued, TEXT("Riftline/HTTP Queued"));
+TRACE_DECLARE_INT_COUNTER(RiftlineTelemetryQueueDepth, TEXT("Riftline/Telemetry Queue Depth"));
+TRACE_DECLARE_INT_COUNTER(RiftlineDelegateBroadcasts, TEXT("Riftline/Delegate Broadcasts"));
+TRACE_DECLARE_INT_COUNTER(RiftlineInteractionQueries, TEXT("Riftline/Interaction Queries"));
+
+LLM_DEFINE_TAG(Riftline_UI);
+LLM_DEFINE_TAG(Riftline_Network);
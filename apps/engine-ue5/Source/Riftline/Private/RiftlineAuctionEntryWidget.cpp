@@ -0,0 +1,74 @@
+#include "RiftlineAuctionEntryWidget.h"
+
+#include "Components/TextBlock.h"
+#include "RiftlineAuctionModel.h"
+#include "RiftlineNetworkQuality.h"
+
+void URiftlineAuctionEntryWidget::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+    IUserObjectListEntry::NativeOnListItemObjectSet(ListItemObject);
+
+    Unbind();
+    URiftlineAuctionItem* NewItem = Cast<URiftlineAuctionItem>(ListItemObject);
+    Item = NewItem;
+    if (NewItem)
+    {
+        ItemChangedHandle = NewItem->OnChanged.AddUObject(this, &URiftlineAuctionEntryWidget::HandleItemChanged);
+        HandleItemChanged(*NewItem);
+    }
+}
+
+void URiftlineAuctionEntryWidget::NativeOnEntryReleased()
+{
+    Unbind();
+    Item.Reset();
+    IUserObjectListEntry::NativeOnEntryReleased();
+}
+
+void URiftlineAuctionEntryWidget::RefreshCountdown(const FDateTime& Now)
+{
+    const URiftlineAuctionItem* Current = Item.Get();
+    if (!Current || !CountdownText)
+    {
+        return;
+    }
+
+    const int32 Seconds = Current->GetSecondsRemainingAt(Now);
+    if (Seconds == ShownSeconds)
+    {
+        return;
+    }
+
+    ShownSeconds = Seconds;
+    CountdownText->SetText(FText::AsTimespan(FTimespan::FromSeconds(Seconds)));
+}
+
+void URiftlineAuctionEntryWidget::Unbind()
+{
+    if (URiftlineAuctionItem* Current = Item.Get())
+    {
+        Current->OnChanged.Remove(ItemChangedHandle);
+    }
+    ItemChangedHandle.Reset();
+}
+
+void URiftlineAuctionEntryWidget::HandleItemChanged(const URiftlineAuctionItem& Changed)
+{
+    const FRiftlineAuctionRow& Row = Changed.GetRow();
+    if (TitleText)
+    {
+        TitleText->SetText(FText::FromString(Row.Title));
+    }
+    if (AssetTypeText)
+    {
+        AssetTypeText->SetText(FText::FromString(Row.AssetType));
+    }
+    if (PriceText)
+    {
+        PriceText->SetText(FText::FromString(FString::Printf(TEXT("%s %s"), *Row.Price, *Row.PayToken)));
+    }
+
+    ShownSeconds = INDEX_NONE;
+    RefreshCountdown(RiftlineNetwork::GetServerNow());
+    OnAuctionRowChanged(Row);
+}
@@ -0,0 +1,155 @@
+#include "RiftlineAuctionModel.h"
+
+#include "Algo/Sort.h"
+#include "Riftline.h"
+
+namespace
+{
+    bool SameListing(const FRiftlineAuctionRow& A, const FRiftlineAuctionRow& B)
+    {
+        return A.EndsAt == B.EndsAt
+            && A.Title.Equals(B.Title, ESearchCase::CaseSensitive)
+            && A.AssetType.Equals(B.AssetType, ESearchCase::CaseSensitive)
+            && A.PayToken.Equals(B.PayToken, ESearchCase::CaseSensitive)
+            && A.Price.Equals(B.Price, ESearchCase::CaseSensitive);
+    }
+}
+
+int32 URiftlineAuctionItem::GetSecondsRemainingAt(const FDateTime& Now) const
+{
+    return FMath::Max(0, static_cast<int32>(FMath::CeilToDouble((Row.EndsAt - Now).GetTotalSeconds())));
+}
+
+FRiftlineAuctionChangeSet URiftlineAuctionModel::Upsert(const TArray<FRiftlineAuctionRow>& Rows)
+{
+    RIFTLINE_SCOPE(AuctionModelUpsert);
+
+    FRiftlineAuctionChangeSet Changes;
+    const FDateTime Now = RiftlineNetwork::GetServerNow();
+    for (const FRiftlineAuctionRow& Row : Rows)
+    {
+        ApplyRow(Row, Now, Changes);
+    }
+    Publish(Changes);
+    return Changes;
+}
+
+FRiftlineAuctionChangeSet URiftlineAuctionModel::Remove(const TArray<int32>& AuctionIds)
+{
+    RIFTLINE_SCOPE(AuctionModelRemove);
+
+    FRiftlineAuctionChangeSet Changes;
+    RemoveItems(TSet<int32>(AuctionIds), Changes);
+    Publish(Changes);
+    return Changes;
+}
+
+FRiftlineAuctionChangeSet URiftlineAuctionModel::ReplaceAll(const TArray<FRiftlineAuctionRow>& Rows)
+{
+    RIFTLINE_SCOPE(AuctionModelReplaceAll);
+
+    FRiftlineAuctionChangeSet Changes;
+    const FDateTime Now = RiftlineNetwork::GetServerNow();
+
+    TSet<int32> Stale;
+    Stale.Reserve(Items.Num());
+    for (const TPair<int32, URiftlineAuctionItem*>& Pair : Items)
+    {
+        Stale.Add(Pair.Key);
+    }
+    for (const FRiftlineAuctionRow& Row : Rows)
+    {
+        Stale.Remove(Row.AuctionId);
+        ApplyRow(Row, Now, Changes);
+    }
+    RemoveItems(Stale, Changes);
+
+    Publish(Changes);
+    return Changes;
+}
+
+URiftlineAuctionItem* URiftlineAuctionModel::FindItem(int32 AuctionId) const
+{
+    return Items.FindRef(AuctionId);
+}
+
+void URiftlineAuctionModel::ApplyRow(const FRiftlineAuctionRow& Row, const FDateTime& Now, FRiftlineAuctionChangeSet& Changes)
+{
+    FRiftlineAuctionRow Normalized = Row;
+    if (Normalized.EndsAt.GetTicks() == 0)
+    {
+        Normalized.EndsAt = Now + FTimespan::FromSeconds(FMath::Max(Row.SecondsRemaining, 0));
+    }
+
+    if (URiftlineAuctionItem* Existing = Items.FindRef(Row.AuctionId))
+    {
+        // Feeds without EndsAt re-derive it from SecondsRemaining on every push; sub-second drift is not a change.
+        if (Row.EndsAt.GetTicks() == 0 && FMath::Abs((Normalized.EndsAt - Existing->Row.EndsAt).GetTotalSeconds()) < 1.0)
+        {
+            Normalized.EndsAt = Existing->Row.EndsAt;
+        }
+        if (SameListing(Existing->Row, Normalized))
+        {
+            return;
+        }
+
+        if (Existing->Row.EndsAt != Normalized.EndsAt)
+        {
+            Changes.bOrderChanged = true;
+            bNeedsSort = true;
+        }
+        Existing->Row = MoveTemp(Normalized);
+        Changes.Updated.Add(Row.AuctionId);
+        Existing->OnChanged.Broadcast(*Existing);
+        return;
+    }
+
+    URiftlineAuctionItem* Item = NewObject<URiftlineAuctionItem>(this);
+    Item->Row = MoveTemp(Normalized);
+    Items.Add(Row.AuctionId, Item);
+    Ordered.Add(Item);
+    Changes.Added.Add(Row.AuctionId);
+    Changes.bOrderChanged = true;
+    bNeedsSort = true;
+}
+
+void URiftlineAuctionModel::RemoveItems(const TSet<int32>& AuctionIds, FRiftlineAuctionChangeSet& Changes)
+{
+    int32 Removed = 0;
+    for (const int32 AuctionId : AuctionIds)
+    {
+        if (Items.Remove(AuctionId) > 0)
+        {
+            Changes.Removed.Add(AuctionId);
+            ++Removed;
+        }
+    }
+    if (Removed == 0)
+    {
+        return;
+    }
+
+    // One pass over the ordered list however many listings went away.
+    Ordered.RemoveAll([&AuctionIds](const URiftlineAuctionItem* Item) { return AuctionIds.Contains(Item->Row.AuctionId); });
+    Changes.bOrderChanged = true;
+}
+
+void URiftlineAuctionModel::Publish(const FRiftlineAuctionChangeSet& Changes)
+{
+    if (Changes.IsEmpty())
+    {
+        return;
+    }
+
+    if (bNeedsSort)
+    {
+        bNeedsSort = false;
+        Algo::Sort(Ordered, [](const URiftlineAuctionItem* A, const URiftlineAuctionItem* B)
+        {
+            return A->Row.EndsAt != B->Row.EndsAt ? A->Row.EndsAt < B->Row.EndsAt : A->Row.AuctionId < B->Row.AuctionId;
+        });
+    }
+
+    RIFTLINE_COUNTER_INC(RiftlineDelegateBroadcasts);
+    OnChanged.Broadcast(Changes);
+}
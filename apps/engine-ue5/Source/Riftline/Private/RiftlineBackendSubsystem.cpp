@@ -0,0 +1,151 @@
+#include "RiftlineBackendSubsystem.h"
+
+#include "Async/Async.h"
+#include "Riftline.h"
+#include "RiftlineGameInstance.h"
+#include "RiftlineHttpScheduler.h"
+#include "RiftlineJsonDecoder.h"
+
+bool URiftlineBackendSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    return Super::ShouldCreateSubsystem(Outer) && Cast<URiftlineGameInstance>(Outer) && !IsRunningDedicatedServer();
+}
+
+void URiftlineBackendSubsystem::SetAuthToken(const FString& Token)
+{
+    AuthToken = Token;
+    CastChecked<URiftlineGameInstance>(GetGameInstance())->SetAuthToken(Token);
+    if (!AuthToken.IsEmpty())
+    {
+        RefreshProfile();
+    }
+}
+
+void URiftlineBackendSubsystem::RefreshProfile()
+{
+    Fetch(EEndpoint::Profile, TEXT("/players/me"), [WeakThis = TWeakObjectPtr<URiftlineBackendSubsystem>(this)](TArray<uint8>&& Body, uint32 Generation)
+    {
+        // One conversion feeds both decodes; the wallet fields sit at the top level of the player record.
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, Generation, Body = MoveTemp(Body)]()
+        {
+            const FString Json = RiftlineJson::Utf8ToString(Body);
+            FRiftlineSessionProfile Profile;
+            FRiftlineWalletView Wallet;
+            if (!RiftlineJson::Decode(Json, Profile) || !RiftlineJson::Decode(Json, Wallet))
+            {
+                UE_LOG(LogRiftline, Warning, TEXT("Discarded malformed player profile"));
+                return;
+            }
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, Generation, Profile = MoveTemp(Profile), Wallet = MoveTemp(Wallet)]() mutable
+            {
+                if (WeakThis.IsValid() && WeakThis->IsCurrent(EEndpoint::Profile, Generation))
+                {
+                    WeakThis->ApplyProfile(MoveTemp(Profile), MoveTemp(Wallet));
+                }
+            });
+        });
+    });
+}
+
+void URiftlineBackendSubsystem::RefreshShards()
+{
+    Fetch(EEndpoint::Shards, TEXT("/shards"), [WeakThis = TWeakObjectPtr<URiftlineBackendSubsystem>(this)](TArray<uint8>&& Body, uint32 Generation)
+    {
+        RiftlineJson::DecodeAsync<TArray<FRiftlineShardStatus>>(MoveTemp(Body), [WeakThis, Generation](bool bSucceeded, TArray<FRiftlineShardStatus>&& Shards)
+        {
+            if (!bSucceeded || !WeakThis.IsValid() || !WeakThis->IsCurrent(EEndpoint::Shards, Generation))
+            {
+                return;
+            }
+
+            URiftlineGameInstance* GameInstance = CastChecked<URiftlineGameInstance>(WeakThis->GetGameInstance());
+            const int32 CurrentShardId = GameInstance->GetSessionProfile().CurrentShard.ShardId;
+            if (const FRiftlineShardStatus* Current = Shards.FindByPredicate([CurrentShardId](const FRiftlineShardStatus& Shard) { return Shard.ShardId == CurrentShardId; }))
+            {
+                GameInstance->UpdateShardStatus(*Current);
+            }
+            WeakThis->OnShardsLoaded.Broadcast(Shards);
+        });
+    });
+}
+
+void URiftlineBackendSubsystem::RefreshAuctions()
+{
+    Fetch(EEndpoint::Auctions, TEXT("/auctions"), [WeakThis = TWeakObjectPtr<URiftlineBackendSubsystem>(this)](TArray<uint8>&& Body, uint32 Generation)
+    {
+        RiftlineJson::DecodeAsync<TArray<FRiftlineAuctionRow>>(MoveTemp(Body), [WeakThis, Generation](bool bSucceeded, TArray<FRiftlineAuctionRow>&& Rows)
+        {
+            if (bSucceeded && WeakThis.IsValid() && WeakThis->IsCurrent(EEndpoint::Auctions, Generation))
+            {
+                WeakThis->OnAuctionsLoaded.Broadcast(Rows);
+            }
+        });
+    });
+}
+
+template <typename FuncType>
+void URiftlineBackendSubsystem::Fetch(EEndpoint Endpoint, const TCHAR* Path, FuncType&& OnBody)
+{
+    const URiftlineGameInstance* GameInstance = CastChecked<URiftlineGameInstance>(GetGameInstance());
+    const TSharedPtr<FRiftlineHttpScheduler, ESPMode::ThreadSafe> Scheduler = GameInstance->GetHttpScheduler();
+    FString BaseUrl = GameInstance->GetApiBaseUrl();
+    if (!Scheduler || BaseUrl.IsEmpty())
+    {
+        return;
+    }
+    BaseUrl.RemoveFromEnd(TEXT("/"));
+
+    // The player is looking at whatever asked for this, so it goes ahead of gameplay traffic.
+    FRiftlineHttpRequest Request;
+    Request.Url = BaseUrl + Path;
+    Request.Verb = TEXT("GET");
+    Request.Priority = ERiftlineHttpPriority::Interactive;
+    Request.SetHeader(TEXT("Accept"), TEXT("application/json"));
+    if (!AuthToken.IsEmpty())
+    {
+        Request.SetHeader(TEXT("Authorization"), TEXT("Bearer ") + AuthToken);
+    }
+
+    const uint32 Generation = ++Generations[static_cast<int32>(Endpoint)];
+    Scheduler->Submit(MoveTemp(Request), FRiftlineHttpCompleteDelegate::CreateLambda(
+        [WeakThis = TWeakObjectPtr<URiftlineBackendSubsystem>(this), Endpoint, Generation, Path, OnBody = Forward<FuncType>(OnBody)](const FRiftlineHttpResult& Result)
+    {
+        if (!WeakThis.IsValid() || !WeakThis->IsCurrent(Endpoint, Generation))
+        {
+            return;
+        }
+        if (!Result.IsOk())
+        {
+            UE_LOG(LogRiftline, Warning, TEXT("GET %s failed (connected=%d code=%d)"), Path, Result.bConnected, Result.Code);
+            return;
+        }
+        OnBody(TArray<uint8>(Result.Content), Generation);
+    }));
+}
+
+void URiftlineBackendSubsystem::ApplyProfile(FRiftlineSessionProfile&& Decoded, FRiftlineWalletView&& DecodedWallet)
+{
+    URiftlineGameInstance* GameInstance = CastChecked<URiftlineGameInstance>(GetGameInstance());
+    const FRiftlineSessionStore& Store = GameInstance->GetSessionStore();
+
+    // Wanted and compliance stay with the realtime socket, which pushes them as they change.
+    FRiftlineSessionProfile Profile = Store.GetProfile();
+    Profile.Wallet = MoveTemp(Decoded.Wallet);
+    Profile.PlayerId = MoveTemp(Decoded.PlayerId);
+    Profile.DisplayName = MoveTemp(Decoded.DisplayName);
+    if (Decoded.CurrentShard.ShardId != INDEX_NONE)
+    {
+        Profile.CurrentShard = MoveTemp(Decoded.CurrentShard);
+    }
+    GameInstance->SetSessionProfile(Profile);
+
+    FRiftlineWalletView Wallet = Store.GetWalletView();
+    Wallet.Address = MoveTemp(DecodedWallet.Address);
+    Wallet.SoftCurrency = DecodedWallet.SoftCurrency;
+    if (DecodedWallet.ShardId != INDEX_NONE)
+    {
+        Wallet.ShardId = DecodedWallet.ShardId;
+    }
+    GameInstance->UpdateWalletView(Wallet);
+}
@@ -0,0 +1,173 @@
+#include "RiftlineDeviceState.h"
+
+#include "Algo/BinarySearch.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Riftline.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    ERiftlineThermalState FromSeverity(FCoreDelegates::ETemperatureSeverity Severity)
+    {
+        switch (Severity)
+        {
+        case FCoreDelegates::ETemperatureSeverity::Good:     return ERiftlineThermalState::Nominal;
+        case FCoreDelegates::ETemperatureSeverity::Bad:      return ERiftlineThermalState::Fair;
+        case FCoreDelegates::ETemperatureSeverity::Serious:  return ERiftlineThermalState::Serious;
+        case FCoreDelegates::ETemperatureSeverity::Critical: return ERiftlineThermalState::Critical;
+        default:                                             return ERiftlineThermalState::Unknown;
+        }
+    }
+}
+
+TUniquePtr<IRiftlineDeviceStateProvider> IRiftlineDeviceStateProvider::Create()
+{
+    FString ScriptPath;
+    if (FParse::Value(FCommandLine::Get(), TEXT("RiftlineDeviceScript="), ScriptPath))
+    {
+        TUniquePtr<FRiftlineScriptedDeviceStateProvider> Scripted = MakeUnique<FRiftlineScriptedDeviceStateProvider>();
+        if (Scripted->LoadFromFile(ScriptPath))
+        {
+            UE_LOG(LogRiftline, Log, TEXT("Using scripted device state from %s"), *ScriptPath);
+            return Scripted;
+        }
+        UE_LOG(LogRiftline, Warning, TEXT("Could not load device script %s; using platform readings"), *ScriptPath);
+    }
+    return MakeUnique<FRiftlinePlatformDeviceStateProvider>();
+}
+
+FRiftlinePlatformDeviceStateProvider::FRiftlinePlatformDeviceStateProvider()
+{
+    TemperatureHandle = FCoreDelegates::OnTemperatureChange.AddLambda([this](FCoreDelegates::ETemperatureSeverity Severity)
+    {
+        LastThermal = FromSeverity(Severity);
+    });
+}
+
+FRiftlinePlatformDeviceStateProvider::~FRiftlinePlatformDeviceStateProvider()
+{
+    FCoreDelegates::OnTemperatureChange.Remove(TemperatureHandle);
+}
+
+FRiftlineDeviceState FRiftlinePlatformDeviceStateProvider::Sample()
+{
+    FRiftlineDeviceState State;
+    State.Thermal = LastThermal;
+
+    const int32 Battery = FPlatformMisc::GetBatteryLevel();
+    State.BatteryLevel = Battery >= 0 ? Battery / 100.f : -1.f;
+    State.bOnBattery = FPlatformMisc::IsRunningOnBattery();
+    return State;
+}
+
+FName FRiftlinePlatformDeviceStateProvider::GetSourceName() const
+{
+    static const FName PlatformName(FPlatformProperties::IniPlatformName());
+    return PlatformName;
+}
+
+bool FRiftlineScriptedDeviceStateProvider::LoadFromFile(const FString& Path)
+{
+    FString Contents;
+    if (!FFileHelper::LoadFileToString(Contents, *Path))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Root;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Contents);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        return false;
+    }
+
+    Root->TryGetBoolField(TEXT("loop"), bLoop);
+
+    const TArray<TSharedPtr<FJsonValue>>* Frames = nullptr;
+    if (!Root->TryGetArrayField(TEXT("keyframes"), Frames))
+    {
+        return false;
+    }
+
+    const UEnum* ThermalEnum = StaticEnum<ERiftlineThermalState>();
+    FRiftlineDeviceState Current;
+    for (const TSharedPtr<FJsonValue>& Value : *Frames)
+    {
+        const TSharedPtr<FJsonObject>* Frame = nullptr;
+        if (!Value.IsValid() || !Value->TryGetObject(Frame))
+        {
+            continue;
+        }
+
+        double Time = 0.0;
+        (*Frame)->TryGetNumberField(TEXT("t"), Time);
+
+        FString Thermal;
+        if ((*Frame)->TryGetStringField(TEXT("thermal"), Thermal))
+        {
+            const int64 Parsed = ThermalEnum->GetValueByNameString(Thermal);
+            Current.Thermal = Parsed != INDEX_NONE ? static_cast<ERiftlineThermalState>(Parsed) : ERiftlineThermalState::Unknown;
+        }
+
+        double Battery = 0.0;
+        if ((*Frame)->TryGetNumberField(TEXT("battery"), Battery))
+        {
+            Current.BatteryLevel = static_cast<float>(Battery);
+        }
+        (*Frame)->TryGetBoolField(TEXT("onBattery"), Current.bOnBattery);
+
+        AddKeyframe(Time, Current);
+    }
+    return Keyframes.Num() > 0;
+}
+
+void FRiftlineScriptedDeviceStateProvider::AddKeyframe(double TimeSeconds, const FRiftlineDeviceState& State)
+{
+    const int32 Index = Algo::LowerBoundBy(Keyframes, TimeSeconds, [](const TPair<double, FRiftlineDeviceState>& Frame) { return Frame.Key; });
+    Keyframes.Insert(TPair<double, FRiftlineDeviceState>(TimeSeconds, State), Index);
+}
+
+FRiftlineDeviceState FRiftlineScriptedDeviceStateProvider::Sample()
+{
+    if (Keyframes.Num() == 0)
+    {
+        return FRiftlineDeviceState();
+    }
+
+    const double Now = Clock ? Clock() : FPlatformTime::Seconds();
+    if (StartSeconds < 0.0)
+    {
+        StartSeconds = Now;
+    }
+
+    double Elapsed = Now - StartSeconds;
+    const double Duration = Keyframes.Last().Key;
+    if (bLoop && Duration > 0.0)
+    {
+        Elapsed = FMath::Fmod(Elapsed, Duration);
+    }
+
+    const FRiftlineDeviceState* Active = &Keyframes[0].Value;
+    for (const TPair<double, FRiftlineDeviceState>& Frame : Keyframes)
+    {
+        if (Frame.Key > Elapsed)
+        {
+            break;
+        }
+        Active = &Frame.Value;
+    }
+    return *Active;
+}
+
+FName FRiftlineScriptedDeviceStateProvider::GetSourceName() const
+{
+    static const FName ScriptedName(TEXT("scripted"));
+    return ScriptedName;
+}
@@ -1,17 +1,51 @@
 #include "RiftlineGameInstance.h"
 
-#include "Algo/Sort.h"
+#include "Dom/JsonObject.h"
 #include "Engine/Engine.h"
-#include "HAL/PlatformProperties.h"
-#include "HttpModule.h"
-#include "Interfaces/IHttpRequest.h"
-#include "Interfaces/IHttpResponse.h"
+#include "Framework/Application/SlateApplication.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
 #include "Riftline.h"
+#include "RiftlineInteractionComponent.h"
 #include "RiftlinePhoneWidget.h"
+#include "RiftlineTelemetry.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 #include "TimerManager.h"
 
 namespace
 {
+    FRiftlineTelemetryPolicy MakeRollupPolicy(FName Event, FName GroupByKey)
+    {
+        FRiftlineTelemetryPolicy Policy;
+        Policy.Event = Event;
+        Policy.bAggregateOnly = true;
+        Policy.GroupByKey = GroupByKey;
+        return Policy;
+    }
+
+    FRiftlineTelemetryPolicy MakeRateLimitPolicy(FName Event, float PerSecond, int32 Burst)
+    {
+        FRiftlineTelemetryPolicy Policy;
+        Policy.Event = Event;
+        Policy.RateLimitPerSecond = PerSecond;
+        Policy.RateLimitBurst = Burst;
+        return Policy;
+    }
+
+    FRiftlineGovernorStep MakeGovernorStep(int32 ScalabilityLevel, float MaxFps, float ScreenPercentage)
+    {
+        FRiftlineGovernorStep Step;
+        Step.ScalabilityLevel = ScalabilityLevel;
+        Step.MaxFps = MaxFps;
+        Step.ScreenPercentage = ScreenPercentage;
+        return Step;
+    }
+
     FString ComposeEndpoint(const FString& BaseUrl, const FString& Path)
     {
         if (BaseUrl.IsEmpty())
@@ -33,20 +67,88 @@ URiftlineGameInstance::URiftlineGameInstance()
 {
     ApiBaseUrl = TEXT("http://localhost:8080");
     NakamaUrl = TEXT("http://localhost:7350");
-    FpsSamples.Reserve(120);
+    NakamaServerKey = TEXT("defaultkey");
+    TelemetryJournalDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"));
+    HttpMaxConnectionsPerHost = PLATFORM_ANDROID || PLATFORM_IOS ? 4 : 6;
+    HttpMaxConnections = PLATFORM_ANDROID || PLATFORM_IOS ? 6 : 12;
+    HeartbeatInterval = 15.f;
+    HeartbeatJitter = 0.2f;
+    HeartbeatMaxInterval = 300.f;
+    HeartbeatBackgroundMultiplier = 4.f;
+    HeartbeatIdleMultiplier = 2.f;
+    HeartbeatIdleSeconds = 120.f;
+    TelemetryBatchSize = 20;
+    TelemetryFlushInterval = 10.f;
+    TelemetryQueueCapacity = 1024;
+    TelemetryJournalMaxMegabytes = 8;
+    TelemetryWireFormat = ERiftlineTelemetryWireFormat::Json;
+    TelemetryRollupInterval = 60.f;
+    TelemetryShutdownFlushSeconds = 2.f;
+
+    using namespace RiftlineTelemetry;
+    TelemetryPolicies.Add(MakeRollupPolicy(Events::PhoneTab, Keys::Tab));
+    TelemetryPolicies.Add(MakeRollupPolicy(Events::RadialSelect, Keys::Option));
+    TelemetryPolicies.Add(MakeRateLimitPolicy(Events::PhoneOpen, 0.2f, 3));
+    TelemetryPolicies.Add(MakeRateLimitPolicy(Events::PhoneClose, 0.2f, 3));
+    TelemetryPolicies.Add(MakeRateLimitPolicy(Events::ClientHitch, 0.5f, 5));
+
+    FRiftlineTelemetryPolicy MarketViewPolicy;
+    MarketViewPolicy.Event = Events::MarketView;
+    MarketViewPolicy.SampleRate = 0.25f;
+    MarketViewPolicy.ValueKey = Keys::Items;
+    TelemetryPolicies.Add(MarketViewPolicy);
+    TelemetryHitchThresholdMs = 50.f;
+    TelemetryMaxHitchReports = 10;
+
+    bEnableScalabilityGovernor = PLATFORM_ANDROID || PLATFORM_IOS;
+    GovernorDownWindows = 2;
+    GovernorUpWindows = 4;
+    GovernorSteps.Add(MakeGovernorStep(3, 60.f, 100.f));
+    GovernorSteps.Add(MakeGovernorStep(2, 60.f, 90.f));
+    GovernorSteps.Add(MakeGovernorStep(2, 45.f, 80.f));
+    GovernorSteps.Add(MakeGovernorStep(1, 30.f, 70.f));
+    GovernorSteps.Add(MakeGovernorStep(0, 30.f, 60.f));
 }
 
 void URiftlineGameInstance::Init()
 {
     Super::Init();
+    FRiftlineTelemetrySchemaRegistry::Get().RegisterBuiltInSchemas();
     InitialiseFromEnvironment();
+    SessionSubscription = SessionStore.Subscribe(
+        ERiftlineSessionField::Identity | ERiftlineSessionField::Wallet | ERiftlineSessionField::Shard | ERiftlineSessionField::Wanted | ERiftlineSessionField::Compliance,
+        FRiftlineSessionChangeDelegate::CreateUObject(this, &URiftlineGameInstance::HandleSessionChanges));
+    SessionStore.Start();
+
+    FRiftlineHttpSchedulerSettings HttpSettings;
+    HttpSettings.MaxConnectionsPerHost = HttpMaxConnectionsPerHost;
+    HttpSettings.MaxConnections = HttpMaxConnections;
+    HttpScheduler = MakeShared<FRiftlineHttpScheduler, ESPMode::ThreadSafe>(HttpSettings);
+    HttpAttemptHandle = HttpScheduler->OnAttempt().AddUObject(this, &URiftlineGameInstance::HandleHttpAttempt);
+    HttpScheduler->Start();
+
+    StartTelemetry();
+    StartPerformanceMonitoring();
     StartHeartbeat();
 }
 
 void URiftlineGameInstance::Shutdown()
 {
     StopHeartbeat();
+    StopPerformanceMonitoring();
+    StopTelemetry();
+    SessionStore.Stop();
+    SessionStore.Unsubscribe(SessionSubscription);
+    SessionStore.Unsubscribe(PhoneSubscription);
     Super::Shutdown();
+
+    // Stopped after subsystems deinitialise, so their failed callbacks land on already-disconnected clients.
+    if (HttpScheduler)
+    {
+        HttpScheduler->OnAttempt().Remove(HttpAttemptHandle);
+        HttpScheduler->Stop();
+        HttpScheduler.Reset();
+    }
 }
 
 void URiftlineGameInstance::InitialiseFromEnvironment()
@@ -63,135 +165,264 @@ void URiftlineGameInstance::InitialiseFromEnvironment()
         NakamaUrl = NakamaOverride;
     }
 
+    const FString NakamaKeyOverride = FPlatformMisc::GetEnvironmentVariable(TEXT("RIFTLINE_NAKAMA_SERVER_KEY"));
+    if (!NakamaKeyOverride.IsEmpty())
+    {
+        NakamaServerKey = NakamaKeyOverride;
+    }
+
     UE_LOG(LogRiftline, Log, TEXT("Initialised GameInstance with API=%s Nakama=%s"), *ApiBaseUrl, *NakamaUrl);
 }
 
-void URiftlineGameInstance::SetSessionProfile(const FRiftlineSessionProfile& NewProfile)
+void URiftlineGameInstance::StartTelemetry()
 {
-    Session = NewProfile;
-    OnSessionChanged.Broadcast(Session);
-
-    if (PhoneWidget.IsValid())
+    LLM_SCOPE_BYTAG(Riftline_Network);
+
+    FRiftlineTelemetryPipelineSettings Settings;
+    Settings.Url = ComposeEndpoint(ApiBaseUrl, TEXT("/telemetry/events"));
+    Settings.BatchSize = TelemetryBatchSize;
+    Settings.FlushInterval = TelemetryFlushInterval;
+    Settings.QueueCapacity = TelemetryQueueCapacity;
+    Settings.JournalDirectory = TelemetryJournalDirectory;
+    Settings.MaxJournalBytes = static_cast<int64>(TelemetryJournalMaxMegabytes) * 1024 * 1024;
+    Settings.WireFormat = TelemetryWireFormat;
+    Settings.Scheduler = HttpScheduler;
+    Settings.HeartbeatUrl = ComposeEndpoint(ApiBaseUrl, TEXT("/players/heartbeat"));
+    Settings.MaxPiggybackWait = FMath::Max(TelemetryFlushInterval, HeartbeatInterval * (1.f + HeartbeatJitter) * 2.f);
+    Settings.ShutdownFlushTimeout = TelemetryShutdownFlushSeconds;
+
+    TelemetryPipeline = MakeUnique<FRiftlineTelemetryPipeline>(Settings);
+    TelemetryPipeline->SetPlayerId(GetSessionProfile().PlayerId);
+    TelemetryPipeline->SetAuthToken(AuthToken);
+    TelemetryPipeline->Start();
+
+    TelemetryPolicy.ResetPolicies(TelemetryPolicies);
+    if (GetWorld())
     {
-        PhoneWidget->HandleSessionUpdated(Session);
+        GetWorld()->GetTimerManager().SetTimer(TelemetryRollupTimerHandle, this, &URiftlineGameInstance::EmitTelemetryRollups, TelemetryRollupInterval, true);
     }
 }
 
-void URiftlineGameInstance::ApplyWantedState(const FRiftlineWantedState& Wanted)
+void URiftlineGameInstance::StopTelemetry()
 {
-    Session.Wanted = Wanted;
-    OnWantedStateChanged.Broadcast(Session.Wanted);
-    SubmitWantedTelemetry(Wanted);
+    if (GetWorld())
+    {
+        GetWorld()->GetTimerManager().ClearTimer(TelemetryRollupTimerHandle);
+    }
 
-    if (PhoneWidget.IsValid())
+    if (TelemetryPipeline)
     {
-        PhoneWidget->HandleWantedUpdated(Wanted);
+        EmitTelemetryRollups();
+        TelemetryPipeline->StopAndFlush();
+        TelemetryPipeline.Reset();
     }
 }
 
-void URiftlineGameInstance::ClearWanted()
+void URiftlineGameInstance::StartPerformanceMonitoring()
 {
-    Session.Wanted = FRiftlineWantedState();
-    OnWantedStateChanged.Broadcast(Session.Wanted);
-    SubmitWantedTelemetry(Session.Wanted);
+    PerformanceMonitor = MakeUnique<FRiftlinePerformanceMonitor>(TelemetryHitchThresholdMs, TelemetryMaxHitchReports);
+    PerformanceMonitor->OnHitch.BindUObject(this, &URiftlineGameInstance::HandleHitch);
+    PerformanceMonitor->Start();
 
-    if (PhoneWidget.IsValid())
+    DeviceStateProvider = IRiftlineDeviceStateProvider::Create();
+    DeviceState = DeviceStateProvider->Sample();
+
+    if (bEnableScalabilityGovernor || FParse::Param(FCommandLine::Get(), TEXT("RiftlineGovernor")))
     {
-        PhoneWidget->HandleWantedUpdated(Session.Wanted);
+        Governor = MakeUnique<FRiftlineScalabilityGovernor>(GovernorSteps, GovernorDownWindows, GovernorUpWindows);
+        Governor->Start();
     }
 }
 
-void URiftlineGameInstance::UpdateShardStatus(const FRiftlineShardStatus& Status)
+void URiftlineGameInstance::StopPerformanceMonitoring()
 {
-    Session.CurrentShard = Status;
-    OnSessionChanged.Broadcast(Session);
+    Governor.Reset();
+    PerformanceMonitor.Reset();
+    DeviceStateProvider.Reset();
+}
 
-    if (PhoneWidget.IsValid())
+void URiftlineGameInstance::SetSessionProfile(const FRiftlineSessionProfile& NewProfile)
+{
+    RIFTLINE_SCOPE(SetSessionProfile);
+
+    SessionStore.SetProfile(NewProfile);
+    if (TelemetryPipeline)
     {
-        PhoneWidget->HandleShardStatus(Status);
+        TelemetryPipeline->SetPlayerId(NewProfile.PlayerId);
     }
 }
 
-void URiftlineGameInstance::UpdateCompliance(const FRiftlineComplianceState& ComplianceState)
+void URiftlineGameInstance::SetAuthToken(const FString& Token)
 {
-    Session.Compliance = ComplianceState;
-    OnComplianceChanged.Broadcast(Session.Compliance);
-
-    if (PhoneWidget.IsValid())
+    AuthToken = Token;
+    if (TelemetryPipeline)
     {
-        PhoneWidget->HandleComplianceUpdated(ComplianceState);
+        TelemetryPipeline->SetAuthToken(Token);
     }
 }
 
-void URiftlineGameInstance::UpdateWalletView(const FRiftlineWalletView& WalletViewIn)
+void URiftlineGameInstance::ApplyWantedState(const FRiftlineWantedState& Wanted)
 {
-    WalletView = WalletViewIn;
+    RIFTLINE_SCOPE(ApplyWantedState);
 
-    if (PhoneWidget.IsValid())
-    {
-        PhoneWidget->HandleWalletUpdated(WalletView);
-    }
+    SessionStore.SetWanted(Wanted);
+    SubmitWantedTelemetry(Wanted);
+}
+
+void URiftlineGameInstance::ClearWanted()
+{
+    SessionStore.SetWanted(FRiftlineWantedState());
+    SubmitWantedTelemetry(GetSessionProfile().Wanted);
+}
+
+void URiftlineGameInstance::UpdateShardStatus(const FRiftlineShardStatus& Status)
+{
+    RIFTLINE_SCOPE(UpdateShardStatus);
+
+    SessionStore.SetShard(Status);
+}
+
+void URiftlineGameInstance::UpdateCompliance(const FRiftlineComplianceState& ComplianceState)
+{
+    RIFTLINE_SCOPE(UpdateCompliance);
+
+    SessionStore.SetCompliance(ComplianceState);
+}
+
+void URiftlineGameInstance::UpdateWalletView(const FRiftlineWalletView& WalletView)
+{
+    SessionStore.SetWalletView(WalletView);
 }
 
 void URiftlineGameInstance::UpdateActiveMissions(const TArray<FText>& Missions)
 {
-    ActiveMissions = Missions;
+    SessionStore.SetMissions(Missions);
+}
+
+void URiftlineGameInstance::HandleSessionChanges(const FRiftlineSessionStore& Store, ERiftlineSessionField Changed)
+{
+    RIFTLINE_SCOPE(SessionChanges);
 
-    if (PhoneWidget.IsValid())
+    const FRiftlineSessionProfile& Profile = Store.GetProfile();
+    if (EnumHasAnyFlags(Changed, ERiftlineSessionField::Identity | ERiftlineSessionField::Wallet))
     {
-        PhoneWidget->HandleMissionsUpdated(ActiveMissions);
+        OnSessionChanged.Broadcast(Profile);
+    }
+    if (EnumHasAnyFlags(Changed, ERiftlineSessionField::Shard))
+    {
+        OnShardChanged.Broadcast(Profile.CurrentShard);
+    }
+    if (EnumHasAnyFlags(Changed, ERiftlineSessionField::Wanted))
+    {
+        OnWantedStateChanged.Broadcast(Profile.Wanted);
+    }
+    if (EnumHasAnyFlags(Changed, ERiftlineSessionField::Compliance))
+    {
+        OnComplianceChanged.Broadcast(Profile.Compliance);
     }
 }
 
 void URiftlineGameInstance::PushTelemetryEvent(const FString& Event, const TMap<FString, FString>& Properties)
 {
-    if (Session.PlayerId.IsEmpty())
+    if (GetSessionProfile().PlayerId.IsEmpty() || Event.IsEmpty())
+    {
+        return;
+    }
+
+    // Blueprint hands every value over as text; events with a schema get them back as the types it declares.
+    FRiftlineTelemetryEvent TypedEvent{FName(*Event)};
+    const FRiftlineTelemetrySchema* Schema = FRiftlineTelemetrySchemaRegistry::Get().Find(TypedEvent.GetName());
+    for (const TPair<FString, FString>& Pair : Properties)
+    {
+        if (!Schema)
+        {
+            TypedEvent.AddString(FName(*Pair.Key), Pair.Value);
+        }
+        else if (!RiftlineTelemetry::AddParsed(TypedEvent, *Schema, FName(*Pair.Key), Pair.Value))
+        {
+            UE_LOG(LogRiftline, Warning, TEXT("Dropping telemetry event %s: %s=\"%s\" does not fit its schema"), *Event, *Pair.Key, *Pair.Value);
+            if (TelemetryPipeline)
+            {
+                TelemetryPipeline->CountDropped();
+            }
+            return;
+        }
+    }
+    PushTelemetry(TypedEvent);
+}
+
+void URiftlineGameInstance::PushTelemetry(const FRiftlineTelemetryEvent& Event)
+{
+    RIFTLINE_SCOPE(PushTelemetry);
+
+    if (GetSessionProfile().PlayerId.IsEmpty() || !TelemetryPipeline)
     {
         return;
     }
 
-    const FString Url = ComposeEndpoint(ApiBaseUrl, TEXT("/telemetry/events"));
-    if (Url.IsEmpty())
+#if !UE_BUILD_SHIPPING
+    if (!ensure(FRiftlineTelemetrySchemaRegistry::Get().Validate(Event)))
     {
+        TelemetryPipeline->CountDropped();
         return;
     }
+#endif
 
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-    Request->SetURL(Url);
-    Request->SetVerb(TEXT("POST"));
-    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+    if (!TelemetryPolicy.Admit(Event, FPlatformTime::Seconds()))
+    {
+        return;
+    }
 
-    FString JsonPayload = TEXT("{");
-    JsonPayload += FString::Printf(TEXT("\"playerId\":\"%s\","), *Session.PlayerId);
-    JsonPayload += FString::Printf(TEXT("\"event\":\"%s\","), *Event);
-    JsonPayload += TEXT("\"properties\":{");
+    const FDateTime Now = FDateTime::UtcNow();
+    const int64 TimestampMs = Now.ToUnixTimestamp() * 1000 + Now.GetMillisecond();
+    TelemetryPipeline->Enqueue(Event, TimestampMs, GetSessionProfile().CurrentShard.ShardId);
+}
 
-    bool bFirst = true;
-    for (const TPair<FString, FString>& Pair : Properties)
+void URiftlineGameInstance::FlushTelemetry()
+{
+    if (TelemetryPipeline)
     {
-        if (!bFirst)
-        {
-            JsonPayload += TEXT(",");
-        }
-        JsonPayload += FString::Printf(TEXT("\"%s\":\"%s\""), *Pair.Key.ReplaceCharWithEscapedChar(), *Pair.Value.ReplaceCharWithEscapedChar());
-        bFirst = false;
+        TelemetryPipeline->RequestFlush();
+    }
+}
+
+int64 URiftlineGameInstance::GetTelemetryDroppedCount() const
+{
+    return TelemetryPipeline ? static_cast<int64>(TelemetryPipeline->GetDroppedCount()) : 0;
+}
+
+void URiftlineGameInstance::SetTelemetryPolicy(const FRiftlineTelemetryPolicy& Policy)
+{
+    TelemetryPolicy.SetPolicy(Policy);
+}
+
+void URiftlineGameInstance::ClearTelemetryPolicy(FName Event)
+{
+    TelemetryPolicy.ClearPolicy(Event);
+}
+
+void URiftlineGameInstance::EmitTelemetryRollups()
+{
+    TArray<FRiftlineTelemetryEvent> Rollups;
+    TelemetryPolicy.CollectRollups(Rollups);
+    for (const FRiftlineTelemetryEvent& Rollup : Rollups)
+    {
+        PushTelemetry(Rollup);
     }
-    JsonPayload += TEXT("}}");
-    Request->SetContentAsString(JsonPayload);
-    Request->ProcessRequest();
 }
 
 void URiftlineGameInstance::RegisterPhoneWidget(URiftlinePhoneWidget* Widget)
 {
+    SessionStore.Unsubscribe(PhoneSubscription);
+    PhoneSubscription.Reset();
+
     PhoneWidget = Widget;
     if (PhoneWidget.IsValid())
     {
-        PhoneWidget->HandleSessionUpdated(Session);
-        PhoneWidget->HandleWantedUpdated(Session.Wanted);
-        PhoneWidget->HandleComplianceUpdated(Session.Compliance);
-        PhoneWidget->HandleShardStatus(Session.CurrentShard);
-        PhoneWidget->HandleWalletUpdated(WalletView);
-        PhoneWidget->HandleMissionsUpdated(ActiveMissions);
+        PhoneSubscription = SessionStore.Subscribe(
+            ERiftlineSessionField::All,
+            FRiftlineSessionChangeDelegate::CreateUObject(Widget, &URiftlinePhoneWidget::HandleSessionChanges));
+        Widget->HandleSessionChanges(SessionStore, ERiftlineSessionField::All);
     }
 }
 
@@ -202,126 +433,328 @@ void URiftlineGameInstance::StartHeartbeat()
     {
         return;
     }
-    const float Interval = 15.f;
-    GetWorld()->GetTimerManager().SetTimer(HeartbeatTimerHandle, this, &URiftlineGameInstance::HeartbeatTick, Interval, true, Interval);
+
+    // The performance window stays fixed so governor decisions and frame-time telemetry keep a constant cadence.
+    const float SampleInterval = 15.f;
+    GetWorld()->GetTimerManager().SetTimer(PerformanceWindowTimerHandle, this, &URiftlineGameInstance::SamplePerformanceWindow, SampleInterval, true, SampleInterval);
+
+    BackgroundHandle = FCoreDelegates::ApplicationWillEnterBackgroundDelegate.AddUObject(this, &URiftlineGameInstance::HandleEnterBackground);
+    ForegroundHandle = FCoreDelegates::ApplicationHasEnteredForegroundDelegate.AddUObject(this, &URiftlineGameInstance::HandleEnterForeground);
+
+    // A random first beat spreads a fleet that launched together, e.g. after a server restart, across a whole interval.
+    bHeartbeatActive = true;
+    ServerHeartbeatInterval = 0.f;
+    HeartbeatFailures = 0;
+    ScheduleHeartbeat(FMath::FRandRange(0.f, HeartbeatInterval));
 }
 
 void URiftlineGameInstance::StopHeartbeat()
 {
+    bHeartbeatActive = false;
+    FCoreDelegates::ApplicationWillEnterBackgroundDelegate.Remove(BackgroundHandle);
+    FCoreDelegates::ApplicationHasEnteredForegroundDelegate.Remove(ForegroundHandle);
+    BackgroundHandle.Reset();
+    ForegroundHandle.Reset();
+
     if (GetWorld())
     {
         GetWorld()->GetTimerManager().ClearTimer(HeartbeatTimerHandle);
+        GetWorld()->GetTimerManager().ClearTimer(PerformanceWindowTimerHandle);
     }
 }
 
 void URiftlineGameInstance::HeartbeatTick()
 {
-    if (Session.PlayerId.IsEmpty())
+    RIFTLINE_SCOPE(HeartbeatTick);
+    LLM_SCOPE_BYTAG(Riftline_Network);
+
+    // Rescheduled up front as a fallback; a response replaces it with the interval and backoff it implies.
+    ScheduleHeartbeat(NextHeartbeatDelay());
+
+    if (GetSessionProfile().PlayerId.IsEmpty() || !TelemetryPipeline)
     {
         return;
     }
 
-    const FString Url = ComposeEndpoint(ApiBaseUrl, TEXT("/players/heartbeat"));
-    if (!Url.IsEmpty())
+    // At most one heartbeat is outstanding, unless the last one has been lost for longer than any interval could be.
+    const double Now = FPlatformTime::Seconds();
+    if (bHeartbeatInFlight && Now - HeartbeatSentAt < HeartbeatMaxInterval)
     {
-        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-        Request->SetURL(Url);
-        Request->SetVerb(TEXT("POST"));
-        Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-        Request->SetContentAsString(FString::Printf(TEXT("{\"playerId\":\"%s\",\"shardId\":%d}"), *Session.PlayerId, Session.CurrentShard.ShardId));
-        Request->ProcessRequest();
+        return;
     }
 
-    EmitClientPerformanceTelemetry();
-    EmitThermalTelemetry();
+    // The telemetry worker sends it, so journalled events ride along instead of paying for a request of their own.
+    const bool bQueued = TelemetryPipeline->RequestHeartbeat(GetSessionProfile().CurrentShard.ShardId,
+        FRiftlineHttpCompleteDelegate::CreateWeakLambda(this, [this](const FRiftlineHttpResult& Result)
+    {
+        HandleHeartbeatResponse(Result);
+    }));
+    if (bQueued)
+    {
+        bHeartbeatInFlight = true;
+        HeartbeatSentAt = Now;
+    }
 }
 
-void URiftlineGameInstance::SubmitWantedTelemetry(const FRiftlineWantedState& WantedState)
+void URiftlineGameInstance::ScheduleHeartbeat(float Delay)
 {
-    if (Session.PlayerId.IsEmpty())
+    if (bHeartbeatActive && GetWorld())
     {
-        return;
+        GetWorld()->GetTimerManager().SetTimer(HeartbeatTimerHandle, this, &URiftlineGameInstance::HeartbeatTick, FMath::Max(Delay, 0.1f), false);
+    }
+}
+
+float URiftlineGameInstance::NextHeartbeatDelay() const
+{
+    float Interval = ServerHeartbeatInterval > 0.f ? ServerHeartbeatInterval : HeartbeatInterval;
+    if (bInBackground)
+    {
+        Interval *= HeartbeatBackgroundMultiplier;
+    }
+    else if (FSlateApplication::IsInitialized() && FPlatformTime::Seconds() - FSlateApplication::Get().GetLastUserInteractionTime() > HeartbeatIdleSeconds)
+    {
+        Interval *= HeartbeatIdleMultiplier;
     }
 
-    TMap<FString, FString> Properties;
-    Properties.Add(TEXT("level"), StaticEnum<ERiftlineWantedLevel>()->GetNameStringByValue(static_cast<int64>(WantedState.Level)));
-    Properties.Add(TEXT("expires"), WantedState.ExpiresAt.ToIso8601());
-    Properties.Add(TEXT("heat"), FString::SanitizeFloat(WantedState.Heat));
-    PushTelemetryEvent(TEXT("wanted_state"), Properties);
+    if (HeartbeatFailures > 0)
+    {
+        return RiftlineHttp::ComputeBackoff(HeartbeatFailures, Interval, HeartbeatMaxInterval, FMath::FRand());
+    }
+    return FMath::Min(Interval * FMath::FRandRange(1.f - HeartbeatJitter, 1.f + HeartbeatJitter), HeartbeatMaxInterval);
 }
 
-void URiftlineGameInstance::EmitClientPerformanceTelemetry()
+void URiftlineGameInstance::HandleHeartbeatResponse(const FRiftlineHttpResult& Result)
 {
-    if (!GEngine)
+    bHeartbeatInFlight = false;
+
+    if (Result.IsOk())
     {
-        return;
+        HeartbeatFailures = 0;
+
+        TSharedPtr<FJsonObject> Body;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Result.GetContentAsString());
+        double NextSeconds = 0.0;
+        if (FJsonSerializer::Deserialize(Reader, Body) && Body.IsValid() && Body->TryGetNumberField(TEXT("nextHeartbeatSec"), NextSeconds) && NextSeconds > 0.0)
+        {
+            ServerHeartbeatInterval = FMath::Clamp(static_cast<float>(NextSeconds), 5.f, HeartbeatMaxInterval);
+        }
+    }
+    else
+    {
+        ++HeartbeatFailures;
     }
 
-    const float CurrentFps = GEngine->GetAverageFPS();
-    if (CurrentFps <= 0.f || !FMath::IsFinite(CurrentFps))
+    ScheduleHeartbeat(NextHeartbeatDelay());
+}
+
+void URiftlineGameInstance::HandleEnterBackground()
+{
+    bInBackground = true;
+    ScheduleHeartbeat(NextHeartbeatDelay());
+}
+
+void URiftlineGameInstance::HandleEnterForeground()
+{
+    bInBackground = false;
+    ScheduleHeartbeat(FMath::FRandRange(0.f, HeartbeatInterval * HeartbeatJitter));
+}
+
+void URiftlineGameInstance::EmitHttpTelemetry()
+{
+    if (!HttpScheduler)
     {
         return;
     }
 
-    FpsSamples.Add(CurrentFps);
-    const int32 MaxSamples = 120;
-    if (FpsSamples.Num() > MaxSamples)
+    FRiftlineHttpSummary Summary;
+    HttpScheduler->ConsumeWindow(Summary);
+    for (int32 Index = 0; Index < static_cast<int32>(ERiftlineHttpPriority::Count); ++Index)
     {
-        const int32 Excess = FpsSamples.Num() - MaxSamples;
-        FpsSamples.RemoveAt(0, Excess);
+        const FRiftlineHttpPriorityStats& Stats = Summary.Priorities[Index];
+        if (Stats.Requests == 0)
+        {
+            continue;
+        }
+
+        const FRiftlineHistogram& Times = Stats.TotalTimes;
+        FRiftlineTelemetryEvent Event(RiftlineTelemetry::Events::ClientHttp);
+        Event.Add(RiftlineTelemetry::Keys::Priority, FName(RiftlineHttp::LexPriority(static_cast<ERiftlineHttpPriority>(Index))))
+            .Add(RiftlineTelemetry::Keys::Count, Stats.Requests)
+            .Add(RiftlineTelemetry::Keys::Retries, Stats.Retries)
+            .Add(RiftlineTelemetry::Keys::Failures, Stats.Failures)
+            .Add(RiftlineTelemetry::Keys::Coalesced, Stats.Coalesced)
+            .Add(RiftlineTelemetry::Keys::Avg, static_cast<float>(Times.GetMean() / 1000.0))
+            .Add(RiftlineTelemetry::Keys::P50, Times.ValueAtQuantile(0.50) / 1000.f)
+            .Add(RiftlineTelemetry::Keys::P90, Times.ValueAtQuantile(0.90) / 1000.f)
+            .Add(RiftlineTelemetry::Keys::P99, Times.ValueAtQuantile(0.99) / 1000.f)
+            .Add(RiftlineTelemetry::Keys::Max, Times.GetMax() / 1000.f);
+        PushTelemetry(Event);
     }
+}
 
-    float Sum = 0.f;
-    for (float Sample : FpsSamples)
+void URiftlineGameInstance::HandleHttpAttempt(const FString& Host, const FRiftlineHttpResult& Result)
+{
+    NetworkQuality.RecordAttempt(Host, Result);
+    if (NetworkQuality.HasClockSync())
     {
-        Sum += Sample;
+        RiftlineNetwork::SetServerClockOffset(NetworkQuality.GetClockOffset());
     }
+}
 
-    const float Average = Sum / FpsSamples.Num();
+void URiftlineGameInstance::EmitNetworkTelemetry()
+{
+    using namespace RiftlineTelemetry;
 
-    TArray<float> SortedSamples = FpsSamples;
-    SortedSamples.Sort();
+    // One event per host; the record's shard id gives the regional latency picture.
+    TMap<FString, FRiftlineNetworkHostWindow> Windows;
+    NetworkQuality.ConsumeWindow(Windows);
+    const FRiftlineNetworkQualitySnapshot Snapshot = NetworkQuality.GetSnapshot();
+    for (const TPair<FString, FRiftlineNetworkHostWindow>& Pair : Windows)
+    {
+        const FRiftlineHistogram& RoundTrips = Pair.Value.RoundTrips;
+        FRiftlineTelemetryEvent Event(Events::ClientNet);
+        Event.Add(Keys::Host, FName(*Pair.Key))
+            .Add(Keys::Count, Pair.Value.Requests)
+            .Add(Keys::Failures, Pair.Value.Failures)
+            .Add(Keys::P50, RoundTrips.ValueAtQuantile(0.50) / 1000.f)
+            .Add(Keys::P95, RoundTrips.ValueAtQuantile(0.95) / 1000.f)
+            .Add(Keys::Max, RoundTrips.GetMax() / 1000.f);
+        if (Snapshot.bClockSynced)
+        {
+            Event.Add(Keys::Offset, Snapshot.ClockOffsetMs)
+                .Add(Keys::OffsetError, Snapshot.ClockErrorMs);
+        }
+        PushTelemetry(Event);
+    }
+}
 
-    float Percentile95 = SortedSamples.Last();
-    if (SortedSamples.Num() > 1)
+void URiftlineGameInstance::SubmitWantedTelemetry(const FRiftlineWantedState& WantedState)
+{
+    if (GetSessionProfile().PlayerId.IsEmpty())
     {
-        const float Position = 0.95f * (SortedSamples.Num() - 1);
-        const int32 LowerIndex = FMath::FloorToInt(Position);
-        const int32 UpperIndex = FMath::CeilToInt(Position);
+        return;
+    }
+
+    FRiftlineTelemetryEvent Event(RiftlineTelemetry::Events::WantedState);
+    Event.Add(RiftlineTelemetry::Keys::Level, WantedState.Level)
+        .AddString(RiftlineTelemetry::Keys::Expires, WantedState.ExpiresAt.ToIso8601())
+        .AddString(RiftlineTelemetry::Keys::Heat, FString::SanitizeFloat(WantedState.Heat));
+    PushTelemetry(Event);
+}
+
+void URiftlineGameInstance::SamplePerformanceWindow()
+{
+    RIFTLINE_SCOPE(SamplePerformanceWindow);
+
+    // The governor keeps running before login; telemetry from this window is dropped by PushTelemetry.
+    EmitHttpTelemetry();
+    EmitNetworkTelemetry();
+
+    if (DeviceStateProvider)
+    {
+        DeviceState = DeviceStateProvider->Sample();
+        EmitThermalTelemetry();
+    }
+
+    FRiftlineFrameTimeSummary Summary;
+    if (!PerformanceMonitor || !PerformanceMonitor->ConsumeWindow(Summary))
+    {
+        return;
+    }
 
-        if (LowerIndex >= 0 && UpperIndex < SortedSamples.Num())
+    if (Governor)
+    {
+        const ERiftlineGovernorReason Reason = Governor->Evaluate(DeviceState, Summary);
+        if (Reason != ERiftlineGovernorReason::None)
         {
-            if (LowerIndex == UpperIndex)
-            {
-                Percentile95 = SortedSamples[LowerIndex];
-            }
-            else
-            {
-                const float Fraction = Position - LowerIndex;
-                Percentile95 = FMath::Lerp(SortedSamples[LowerIndex], SortedSamples[UpperIndex], Fraction);
-            }
+            EmitGovernorTelemetry(Reason);
+        }
+    }
+
+    const FRiftlineFrameTimeStats& FrameStats = Summary[ERiftlineFrameTimer::Frame];
+    FRiftlineTelemetryEvent Event(RiftlineTelemetry::Events::ClientFrameTime);
+    Event.Add(RiftlineTelemetry::Keys::Frames, Summary.Frames)
+        .Add(RiftlineTelemetry::Keys::Hitches, Summary.Hitches)
+        .Add(RiftlineTelemetry::Keys::Avg, FrameStats.AvgMs)
+        .Add(RiftlineTelemetry::Keys::P50, FrameStats.P50Ms)
+        .Add(RiftlineTelemetry::Keys::P90, FrameStats.P90Ms)
+        .Add(RiftlineTelemetry::Keys::P99, FrameStats.P99Ms)
+        .Add(RiftlineTelemetry::Keys::Max, FrameStats.MaxMs);
+    PushTelemetry(Event);
+
+    const FName ThreadNames[] = { RiftlineTelemetry::Keys::Game, RiftlineTelemetry::Keys::Render, RiftlineTelemetry::Keys::Rhi, RiftlineTelemetry::Keys::Gpu };
+    static const ERiftlineFrameTimer Timers[] = { ERiftlineFrameTimer::GameThread, ERiftlineFrameTimer::RenderThread, ERiftlineFrameTimer::RHIThread, ERiftlineFrameTimer::GPU };
+    for (int32 Index = 0; Index < UE_ARRAY_COUNT(Timers); ++Index)
+    {
+        const FRiftlineFrameTimeStats& Stats = Summary[Timers[Index]];
+        if (Stats.MaxMs <= 0.f)
+        {
+            continue;
         }
+
+        FRiftlineTelemetryEvent ThreadEvent(RiftlineTelemetry::Events::ClientThreadTime);
+        ThreadEvent.Add(RiftlineTelemetry::Keys::Thread, ThreadNames[Index])
+            .Add(RiftlineTelemetry::Keys::Avg, Stats.AvgMs)
+            .Add(RiftlineTelemetry::Keys::P50, Stats.P50Ms)
+            .Add(RiftlineTelemetry::Keys::P90, Stats.P90Ms)
+            .Add(RiftlineTelemetry::Keys::P99, Stats.P99Ms)
+            .Add(RiftlineTelemetry::Keys::Max, Stats.MaxMs);
+        PushTelemetry(ThreadEvent);
     }
+}
 
-    TMap<FString, FString> Properties;
-    Properties.Add(TEXT("avg"), FString::Printf(TEXT("%.2f"), Average));
-    Properties.Add(TEXT("pct95"), FString::Printf(TEXT("%.2f"), Percentile95));
-    PushTelemetryEvent(TEXT("client.fps"), Properties);
+void URiftlineGameInstance::HandleHitch(const FRiftlineHitchSample& Sample)
+{
+    using namespace RiftlineTelemetry;
+
+    FRiftlineTelemetryEvent Event(Events::ClientHitch);
+    Event.Add(Keys::Frame, Sample[ERiftlineFrameTimer::Frame])
+        .Add(Keys::Game, Sample[ERiftlineFrameTimer::GameThread])
+        .Add(Keys::Render, Sample[ERiftlineFrameTimer::RenderThread])
+        .Add(Keys::Rhi, Sample[ERiftlineFrameTimer::RHIThread])
+        .Add(Keys::Gpu, Sample[ERiftlineFrameTimer::GPU]);
+
+    const bool bPhoneVisible = PhoneWidget.IsValid() && PhoneWidget->IsVisible();
+    Event.Add(Keys::Phone, bPhoneVisible);
+    if (PhoneWidget.IsValid())
+    {
+        Event.Add(Keys::Tab, PhoneWidget->GetActiveTab());
+    }
+    Event.Add(Keys::Shard, GetSessionProfile().CurrentShard.ShardId)
+        .Add(Keys::Wanted, GetSessionProfile().Wanted.Level)
+        .Add(Keys::Interaction, DescribeInteractionState());
+    PushTelemetry(Event);
 }
 
 void URiftlineGameInstance::EmitThermalTelemetry()
 {
-    TMap<FString, FString> Properties;
-    Properties.Add(TEXT("state"), DescribeThermalState());
-    Properties.Add(TEXT("platform"), FString(FPlatformProperties::IniPlatformName()));
-    PushTelemetryEvent(TEXT("client.thermal"), Properties);
+    FRiftlineTelemetryEvent Event(RiftlineTelemetry::Events::ClientThermal);
+    Event.Add(RiftlineTelemetry::Keys::State, DeviceState.Thermal)
+        .Add(RiftlineTelemetry::Keys::Platform, DeviceStateProvider->GetSourceName())
+        .Add(RiftlineTelemetry::Keys::OnBattery, DeviceState.bOnBattery);
+    if (DeviceState.BatteryLevel >= 0.f)
+    {
+        Event.Add(RiftlineTelemetry::Keys::Battery, DeviceState.BatteryLevel);
+    }
+    PushTelemetry(Event);
 }
 
-FString URiftlineGameInstance::DescribeThermalState() const
+void URiftlineGameInstance::EmitGovernorTelemetry(ERiftlineGovernorReason Reason)
 {
-#if PLATFORM_ANDROID
-    return TEXT("android:unknown");
-#else
-    return TEXT("unknown");
-#endif
+    using namespace RiftlineTelemetry;
+
+    const FName ReasonNames[] = { Values::None, Values::Thermal, Values::FrameTime, Values::Headroom };
+    FRiftlineTelemetryEvent Event(Events::ClientGovernor);
+    Event.Add(Keys::Step, Governor->GetCurrentStep())
+        .Add(Keys::Reason, ReasonNames[static_cast<int32>(Reason)])
+        .Add(Keys::State, DeviceState.Thermal);
+    PushTelemetry(Event);
+}
+
+FName URiftlineGameInstance::DescribeInteractionState() const
+{
+    const APlayerController* Controller = GetFirstLocalPlayerController();
+    const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+    const URiftlineInteractionComponent* Interaction = Pawn ? Pawn->FindComponentByClass<URiftlineInteractionComponent>() : nullptr;
+    return Interaction && Interaction->HasInteractionTarget() ? RiftlineTelemetry::Values::Targeting : RiftlineTelemetry::Values::Idle;
 }
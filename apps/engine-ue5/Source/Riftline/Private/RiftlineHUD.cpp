@@ -2,13 +2,17 @@
 
 #include "Blueprint/UserWidget.h"
 #include "GameFramework/PlayerController.h"
+#include "Riftline.h"
 #include "RiftlineGameInstance.h"
 #include "RiftlineHUDWidget.h"
 #include "RiftlineInteractionComponent.h"
 #include "RiftlineRadialMenuWidget.h"
+#include "RiftlineTelemetry.h"
 
 void ARiftlineHUD::BeginPlay()
 {
+    LLM_SCOPE_BYTAG(Riftline_UI);
+
     Super::BeginPlay();
 
     if (!HUDWidgetClass)
@@ -47,6 +51,8 @@ void ARiftlineHUD::BeginPlay()
 
 void ARiftlineHUD::HandleWanted(const FRiftlineWantedState& State)
 {
+    RIFTLINE_SCOPE(HUDHandleWanted);
+
     if (HUDWidget)
     {
         HUDWidget->SetHeat(State.Heat);
@@ -58,6 +64,8 @@ void ARiftlineHUD::HandleWanted(const FRiftlineWantedState& State)
 
 void ARiftlineHUD::HandleCompliance(const FRiftlineComplianceState& State)
 {
+    RIFTLINE_SCOPE(HUDHandleCompliance);
+
     if (HUDWidget)
     {
         HUDWidget->SetComplianceState(State);
@@ -92,14 +100,19 @@ void ARiftlineHUD::HandlePawnChanged(APawn* NewPawn)
 
 void ARiftlineHUD::HandleInteractionOptions(const FRiftlineInteractionHit& Hit)
 {
+    RIFTLINE_SCOPE(HUDHandleInteractionOptions);
+    LLM_SCOPE_BYTAG(Riftline_UI);
+
     if (HUDWidget)
     {
-        HUDWidget->SetRadialEntries(Hit.Options);
+        HUDWidget->SetRadialOptions(Hit.SharedOptions);
     }
 }
 
 void ARiftlineHUD::HandleRadialEntrySelected(FName EntryId)
 {
+    RIFTLINE_SCOPE(HUDHandleRadialEntrySelected);
+
     if (InteractionComponent.IsValid())
     {
         InteractionComponent->InvokeInteraction(EntryId);
@@ -107,9 +120,9 @@ void ARiftlineHUD::HandleRadialEntrySelected(FName EntryId)
 
     if (URiftlineGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance<URiftlineGameInstance>() : nullptr)
     {
-        TMap<FString, FString> Properties;
-        Properties.Add(TEXT("option"), EntryId.ToString());
-        GI->PushTelemetryEvent(TEXT("ui.radial.select"), Properties);
+        FRiftlineTelemetryEvent Event(RiftlineTelemetry::Events::RadialSelect);
+        Event.Add(RiftlineTelemetry::Keys::Option, EntryId);
+        GI->PushTelemetry(Event);
     }
 
     if (HUDWidget)
@@ -5,17 +5,55 @@
 #include "Components/ProgressBar.h"
 #include "Components/TextBlock.h"
 #include "Components/Widget.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/App.h"
 #include "RiftlineInteractionComponent.h"
 #include "RiftlineRadialMenuWidget.h"
 
+namespace
+{
+    /** Smallest heat change the bar shows; anything finer is not worth a repaint. */
+    constexpr float HeatBarResolution = 0.002f;
+
+    /** Wanted meter material parameters; see URiftlineHUDWidget::WantedMeter. */
+    const FName MeterStars(TEXT("Stars"));
+    const FName MeterStarsFrom(TEXT("StarsFrom"));
+    const FName MeterStarsChangedAt(TEXT("StarsChangedAt"));
+    const FName MeterHeat(TEXT("Heat"));
+    const FName MeterHeatFrom(TEXT("HeatFrom"));
+    const FName MeterHeatChangedAt(TEXT("HeatChangedAt"));
+    const FName MeterPulse(TEXT("Pulse"));
+
+    /** The clock behind the Time node in UI materials. */
+    float GetUIMaterialTime()
+    {
+        return static_cast<float>(FApp::GetCurrentTime() - GStartTime);
+    }
+}
+
 URiftlineHUDWidget::URiftlineHUDWidget(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
 {
 }
 
+void URiftlineHUDWidget::NativeOnInitialized()
+{
+    Super::NativeOnInitialized();
+
+    if (WantedMeter)
+    {
+        WantedMeterMaterial = WantedMeter->GetDynamicMaterial();
+    }
+}
+
 void URiftlineHUDWidget::SetWantedLevel(int32 Stars)
 {
     const int32 Clamped = FMath::Max(Stars, 0);
+    if (Clamped == ShownStars)
+    {
+        return;
+    }
+
     VisibleWantedLevel = Clamped;
     WantedState.Level = static_cast<ERiftlineWantedLevel>(FMath::Clamp(Clamped, 0, static_cast<int32>(ERiftlineWantedLevel::Critical)));
     UpdateWantedVisuals(Clamped);
@@ -26,32 +64,52 @@ void URiftlineHUDWidget::SetHeat(float Value)
 {
     const float Clamped = FMath::Clamp(Value, 0.f, 1.f);
     WantedState.Heat = Clamped;
+
+    // Sub-resolution changes are dropped, except reaching empty or full, which must always show exactly.
+    const bool bEndpoint = Clamped == 0.f || Clamped == 1.f;
+    if (Clamped == ShownHeat || (ShownHeat >= 0.f && !bEndpoint && FMath::Abs(Clamped - ShownHeat) < HeatBarResolution))
+    {
+        return;
+    }
+
+    UpdateMeter(MeterHeat, MeterHeatFrom, MeterHeatChangedAt, Clamped, ShownHeat >= 0.f ? ShownHeat : Clamped);
+    ShownHeat = Clamped;
     if (HeatBar)
     {
         HeatBar->SetPercent(Clamped);
     }
-    if (HeatValueText)
+
+    // The label shows whole percents, so most heat ticks leave it alone.
+    const int32 Percent = FMath::RoundToInt(Clamped * 100.f);
+    if (HeatValueText && Percent != ShownHeatPercent)
     {
-        HeatValueText->SetText(FText::AsPercent(Clamped));
+        ShownHeatPercent = Percent;
+        HeatValueText->SetText(FText::AsPercent(Percent / 100.f));
     }
     HandleHeatChanged(Clamped);
 }
 
 void URiftlineHUDWidget::SetComplianceState(const FRiftlineComplianceState& State)
 {
+    if (bComplianceShown && State == ComplianceState)
+    {
+        return;
+    }
+
     ComplianceState = State;
+    bComplianceShown = true;
 
     if (ComplianceText)
     {
-        FString Summary;
-        Summary += State.bKycVerified ? TEXT("KYC Verified") : TEXT("KYC Pending");
-        Summary += State.bAmlClear ? TEXT(" • AML Clear") : TEXT(" • AML Review");
-        Summary += FString::Printf(TEXT(" • Risk %d"), State.RiskScore);
+        TStringBuilder<128> Summary;
+        Summary << (State.bKycVerified ? TEXT("KYC Verified") : TEXT("KYC Pending"));
+        Summary << (State.bAmlClear ? TEXT(" • AML Clear") : TEXT(" • AML Review"));
+        Summary << TEXT(" • Risk ") << State.RiskScore;
         if (!State.LastCaseId.IsEmpty())
         {
-            Summary += FString::Printf(TEXT(" • Case %s"), *State.LastCaseId);
+            Summary << TEXT(" • Case ") << State.LastCaseId;
         }
-        ComplianceText->SetText(FText::FromString(Summary));
+        ComplianceText->SetText(FText::FromString(FString(Summary.ToView())));
     }
 
     HandleComplianceChanged(ComplianceState);
@@ -59,23 +117,17 @@ void URiftlineHUDWidget::SetComplianceState(const FRiftlineComplianceState& Stat
 
 void URiftlineHUDWidget::SetRadialEntries(const TArray<FRiftlineInteractionOption>& Entries)
 {
+    SetRadialOptions(Entries.Num() > 0 ? FRiftlineInteractionOptionsPtr(MakeShared<TArray<FRiftlineInteractionOption>>(Entries)) : nullptr);
+}
+
+void URiftlineHUDWidget::SetRadialOptions(const FRiftlineInteractionOptionsPtr& Options)
+{
+    const bool bHasOptions = Options.IsValid() && Options->Num() > 0;
     if (RadialMenu)
     {
-        if (Entries.Num() > 0)
-        {
-            RadialMenu->SetEntries(Entries);
-            UpdateRadialVisibility(true);
-        }
-        else
-        {
-            RadialMenu->ClearEntries();
-            UpdateRadialVisibility(false);
-        }
-    }
-    else
-    {
-        UpdateRadialVisibility(Entries.Num() > 0);
+        RadialMenu->SetSharedEntries(bHasOptions ? Options : nullptr);
     }
+    UpdateRadialVisibility(bHasOptions);
 }
 
 void URiftlineHUDWidget::ClearRadialEntries()
@@ -87,15 +139,27 @@ void URiftlineHUDWidget::ClearRadialEntries()
     UpdateRadialVisibility(false);
 }
 
-void URiftlineHUDWidget::UpdateWantedVisuals(int32 Stars) const
+void URiftlineHUDWidget::UpdateWantedVisuals(int32 Stars)
 {
+    const int32 Previous = ShownStars;
+    ShownStars = Stars;
+
+    UpdateMeter(MeterStars, MeterStarsFrom, MeterStarsChangedAt, Stars, Previous == INDEX_NONE ? Stars : Previous);
+    if (WantedMeterMaterial)
+    {
+        WantedMeterMaterial->SetScalarParameterValue(MeterPulse, WantedState.Level >= ERiftlineWantedLevel::High ? 1.f : 0.f);
+    }
+
     if (!WantedStars)
     {
         return;
     }
 
+    // Only the stars between the old and the new level change; the first update sets them all.
     const int32 ChildCount = WantedStars->GetChildrenCount();
-    for (int32 Index = 0; Index < ChildCount; ++Index)
+    const int32 First = Previous == INDEX_NONE ? 0 : FMath::Min(Previous, Stars);
+    const int32 Last = Previous == INDEX_NONE ? ChildCount : FMath::Min(FMath::Max(Previous, Stars), ChildCount);
+    for (int32 Index = First; Index < Last; ++Index)
     {
         if (UWidget* Child = WantedStars->GetChildAt(Index))
         {
@@ -104,8 +168,26 @@ void URiftlineHUDWidget::UpdateWantedVisuals(int32 Stars) const
     }
 }
 
-void URiftlineHUDWidget::UpdateRadialVisibility(bool bVisible) const
+void URiftlineHUDWidget::UpdateMeter(FName Value, FName From, FName ChangedAt, float NewValue, float OldValue) const
+{
+    if (!WantedMeterMaterial)
+    {
+        return;
+    }
+
+    WantedMeterMaterial->SetScalarParameterValue(From, OldValue);
+    WantedMeterMaterial->SetScalarParameterValue(Value, NewValue);
+    WantedMeterMaterial->SetScalarParameterValue(ChangedAt, GetUIMaterialTime());
+}
+
+void URiftlineHUDWidget::UpdateRadialVisibility(bool bVisible)
 {
+    if (bRadialShown == bVisible)
+    {
+        return;
+    }
+
+    bRadialShown = bVisible;
     if (RadialContainer)
     {
         RadialContainer->SetVisibility(bVisible ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
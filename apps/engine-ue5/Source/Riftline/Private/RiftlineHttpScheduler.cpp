@@ -0,0 +1,473 @@
+#include "RiftlineHttpScheduler.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Riftline.h"
+#include "RiftlineNetworkQuality.h"
+
+struct FRiftlineHttpScheduler::FEntry
+{
+    FRiftlineHttpRequest Request;
+    TArray<FRiftlineHttpCompleteDelegate> Callbacks;
+    FString Host;
+    FString CoalesceKey;
+    FRiftlineHttpResult Result;
+    TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest;
+    double SubmittedAt = 0.0;
+    double AttemptStartedAt = 0.0;
+    bool bInFlight = false;
+};
+
+namespace
+{
+    bool IsForeground(ERiftlineHttpPriority Priority)
+    {
+        return Priority == ERiftlineHttpPriority::Interactive || Priority == ERiftlineHttpPriority::Gameplay;
+    }
+
+    /** GETs with the same URL and headers (so the same credentials) can share one response. */
+    FString MakeCoalesceKey(const FRiftlineHttpRequest& Request)
+    {
+        if (Request.Verb != TEXT("GET"))
+        {
+            return FString();
+        }
+
+        FString Key = Request.Url;
+        for (const TPair<FString, FString>& Header : Request.Headers)
+        {
+            Key.AppendChar(TEXT('\n'));
+            Key += Header.Key;
+            Key.AppendChar(TEXT(':'));
+            Key += Header.Value;
+        }
+        return Key;
+    }
+
+    uint32 ToMicroseconds(double Seconds)
+    {
+        return static_cast<uint32>(FMath::Clamp(Seconds * 1000000.0, 0.0, static_cast<double>(MAX_uint32)));
+    }
+}
+
+FRiftlineHttpRequest& FRiftlineHttpRequest::SetHeader(const FString& Name, const FString& Value)
+{
+    Headers.Emplace(Name, Value);
+    return *this;
+}
+
+FRiftlineHttpRequest& FRiftlineHttpRequest::SetContentAsString(const FString& Body)
+{
+    const FTCHARToUTF8 Utf8(*Body);
+    Content.Reset(Utf8.Length());
+    Content.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    return *this;
+}
+
+FString FRiftlineHttpResult::GetContentAsString() const
+{
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Content.GetData()), Content.Num());
+    return FString(Converted.Length(), Converted.Get());
+}
+
+FRiftlineHttpScheduler::FRiftlineHttpScheduler(const FRiftlineHttpSchedulerSettings& InSettings)
+    : Settings(InSettings)
+{
+    Settings.MaxConnectionsPerHost = FMath::Max(Settings.MaxConnectionsPerHost, 1);
+    Settings.MaxConnections = FMath::Max(Settings.MaxConnections, Settings.MaxConnectionsPerHost);
+    Settings.ForegroundReservedPerHost = FMath::Clamp(Settings.ForegroundReservedPerHost, 0, Settings.MaxConnectionsPerHost - 1);
+    Settings.MaxQueued = FMath::Max(Settings.MaxQueued, 1);
+}
+
+FRiftlineHttpScheduler::~FRiftlineHttpScheduler()
+{
+    Stop();
+}
+
+void FRiftlineHttpScheduler::Start()
+{
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FRiftlineHttpScheduler::Tick));
+    }
+}
+
+void FRiftlineHttpScheduler::Stop()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+    bStopped.store(true, std::memory_order_relaxed);
+
+    TArray<TSharedPtr<FEntry, ESPMode::ThreadSafe>> Failed;
+    TSharedPtr<FEntry, ESPMode::ThreadSafe> Submitted;
+    while (Submissions.Dequeue(Submitted))
+    {
+        Failed.Add(MoveTemp(Submitted));
+    }
+    for (TArray<TSharedPtr<FEntry, ESPMode::ThreadSafe>>& Queue : Queued)
+    {
+        Failed.Append(MoveTemp(Queue));
+        Queue.Reset();
+    }
+    NumQueued = 0;
+
+    for (const TSharedPtr<FEntry, ESPMode::ThreadSafe>& Entry : Failed)
+    {
+        Complete(Entry);
+    }
+
+    // Cancelled requests still complete through HandleResponse, which no longer retries once stopped.
+    TArray<TSharedPtr<FEntry, ESPMode::ThreadSafe>> Cancelling = InFlight;
+    for (const TSharedPtr<FEntry, ESPMode::ThreadSafe>& Entry : Cancelling)
+    {
+        if (Entry->HttpRequest.IsValid())
+        {
+            Entry->HttpRequest->CancelRequest();
+        }
+    }
+}
+
+void FRiftlineHttpScheduler::Submit(FRiftlineHttpRequest&& Request, FRiftlineHttpCompleteDelegate&& OnComplete)
+{
+    if (bStopped.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    TSharedPtr<FEntry, ESPMode::ThreadSafe> Entry = MakeShared<FEntry, ESPMode::ThreadSafe>();
+    Entry->Request = MoveTemp(Request);
+    Entry->Callbacks.Add(MoveTemp(OnComplete));
+    Entry->SubmittedAt = FPlatformTime::Seconds();
+    Submissions.Enqueue(MoveTemp(Entry));
+}
+
+bool FRiftlineHttpScheduler::Tick(float DeltaTime)
+{
+    Pump();
+    return true;
+}
+
+void FRiftlineHttpScheduler::Flush(double TimeoutSeconds)
+{
+    check(IsInGameThread());
+
+    const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+    double LastTick = FPlatformTime::Seconds();
+    for (;;)
+    {
+        Pump();
+
+        // Whatever is still queued is waiting out a host backoff and would not go out before the deadline anyway.
+        const double Now = FPlatformTime::Seconds();
+        if (NumInFlight == 0 || Now >= Deadline)
+        {
+            break;
+        }
+
+        FHttpModule::Get().GetHttpManager().Tick(static_cast<float>(Now - LastTick));
+        LastTick = Now;
+        FPlatformProcess::SleepNoStats(0.005f);
+    }
+}
+
+void FRiftlineHttpScheduler::Pump()
+{
+    RIFTLINE_SCOPE(HttpSchedulerPump);
+    LLM_SCOPE_BYTAG(Riftline_Network);
+
+    TSharedPtr<FEntry, ESPMode::ThreadSafe> Submitted;
+    while (Submissions.Dequeue(Submitted))
+    {
+        Accept(Submitted);
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    for (TArray<TSharedPtr<FEntry, ESPMode::ThreadSafe>>& Queue : Queued)
+    {
+        for (int32 Index = 0; Index < Queue.Num() && NumInFlight < Settings.MaxConnections;)
+        {
+            if (!CanDispatch(*Queue[Index], Now))
+            {
+                ++Index;
+                continue;
+            }
+
+            TSharedPtr<FEntry, ESPMode::ThreadSafe> Entry = Queue[Index];
+            Queue.RemoveAt(Index, 1, false);
+            --NumQueued;
+            Dispatch(Entry, Now);
+        }
+    }
+    RIFTLINE_COUNTER_SET(RiftlineHttpQueued, static_cast<uint32>(NumQueued));
+}
+
+void FRiftlineHttpScheduler::ConsumeWindow(FRiftlineHttpSummary& Out)
+{
+    Out = Window;
+    for (FRiftlineHttpPriorityStats& Stats : Window.Priorities)
+    {
+        Stats = FRiftlineHttpPriorityStats();
+    }
+}
+
+void FRiftlineHttpScheduler::Accept(const TSharedPtr<FEntry, ESPMode::ThreadSafe>& Entry)
+{
+    FRiftlineHttpRequest& Request = Entry->Request;
+    Request.MaxAttempts = FMath::Max(Request.MaxAttempts, 1);
+    Entry->Host = RiftlineHttp::GetHost(Request.Url);
+
+    Entry->CoalesceKey = MakeCoalesceKey(Request);
+    if (!Entry->CoalesceKey.IsEmpty())
+    {
+        if (const TSharedPtr<FEntry, ESPMode::ThreadSafe>* Existing = Coalescing.Find(Entry->CoalesceKey))
+        {
+            FEntry& Shared = **Existing;
+            Shared.Callbacks.Append(MoveTemp(Entry->Callbacks));
+            ++Window.Priorities[static_cast<int32>(Request.Priority)].Coalesced;
+
+            // A more urgent caller pulls a still-queued request forward.
+            if (!Shared.bInFlight && Request.Priority < Shared.Request.Priority)
+            {
+                Queued[static_cast<int32>(Shared.Request.Priority)].RemoveSingle(*Existing);
+                Shared.Request.Priority = Request.Priority;
+                Queued[static_cast<int32>(Request.Priority)].Add(*Existing);
+            }
+            return;
+        }
+    }
+
+    if (NumQueued >= Settings.MaxQueued)
+    {
+        UE_LOG(LogRiftline, Warning, TEXT("HTTP queue full; failing %s %s"), *Request.Verb, *Request.Url);
+        Entry->CoalesceKey.Reset();
+        Complete(Entry);
+        return;
+    }
+
+    if (!Entry->CoalesceKey.IsEmpty())
+    {
+        Coalescing.Add(Entry->CoalesceKey, Entry);
+    }
+    Queued[static_cast<int32>(Request.Priority)].Add(Entry);
+    ++NumQueued;
+}
+
+bool FRiftlineHttpScheduler::CanDispatch(const FEntry& Entry, double Now) const
+{
+    const FHostState* Host = Hosts.Find(Entry.Host);
+    if (!Host)
+    {
+        return true;
+    }
+
+    const int32 Cap = IsForeground(Entry.Request.Priority)
+        ? Settings.MaxConnectionsPerHost
+        : Settings.MaxConnectionsPerHost - Settings.ForegroundReservedPerHost;
+    return Now >= Host->BlockedUntil && Host->InFlight < Cap;
+}
+
+void FRiftlineHttpScheduler::Dispatch(const TSharedPtr<FEntry, ESPMode::ThreadSafe>& Entry, double Now)
+{
+    const FRiftlineHttpRequest& Spec = Entry->Request;
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    Request->SetURL(Spec.Url);
+    Request->SetVerb(Spec.Verb);
+    for (const TPair<FString, FString>& Header : Spec.Headers)
+    {
+        Request->SetHeader(Header.Key, Header.Value);
+    }
+    if (Spec.Content.Num() > 0)
+    {
+        Request->SetContent(Spec.Content);
+    }
+    if (Settings.RequestTimeout > 0.f)
+    {
+        Request->SetTimeout(Settings.RequestTimeout);
+    }
+
+    TWeakPtr<FRiftlineHttpScheduler, ESPMode::ThreadSafe> WeakThis = AsShared();
+    Request->OnProcessRequestComplete().BindLambda([WeakThis, Entry](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnected)
+    {
+        RIFTLINE_COUNTER_DEC(RiftlineHttpInFlight);
+        if (TSharedPtr<FRiftlineHttpScheduler, ESPMode::ThreadSafe> Scheduler = WeakThis.Pin())
+        {
+            Scheduler->HandleResponse(Entry, Response, bConnected && Response.IsValid());
+        }
+    });
+
+    ++Hosts.FindOrAdd(Entry->Host).InFlight;
+    ++NumInFlight;
+    ++Entry->Result.Attempts;
+    Entry->AttemptStartedAt = Now;
+    const FDateTime SentAt = FDateTime::UtcNow();
+    Entry->Result.SentAtMs = SentAt.ToUnixTimestamp() * 1000 + SentAt.GetMillisecond();
+    Entry->bInFlight = true;
+    Entry->HttpRequest = Request;
+    InFlight.Add(Entry);
+
+    RIFTLINE_COUNTER_INC(RiftlineHttpInFlight);
+    Request->ProcessRequest();
+}
+
+void FRiftlineHttpScheduler::HandleResponse(const TSharedPtr<FEntry, ESPMode::ThreadSafe>& Entry, const FHttpResponsePtr& Response, bool bConnected)
+{
+    const double Now = FPlatformTime::Seconds();
+    FHostState& Host = Hosts.FindOrAdd(Entry->Host);
+    --Host.InFlight;
+    --NumInFlight;
+    InFlight.RemoveSingleSwap(Entry, false);
+    Entry->HttpRequest.Reset();
+    Entry->bInFlight = false;
+
+    const int32 Code = bConnected ? Response->GetResponseCode() : 0;
+    FRiftlineHttpResult& Result = Entry->Result;
+    Result.bConnected = bConnected;
+    Result.Code = Code;
+    Result.Content = bConnected ? Response->GetContent() : TArray<uint8>();
+    Result.LatencyMs = static_cast<float>((Now - Entry->AttemptStartedAt) * 1000.0);
+    Result.ServerReceivedAtMs = 0;
+    Result.ServerDurationMs = -1.f;
+    if (bConnected)
+    {
+        int64 ServerTime = 0;
+        float ServerDuration = 0.f;
+        if (LexTryParseString(ServerTime, *Response->GetHeader(TEXT("X-Server-Time")))
+            && RiftlineNetwork::ParseServerTiming(Response->GetHeader(TEXT("Server-Timing")), ServerDuration))
+        {
+            Result.ServerReceivedAtMs = ServerTime;
+            Result.ServerDurationMs = ServerDuration;
+        }
+    }
+
+    // Cancellations at shutdown say nothing about the link.
+    if (!bStopped.load(std::memory_order_relaxed))
+    {
+        AttemptDelegate.Broadcast(Entry->Host, Result);
+    }
+
+    if (!RiftlineHttp::IsRetryable(bConnected, Code))
+    {
+        Host.ConsecutiveFailures = 0;
+        Complete(Entry);
+        return;
+    }
+
+    // Every retryable failure backs the host off, including final attempts, so callers that do not retry still
+    // slow everyone else's traffic to a struggling server.
+    float Delay = RiftlineHttp::ComputeBackoff(Host.ConsecutiveFailures++, Settings.BaseRetryDelay, Settings.MaxRetryDelay, FMath::FRand());
+    float RetryAfterSeconds = 0.f;
+    if ((Code == EHttpResponseCodes::TooManyRequests || Code == EHttpResponseCodes::ServiceUnavail)
+        && RiftlineHttp::ParseRetryAfter(Response->GetHeader(TEXT("Retry-After")), FDateTime::UtcNow(), RetryAfterSeconds))
+    {
+        Delay = FMath::Max(Delay, FMath::Min(RetryAfterSeconds, Settings.MaxRetryAfter));
+    }
+    Host.BlockedUntil = FMath::Max(Host.BlockedUntil, Now + Delay);
+    UE_LOG(LogRiftline, Verbose, TEXT("HTTP %d from %s; holding the host for %.2fs"), Code, *Entry->Host, Delay);
+
+    if (bStopped.load(std::memory_order_relaxed) || Result.Attempts >= Entry->Request.MaxAttempts)
+    {
+        Complete(Entry);
+        return;
+    }
+
+    ++Window.Priorities[static_cast<int32>(Entry->Request.Priority)].Retries;
+    Queued[static_cast<int32>(Entry->Request.Priority)].Insert(Entry, 0);
+    ++NumQueued;
+}
+
+void FRiftlineHttpScheduler::Complete(const TSharedPtr<FEntry, ESPMode::ThreadSafe>& Entry)
+{
+    FRiftlineHttpResult& Result = Entry->Result;
+    const double Elapsed = FPlatformTime::Seconds() - Entry->SubmittedAt;
+    Result.TotalMs = static_cast<float>(Elapsed * 1000.0);
+
+    FRiftlineHttpPriorityStats& Stats = Window.Priorities[static_cast<int32>(Entry->Request.Priority)];
+    ++Stats.Requests;
+    Stats.Failures += Result.IsOk() ? 0 : 1;
+    Stats.TotalTimes.Add(ToMicroseconds(Elapsed));
+
+    if (!Entry->CoalesceKey.IsEmpty())
+    {
+        Coalescing.Remove(Entry->CoalesceKey);
+    }
+
+    for (const FRiftlineHttpCompleteDelegate& Callback : Entry->Callbacks)
+    {
+        Callback.ExecuteIfBound(Result);
+    }
+}
+
+namespace RiftlineHttp
+{
+    float ComputeBackoff(int32 Attempt, float BaseSeconds, float MaxSeconds, float Random01)
+    {
+        const float Capped = FMath::Min(MaxSeconds, BaseSeconds * static_cast<float>(1 << FMath::Clamp(Attempt, 0, 16)));
+        return Capped * (0.5f + 0.5f * FMath::Clamp(Random01, 0.f, 1.f));
+    }
+
+    bool ParseRetryAfter(const FString& Value, const FDateTime& Now, float& OutSeconds)
+    {
+        const FString Trimmed = Value.TrimStartAndEnd();
+        if (Trimmed.IsEmpty())
+        {
+            return false;
+        }
+
+        if (Trimmed.IsNumeric())
+        {
+            OutSeconds = FMath::Max(FCString::Atof(*Trimmed), 0.f);
+            return true;
+        }
+
+        FDateTime Date;
+        if (FDateTime::ParseHttpDate(Trimmed, Date))
+        {
+            OutSeconds = static_cast<float>(FMath::Max((Date - Now).GetTotalSeconds(), 0.0));
+            return true;
+        }
+        return false;
+    }
+
+    bool IsRetryable(bool bConnected, int32 Code)
+    {
+        return !bConnected
+            || Code == EHttpResponseCodes::RequestTimeout
+            || Code == EHttpResponseCodes::TooManyRequests
+            || Code == EHttpResponseCodes::ServerError
+            || Code == EHttpResponseCodes::BadGateway
+            || Code == EHttpResponseCodes::ServiceUnavail
+            || Code == EHttpResponseCodes::GatewayTimeout;
+    }
+
+    FString GetHost(const FString& Url)
+    {
+        const int32 SchemeEnd = Url.Find(TEXT("://"));
+        const int32 Start = SchemeEnd == INDEX_NONE ? 0 : SchemeEnd + 3;
+        int32 End = Start;
+        while (End < Url.Len() && Url[End] != TEXT('/') && Url[End] != TEXT('?') && Url[End] != TEXT('#'))
+        {
+            ++End;
+        }
+        return Url.Mid(Start, End - Start).ToLower();
+    }
+
+    const TCHAR* LexPriority(ERiftlineHttpPriority Priority)
+    {
+        switch (Priority)
+        {
+        case ERiftlineHttpPriority::Interactive: return TEXT("interactive");
+        case ERiftlineHttpPriority::Gameplay: return TEXT("gameplay");
+        case ERiftlineHttpPriority::Heartbeat: return TEXT("heartbeat");
+        case ERiftlineHttpPriority::Telemetry: return TEXT("telemetry");
+        default: return TEXT("unknown");
+        }
+    }
+}
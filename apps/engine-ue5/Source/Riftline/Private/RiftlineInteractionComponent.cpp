@@ -1,8 +1,38 @@
 #include "RiftlineInteractionComponent.h"
 
-#include "GameFramework/Pawn.h"
-#include "Engine/World.h"
 #include "Engine/EngineTypes.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Riftline.h"
+#include "RiftlineInteractionSubsystem.h"
+
+namespace
+{
+    /** Bounds the option cache; it only ever needs the interactables around one player. */
+    constexpr int32 MaxCachedOptionSets = 64;
+
+    bool SameOptions(const FRiftlineInteractionOptionsPtr& A, const FRiftlineInteractionOptionsPtr& B)
+    {
+        if (A == B)
+        {
+            return true;
+        }
+        if (!A.IsValid() || !B.IsValid() || A->Num() != B->Num())
+        {
+            return false;
+        }
+        for (int32 Index = 0; Index < A->Num(); ++Index)
+        {
+            const FRiftlineInteractionOption& Left = (*A)[Index];
+            const FRiftlineInteractionOption& Right = (*B)[Index];
+            if (Left.Id != Right.Id || !Left.Label.IdenticalTo(Right.Label, ETextIdenticalModeFlags::LexicalCompareInvariants))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
 
 URiftlineInteractionComponent::URiftlineInteractionComponent()
 {
@@ -10,6 +40,53 @@ URiftlineInteractionComponent::URiftlineInteractionComponent()
     TraceDistance = 250.f;
     TraceChannel = ECC_Visibility;
     bAutoInvokeSingleOption = true;
+    // Touch aiming is coarse, so phones accept candidates further off the crosshair.
+    CandidateHalfAngle = PLATFORM_ANDROID || PLATFORM_IOS ? 45.f : 30.f;
+    CandidateAngleWeight = 0.6f;
+    MaxOcclusionChecks = 3;
+    bTraceUnregisteredInteractables = true;
+    bTrackFocus = false;
+    FocusUpdateHz = 10.f;
+    FocusSwitchMargin = 0.15f;
+    FocusLossGraceSeconds = 0.25f;
+}
+
+void URiftlineInteractionComponent::BeginPlay()
+{
+    Super::BeginPlay();
+    SetFocusTracking(bTrackFocus);
+}
+
+void URiftlineInteractionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (URiftlineInteractionSubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<URiftlineInteractionSubsystem>() : nullptr)
+    {
+        Registry->RemoveInteractor(this);
+    }
+    Super::EndPlay(EndPlayReason);
+}
+
+void URiftlineInteractionComponent::SetFocusTracking(bool bEnabled)
+{
+    bTrackFocus = bEnabled;
+    if (URiftlineInteractionSubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<URiftlineInteractionSubsystem>() : nullptr)
+    {
+        if (bEnabled)
+        {
+            Registry->AddInteractor(this);
+        }
+        else
+        {
+            Registry->RemoveInteractor(this);
+        }
+    }
+
+    if (!bEnabled)
+    {
+        // RemoveInteractor already forgot the pending trace; this covers a component without a registry.
+        bFocusQueryInFlight = false;
+        LoseFocus(true);
+    }
 }
 
 APawn* URiftlineInteractionComponent::ResolvePawnOwner() const
@@ -17,69 +94,192 @@ APawn* URiftlineInteractionComponent::ResolvePawnOwner() const
     return Cast<APawn>(GetOwner());
 }
 
-bool URiftlineInteractionComponent::GatherOptions(
+FRiftlineInteractionOptionsPtr URiftlineInteractionComponent::GatherOptions(
     AActor* TargetActor,
-    APawn* InstigatorPawn,
-    TArray<FRiftlineInteractionOption>& OutOptions
+    URiftlineInteractableComponent* Interactable,
+    APawn* InstigatorPawn
 ) const
 {
-    if (!TargetActor || !TargetActor->GetClass()->ImplementsInterface(URiftlineInteractable::StaticClass()))
+    RIFTLINE_SCOPE(InteractionGatherOptions);
+
+    if (!TargetActor)
     {
-        return false;
+        return nullptr;
+    }
+    if (!Interactable)
+    {
+        Interactable = TargetActor->FindComponentByClass<URiftlineInteractableComponent>();
+    }
+
+    const bool bCacheable = Interactable && (Interactable->bCacheOptions || Interactable->HasPublishedOptions());
+    if (bCacheable)
+    {
+        const FCachedOptions* Cached = OptionCache.Find(Interactable);
+        if (Cached && Cached->Version == Interactable->GetOptionsVersion())
+        {
+            return Cached->Options;
+        }
     }
 
-    TArray<FRiftlineInteractionOption> Options;
-    IRiftlineInteractable::Execute_GetInteractionOptions(TargetActor, Options, InstigatorPawn);
-    Options.RemoveAll([](const FRiftlineInteractionOption& Option) { return Option.Id.IsNone(); });
+    FRiftlineInteractionOptionsPtr Options;
+    if (Interactable && Interactable->HasPublishedOptions())
+    {
+        Options = Interactable->GetPublishedOptions();
+    }
+    else if (TargetActor->GetClass()->ImplementsInterface(URiftlineInteractable::StaticClass()))
+    {
+        TArray<FRiftlineInteractionOption> Gathered;
+        IRiftlineInteractable::Execute_GetInteractionOptions(TargetActor, Gathered, InstigatorPawn);
+        Gathered.RemoveAll([](const FRiftlineInteractionOption& Option) { return Option.Id.IsNone(); });
+        if (Gathered.Num() > 0)
+        {
+            Options = MakeShared<TArray<FRiftlineInteractionOption>>(MoveTemp(Gathered));
+        }
+    }
 
-    if (Options.Num() == 0)
+    if (bCacheable)
     {
-        return false;
+        if (OptionCache.Num() >= MaxCachedOptionSets)
+        {
+            OptionCache.Reset();
+        }
+        FCachedOptions& Cached = OptionCache.FindOrAdd(Interactable);
+        Cached.Version = Interactable->GetOptionsVersion();
+        Cached.Options = Options;
     }
+    return Options;
+}
 
-    OutOptions = MoveTemp(Options);
+bool URiftlineInteractionComponent::FindInteraction(FRiftlineInteractionHit& OutHit) const
+{
+    if (!FindSharedInteraction(OutHit))
+    {
+        return false;
+    }
+    OutHit.Options = *OutHit.SharedOptions;
     return true;
 }
 
-bool URiftlineInteractionComponent::FindInteraction(FRiftlineInteractionHit& OutHit) const
+bool URiftlineInteractionComponent::FindSharedInteraction(FRiftlineInteractionHit& OutHit) const
 {
+    RIFTLINE_SCOPE(FindInteraction);
+
     APawn* PawnOwner = ResolvePawnOwner();
-    if (!PawnOwner)
+    if (!PawnOwner || !GetWorld())
     {
         return false;
     }
 
+    // A tracking component already has the batch's confirmed answer, so only untracked callers pay for a sweep.
+    if (bTrackFocus && GetWorld()->GetSubsystem<URiftlineInteractionSubsystem>())
+    {
+        if (!FocusActor.IsValid() || !FocusOptions.IsValid())
+        {
+            return false;
+        }
+        OutHit.Actor = FocusActor.Get();
+        OutHit.ImpactPoint = FocusPoint;
+        OutHit.SharedOptions = FocusOptions;
+        return true;
+    }
+
     FVector ViewLocation;
     FRotator ViewRotation;
     PawnOwner->GetActorEyesViewPoint(ViewLocation, ViewRotation);
+    const FVector ViewDirection = ViewRotation.Vector();
+
+    bool bFound = FindRegisteredInteraction(PawnOwner, ViewLocation, ViewDirection, OutHit);
+    if (!bFound && bTraceUnregisteredInteractables)
+    {
+        bFound = TraceInteraction(PawnOwner, ViewLocation, ViewDirection, OutHit);
+    }
+    if (!bFound)
+    {
+        return false;
+    }
+
+    LastActor = OutHit.Actor;
+    LastOptions = OutHit.SharedOptions;
+    return true;
+}
+
+bool URiftlineInteractionComponent::FindRegisteredInteraction(
+    APawn* PawnOwner,
+    const FVector& ViewLocation,
+    const FVector& ViewDirection,
+    FRiftlineInteractionHit& OutHit
+) const
+{
+    const URiftlineInteractionSubsystem* Registry = GetWorld()->GetSubsystem<URiftlineInteractionSubsystem>();
+    if (!Registry)
+    {
+        return false;
+    }
 
-    const FVector End = ViewLocation + (ViewRotation.Vector() * TraceDistance);
+    TArray<FRiftlineInteractionCandidate> Candidates;
+    Registry->QueryCandidates(ViewLocation, ViewDirection, TraceDistance, CandidateHalfAngle, CandidateAngleWeight, Candidates);
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(RiftlineInteractionOcclusion), true, PawnOwner);
+    const int32 Checks = FMath::Min(Candidates.Num(), MaxOcclusionChecks);
+    for (int32 Index = 0; Index < Checks; ++Index)
+    {
+        const FRiftlineInteractionCandidate& Candidate = Candidates[Index];
+
+        // Only geometry in between disqualifies a candidate; hitting the candidate itself is a clear line of sight.
+        FHitResult Blocker;
+        if (GetWorld()->LineTraceSingleByChannel(Blocker, ViewLocation, Candidate.Location, TraceChannel, QueryParams)
+            && Blocker.GetActor() != Candidate.Actor)
+        {
+            continue;
+        }
+
+        FRiftlineInteractionOptionsPtr Options = GatherOptions(Candidate.Actor, Candidate.Component, PawnOwner);
+        if (!Options.IsValid())
+        {
+            continue;
+        }
+
+        OutHit.Actor = Candidate.Actor;
+        OutHit.ImpactPoint = Blocker.bBlockingHit ? Blocker.ImpactPoint : Candidate.Location;
+        OutHit.SharedOptions = MoveTemp(Options);
+        return true;
+    }
+    return false;
+}
+
+bool URiftlineInteractionComponent::TraceInteraction(
+    APawn* PawnOwner,
+    const FVector& ViewLocation,
+    const FVector& ViewDirection,
+    FRiftlineInteractionHit& OutHit
+) const
+{
+    const FVector End = ViewLocation + (ViewDirection * TraceDistance);
     FHitResult HitResult;
     FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(RiftlineInteraction), true, PawnOwner);
     QueryParams.AddIgnoredActor(PawnOwner);
 
-    if (!GetWorld() || !GetWorld()->LineTraceSingleByChannel(HitResult, ViewLocation, End, TraceChannel, QueryParams))
+    if (!GetWorld()->LineTraceSingleByChannel(HitResult, ViewLocation, End, TraceChannel, QueryParams))
     {
         return false;
     }
 
-    TArray<FRiftlineInteractionOption> Options;
-    if (!GatherOptions(HitResult.GetActor(), PawnOwner, Options))
+    FRiftlineInteractionOptionsPtr Options = GatherOptions(HitResult.GetActor(), nullptr, PawnOwner);
+    if (!Options.IsValid())
     {
         return false;
     }
 
     OutHit.Actor = HitResult.GetActor();
     OutHit.ImpactPoint = HitResult.ImpactPoint;
-    OutHit.Options = Options;
-
-    LastActor = OutHit.Actor;
-    LastOptions = OutHit.Options;
+    OutHit.SharedOptions = MoveTemp(Options);
     return true;
 }
 
 bool URiftlineInteractionComponent::InvokeInteraction(FName OptionId)
 {
+    RIFTLINE_SCOPE(InvokeInteraction);
+
     APawn* PawnOwner = ResolvePawnOwner();
     if (!PawnOwner)
     {
@@ -90,7 +290,7 @@ bool URiftlineInteractionComponent::InvokeInteraction(FName OptionId)
     if (!TargetActor)
     {
         FRiftlineInteractionHit Hit;
-        if (!FindInteraction(Hit))
+        if (!FindSharedInteraction(Hit))
         {
             return false;
         }
@@ -108,17 +308,164 @@ bool URiftlineInteractionComponent::InvokeInteraction(FName OptionId)
 
 bool URiftlineInteractionComponent::TryInteract()
 {
+    RIFTLINE_SCOPE(TryInteract);
+
     FRiftlineInteractionHit Hit;
-    if (!FindInteraction(Hit))
+    if (!FindSharedInteraction(Hit))
     {
         return false;
     }
 
-    if (bAutoInvokeSingleOption && Hit.Options.Num() == 1)
+    if (bAutoInvokeSingleOption && Hit.SharedOptions->Num() == 1)
     {
-        return InvokeInteraction(Hit.Options[0].Id);
+        return InvokeInteraction((*Hit.SharedOptions)[0].Id);
     }
 
-    OnInteractionOptions.Broadcast(Hit);
+    BroadcastHit(Hit);
     return true;
 }
+
+bool URiftlineInteractionComponent::PrepareFocusQuery(
+    const URiftlineInteractionSubsystem& Registry,
+    TArray<FRiftlineInteractionCandidate>& Candidates,
+    FRiftlineInteractionQuery& OutQuery
+)
+{
+    RIFTLINE_SCOPE(InteractionUpdateFocus);
+
+    APawn* PawnOwner = ResolvePawnOwner();
+    if (!PawnOwner)
+    {
+        return false;
+    }
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    PawnOwner->GetActorEyesViewPoint(ViewLocation, ViewRotation);
+    const FVector ViewDirection = ViewRotation.Vector();
+
+    Registry.QueryCandidates(ViewLocation, ViewDirection, TraceDistance, CandidateHalfAngle, CandidateAngleWeight, Candidates);
+
+    // Hysteresis: the current focus is tried first unless another candidate clearly beats it.
+    if (Candidates.Num() > 1 && FocusActor.IsValid() && Candidates[0].Actor != FocusActor.Get())
+    {
+        const int32 Current = Candidates.IndexOfByPredicate([this](const FRiftlineInteractionCandidate& Candidate)
+        {
+            return Candidate.Actor == FocusActor.Get();
+        });
+        if (Current != INDEX_NONE && Candidates[Current].Score + FocusSwitchMargin >= Candidates[0].Score)
+        {
+            const FRiftlineInteractionCandidate Kept = Candidates[Current];
+            Candidates.RemoveAt(Current, 1, false);
+            Candidates.Insert(Kept, 0);
+        }
+    }
+
+    OutQuery.Start = ViewLocation;
+    OutQuery.Channel = TraceChannel;
+    OutQuery.Traces.Reset();
+
+    // Occluded candidates fall through to the next best one, like FindInteraction; the crosshair trace goes last.
+    const int32 CrosshairSlots = bTraceUnregisteredInteractables ? 1 : 0;
+    const int32 Checks = FMath::Min3(Candidates.Num(), MaxOcclusionChecks, FRiftlineInteractionQuery::MaxTraces - CrosshairSlots);
+    for (int32 Index = 0; Index < Checks; ++Index)
+    {
+        FRiftlineInteractionTrace& Trace = OutQuery.Traces.AddDefaulted_GetRef();
+        Trace.End = Candidates[Index].Location;
+        Trace.Target = Candidates[Index].Actor;
+        Trace.Interactable = Candidates[Index].Component;
+    }
+    if (CrosshairSlots > 0)
+    {
+        OutQuery.Traces.AddDefaulted_GetRef().End = ViewLocation + ViewDirection * TraceDistance;
+    }
+
+    if (OutQuery.Traces.Num() > 0)
+    {
+        return true;
+    }
+
+    LoseFocus(false);
+    return false;
+}
+
+void URiftlineInteractionComponent::HandleFocusResult(AActor* Target, URiftlineInteractableComponent* Interactable, const FVector& Point)
+{
+    if (!bTrackFocus)
+    {
+        return;
+    }
+
+    const FRiftlineInteractionOptionsPtr Options = Target ? GatherOptions(Target, Interactable, ResolvePawnOwner()) : nullptr;
+    if (Options.IsValid())
+    {
+        SetFocus(Target, Options, Point);
+    }
+    else
+    {
+        LoseFocus(false);
+    }
+}
+
+void URiftlineInteractionComponent::SetFocus(AActor* Actor, const FRiftlineInteractionOptionsPtr& Options, const FVector& Point)
+{
+    FocusLostAt = -1.0;
+    FocusPoint = Point;
+    if (FocusActor.Get() == Actor && SameOptions(FocusOptions, Options))
+    {
+        return;
+    }
+
+    FocusActor = Actor;
+    FocusOptions = Options;
+    LastActor = Actor;
+    LastOptions = FocusOptions;
+    BroadcastFocus();
+}
+
+void URiftlineInteractionComponent::LoseFocus(bool bImmediate)
+{
+    if (!FocusActor.IsValid() && !FocusOptions.IsValid())
+    {
+        return;
+    }
+
+    // A destroyed focus is dropped at once; an occluded or out-of-cone one gets a grace period so it does not flicker.
+    const double Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+    if (FocusLostAt < 0.0)
+    {
+        FocusLostAt = Now;
+    }
+    if (!bImmediate && FocusActor.IsValid() && Now - FocusLostAt < FocusLossGraceSeconds)
+    {
+        return;
+    }
+
+    FocusActor.Reset();
+    FocusOptions.Reset();
+    FocusLostAt = -1.0;
+    LastActor.Reset();
+    LastOptions.Reset();
+    BroadcastFocus();
+}
+
+void URiftlineInteractionComponent::BroadcastFocus()
+{
+    FRiftlineInteractionHit Hit;
+    Hit.Actor = FocusActor.Get();
+    Hit.ImpactPoint = FocusPoint;
+    Hit.SharedOptions = FocusOptions;
+    BroadcastHit(Hit);
+}
+
+void URiftlineInteractionComponent::BroadcastHit(FRiftlineInteractionHit& Hit)
+{
+    // Broadcasts only happen when focus or options change, so the Blueprint copy is paid once per change.
+    if (Hit.SharedOptions.IsValid())
+    {
+        Hit.Options = *Hit.SharedOptions;
+    }
+
+    RIFTLINE_COUNTER_INC(RiftlineDelegateBroadcasts);
+    OnInteractionOptions.Broadcast(Hit);
+}
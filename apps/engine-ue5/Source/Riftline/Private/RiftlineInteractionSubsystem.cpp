@@ -0,0 +1,439 @@
+#include "RiftlineInteractionSubsystem.h"
+
+#include "Engine/World.h"
+#include "Riftline.h"
+
+namespace
+{
+    /** Twice the default interaction reach, so a query touches at most four cells. */
+    constexpr float CellSize = 500.f;
+
+    /** Golden-ratio step that spreads interactors added on the same frame across their update interval. */
+    constexpr double PhaseStep = 0.6180339887;
+
+    /** Frames a focus trace may stay pending before its interactor is freed to issue another; results land in one or two. */
+    constexpr uint64 MaxFocusQueryFrames = 8;
+
+    /** Low bits of an async trace's user data that carry its index within the query. */
+    constexpr uint32 TraceIndexBits = 3;
+    static_assert(FRiftlineInteractionQuery::MaxTraces == 1 << TraceIndexBits, "Trace index must fit its bits");
+}
+
+void URiftlineInteractionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    TraceDelegate.BindUObject(this, &URiftlineInteractionSubsystem::HandleTrace);
+}
+
+void URiftlineInteractionSubsystem::Deinitialize()
+{
+    TraceDelegate.Unbind();
+    InFlight.Reset();
+    Interactors.Reset();
+    Super::Deinitialize();
+}
+
+TStatId URiftlineInteractionSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URiftlineInteractionSubsystem, STATGROUP_Riftline);
+}
+
+int32 URiftlineInteractionSubsystem::Register(URiftlineInteractableComponent* Component)
+{
+    FEntry Entry;
+    Entry.Component = Component;
+    Entry.Location = Component->GetComponentLocation();
+    Entry.Cell = CellOf(Entry.Location);
+
+    const int32 Handle = Entries.Add(Entry);
+    Cells.FindOrAdd(Entry.Cell).Add(Handle);
+    return Handle;
+}
+
+void URiftlineInteractionSubsystem::Unregister(int32 Handle)
+{
+    if (!Entries.IsValidIndex(Handle))
+    {
+        return;
+    }
+
+    RemoveFromCell(Handle, Entries[Handle].Cell);
+    Entries.RemoveAt(Handle);
+}
+
+void URiftlineInteractionSubsystem::UpdateLocation(int32 Handle, const FVector& Location)
+{
+    if (!Entries.IsValidIndex(Handle))
+    {
+        return;
+    }
+
+    FEntry& Entry = Entries[Handle];
+    Entry.Location = Location;
+
+    const FIntPoint Cell = CellOf(Location);
+    if (Cell != Entry.Cell)
+    {
+        RemoveFromCell(Handle, Entry.Cell);
+        Entry.Cell = Cell;
+        Cells.FindOrAdd(Cell).Add(Handle);
+    }
+}
+
+void URiftlineInteractionSubsystem::QueryCandidates(
+    const FVector& Origin,
+    const FVector& Direction,
+    float Radius,
+    float HalfAngleDegrees,
+    float AngleWeight,
+    TArray<FRiftlineInteractionCandidate>& OutCandidates) const
+{
+    RIFTLINE_SCOPE(InteractionQueryCandidates);
+
+    OutCandidates.Reset();
+
+    const FVector Forward = Direction.GetSafeNormal();
+    const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.f, 180.f)));
+    const float RadiusSquared = FMath::Square(Radius);
+    const FIntPoint MinCell = CellOf(Origin - FVector(Radius));
+    const FIntPoint MaxCell = CellOf(Origin + FVector(Radius));
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            const TArray<int32>* Handles = Cells.Find(FIntPoint(X, Y));
+            if (!Handles)
+            {
+                continue;
+            }
+
+            for (const int32 Handle : *Handles)
+            {
+                const FEntry& Entry = Entries[Handle];
+                const FVector ToTarget = Entry.Location - Origin;
+                const float DistanceSquared = ToTarget.SizeSquared();
+                if (DistanceSquared > RadiusSquared)
+                {
+                    continue;
+                }
+
+                const float Distance = FMath::Sqrt(DistanceSquared);
+                const float Cosine = Distance > KINDA_SMALL_NUMBER ? FVector::DotProduct(ToTarget / Distance, Forward) : 1.f;
+                if (Cosine < CosHalfAngle)
+                {
+                    continue;
+                }
+
+                const URiftlineInteractableComponent* Component = Entry.Component.Get();
+                AActor* Actor = Component ? Component->GetOwner() : nullptr;
+                if (!Actor)
+                {
+                    continue;
+                }
+
+                const float Alignment = CosHalfAngle < 1.f ? (Cosine - CosHalfAngle) / (1.f - CosHalfAngle) : 1.f;
+                const float Closeness = Radius > 0.f ? 1.f - Distance / Radius : 1.f;
+
+                FRiftlineInteractionCandidate& Candidate = OutCandidates.AddDefaulted_GetRef();
+                Candidate.Actor = Actor;
+                Candidate.Component = Entry.Component.Get();
+                Candidate.Location = Entry.Location;
+                Candidate.Distance = Distance;
+                Candidate.Score = FMath::Lerp(Closeness, Alignment, FMath::Clamp(AngleWeight, 0.f, 1.f));
+            }
+        }
+    }
+
+    OutCandidates.Sort([](const FRiftlineInteractionCandidate& A, const FRiftlineInteractionCandidate& B)
+    {
+        return A.Score > B.Score;
+    });
+}
+
+void URiftlineInteractionSubsystem::AddInteractor(URiftlineInteractionComponent* Interactor)
+{
+    if (!Interactor || Interactors.ContainsByPredicate([Interactor](const FInteractor& Entry) { return Entry.Component == Interactor; }))
+    {
+        return;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    FInteractor& Entry = Interactors.AddDefaulted_GetRef();
+    Entry.Component = Interactor;
+    Entry.NextUpdateAt = Now + Interactor->GetFocusInterval() * FMath::Frac(Interactors.Num() * PhaseStep);
+}
+
+void URiftlineInteractionSubsystem::RemoveInteractor(URiftlineInteractionComponent* Interactor)
+{
+    Interactors.RemoveAllSwap([Interactor](const FInteractor& Entry) { return Entry.Component == Interactor; });
+
+    // Its pending trace is forgotten so a late result cannot apply focus after tracking was turned off.
+    for (auto It = InFlight.CreateIterator(); It; ++It)
+    {
+        if (It.Value().Component == Interactor)
+        {
+            It.RemoveCurrent();
+        }
+    }
+    if (Interactor)
+    {
+        Interactor->bFocusQueryInFlight = false;
+    }
+}
+
+void URiftlineInteractionSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    RIFTLINE_SCOPE(InteractionBatch);
+
+    UWorld* World = GetWorld();
+    Interactors.RemoveAllSwap([](const FInteractor& Entry) { return !Entry.Component.IsValid(); });
+    ExpireInFlight();
+    if (!World || Interactors.Num() == 0)
+    {
+        RIFTLINE_COUNTER_SET(RiftlineInteractionQueries, 0);
+        return;
+    }
+
+    // Pick the due interactors; one trace in flight per interactor, and a result normally lands on the next frame.
+    const double Now = World->GetTimeSeconds();
+    Batch.Reset();
+    for (int32 Index = 0; Index < Interactors.Num(); ++Index)
+    {
+        const FInteractor& Interactor = Interactors[Index];
+        const URiftlineInteractionComponent* Component = Interactor.Component.Get();
+        if (Interactor.NextUpdateAt > Now || Component->bFocusQueryInFlight)
+        {
+            continue;
+        }
+
+        const AActor* Owner = Component->GetOwner();
+        FBatchEntry& Entry = Batch.AddDefaulted_GetRef();
+        Entry.Interactor = Index;
+        Entry.Overdue = Now - Interactor.NextUpdateAt;
+        Entry.Cell = CellOf(Owner ? Owner->GetActorLocation() : FVector::ZeroVector);
+    }
+
+    if (Batch.Num() > MaxFocusQueriesPerFrame)
+    {
+        Batch.Sort([](const FBatchEntry& A, const FBatchEntry& B) { return A.Overdue > B.Overdue; });
+        Batch.SetNum(FMath::Max(MaxFocusQueriesPerFrame, 0), false);
+    }
+    for (const FBatchEntry& Entry : Batch)
+    {
+        FInteractor& Interactor = Interactors[Entry.Interactor];
+        Interactor.NextUpdateAt = Now + Interactor.Component->GetFocusInterval();
+    }
+
+    // Neighbours walk the same grid cells and trace through the same part of the physics scene, so keep them together.
+    Batch.Sort([](const FBatchEntry& A, const FBatchEntry& B)
+    {
+        return A.Cell.X != B.Cell.X ? A.Cell.X < B.Cell.X : A.Cell.Y < B.Cell.Y;
+    });
+
+    // Resolve the components up front: a prepare can lose focus and broadcast, and a handler may add or remove interactors.
+    TArray<TWeakObjectPtr<URiftlineInteractionComponent>, TInlineAllocator<64>> Ordered;
+    Ordered.Reserve(Batch.Num());
+    for (const FBatchEntry& Entry : Batch)
+    {
+        Ordered.Add(Interactors[Entry.Interactor].Component);
+    }
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(RiftlineInteractionFocus), true);
+    int32 Issued = 0;
+    for (const TWeakObjectPtr<URiftlineInteractionComponent>& Weak : Ordered)
+    {
+        URiftlineInteractionComponent* Component = Weak.Get();
+        FRiftlineInteractionQuery Query;
+        if (!Component || !Component->PrepareFocusQuery(*this, CandidateScratch, Query))
+        {
+            continue;
+        }
+
+        const uint32 QueryId = NextQueryId++;
+        if (NextQueryId >= 1u << (32 - TraceIndexBits))
+        {
+            NextQueryId = 1;
+        }
+
+        FInFlightQuery& Pending = InFlight.Add(QueryId);
+        Pending.Component = Component;
+        Pending.Query = MoveTemp(Query);
+        Pending.Results.SetNum(Pending.Query.Traces.Num());
+        Pending.IssuedFrame = GFrameCounter;
+        Component->bFocusQueryInFlight = true;
+
+        QueryParams.ClearIgnoredActors();
+        QueryParams.AddIgnoredActor(Component->GetOwner());
+        for (int32 Index = 0; Index < Pending.Query.Traces.Num(); ++Index)
+        {
+            World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Pending.Query.Start, Pending.Query.Traces[Index].End, Pending.Query.Channel,
+                QueryParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, QueryId << TraceIndexBits | Index);
+        }
+        Issued += Pending.Query.Traces.Num();
+    }
+
+    RIFTLINE_COUNTER_SET(RiftlineInteractionQueries, Issued);
+}
+
+void URiftlineInteractionSubsystem::ExpireInFlight()
+{
+    // The world can drop an async trace (a level transition, a flushed batch); without this the interactor never traces again.
+    for (auto It = InFlight.CreateIterator(); It; ++It)
+    {
+        if (GFrameCounter - It.Value().IssuedFrame <= MaxFocusQueryFrames)
+        {
+            continue;
+        }
+        if (URiftlineInteractionComponent* Component = It.Value().Component.Get())
+        {
+            Component->bFocusQueryInFlight = false;
+        }
+        It.RemoveCurrent();
+    }
+}
+
+void URiftlineInteractionSubsystem::HandleTrace(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+    const uint32 QueryId = Datum.UserData >> TraceIndexBits;
+    const int32 Index = static_cast<int32>(Datum.UserData & ((1u << TraceIndexBits) - 1));
+    FInFlightQuery* Pending = InFlight.Find(QueryId);
+    if (!Pending || !Pending->Results.IsValidIndex(Index))
+    {
+        return;
+    }
+
+    // A crosshair trace takes whatever it hit; a candidate trace is clear unless something else is in between.
+    const FRiftlineInteractionTrace& Trace = Pending->Query.Traces[Index];
+    const FHitResult* Hit = Datum.OutHits.FindByPredicate([](const FHitResult& Result) { return Result.bBlockingHit; });
+    FTraceResult& Result = Pending->Results[Index];
+    Result.bLanded = true;
+    Result.Point = Hit ? Hit->ImpactPoint : Trace.End;
+    if (Trace.Target.IsExplicitlyNull())
+    {
+        Result.Actor = Hit ? Hit->GetActor() : nullptr;
+        Result.bClear = Result.Actor.IsValid();
+    }
+    else
+    {
+        Result.Actor = Trace.Target;
+        Result.bClear = !Hit || Hit->GetActor() == Trace.Target.Get();
+    }
+
+    // Settled once every trace ahead of the first clear one has landed blocked, as the synchronous FindInteraction picks.
+    int32 Chosen = INDEX_NONE;
+    for (int32 Candidate = 0; Candidate < Pending->Results.Num(); ++Candidate)
+    {
+        if (!Pending->Results[Candidate].bLanded)
+        {
+            return;
+        }
+        if (Pending->Results[Candidate].bClear)
+        {
+            Chosen = Candidate;
+            break;
+        }
+    }
+
+    // Later traces of a settled query find nothing and are ignored; a handler may add or remove interactors.
+    FInFlightQuery Settled;
+    InFlight.RemoveAndCopyValue(QueryId, Settled);
+    URiftlineInteractionComponent* Component = Settled.Component.Get();
+    if (!Component)
+    {
+        return;
+    }
+
+    Component->bFocusQueryInFlight = false;
+    if (Chosen == INDEX_NONE)
+    {
+        Component->HandleFocusResult(nullptr, nullptr, FVector::ZeroVector);
+        return;
+    }
+    Component->HandleFocusResult(Settled.Results[Chosen].Actor.Get(), Settled.Query.Traces[Chosen].Interactable.Get(), Settled.Results[Chosen].Point);
+}
+
+bool URiftlineInteractionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FIntPoint URiftlineInteractionSubsystem::CellOf(const FVector& Location)
+{
+    return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void URiftlineInteractionSubsystem::RemoveFromCell(int32 Handle, const FIntPoint& Cell)
+{
+    if (TArray<int32>* Handles = Cells.Find(Cell))
+    {
+        Handles->RemoveSingleSwap(Handle);
+        if (Handles->Num() == 0)
+        {
+            Cells.Remove(Cell);
+        }
+    }
+}
+
+URiftlineInteractableComponent::URiftlineInteractableComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+    bCacheOptions = false;
+}
+
+void URiftlineInteractableComponent::PublishOptions(const TArray<FRiftlineInteractionOption>& Options)
+{
+    TArray<FRiftlineInteractionOption> Published = Options;
+    Published.RemoveAll([](const FRiftlineInteractionOption& Option) { return Option.Id.IsNone(); });
+
+    PublishedOptions.Reset();
+    if (Published.Num() > 0)
+    {
+        PublishedOptions = MakeShared<TArray<FRiftlineInteractionOption>>(MoveTemp(Published));
+    }
+    bOptionsPublished = true;
+    ++OptionsVersion;
+}
+
+void URiftlineInteractableComponent::InvalidateOptions()
+{
+    ++OptionsVersion;
+}
+
+void URiftlineInteractableComponent::OnRegister()
+{
+    Super::OnRegister();
+
+    UWorld* World = GetWorld();
+    if (World && World->IsGameWorld())
+    {
+        Registry = World->GetSubsystem<URiftlineInteractionSubsystem>();
+        if (Registry.IsValid())
+        {
+            RegistryHandle = Registry->Register(this);
+        }
+    }
+}
+
+void URiftlineInteractableComponent::OnUnregister()
+{
+    if (Registry.IsValid())
+    {
+        Registry->Unregister(RegistryHandle);
+    }
+    Registry.Reset();
+    RegistryHandle = INDEX_NONE;
+
+    Super::OnUnregister();
+}
+
+void URiftlineInteractableComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+    if (Registry.IsValid())
+    {
+        Registry->UpdateLocation(RegistryHandle, GetComponentLocation());
+    }
+}
@@ -0,0 +1,474 @@
+#include "RiftlineJsonDecoder.h"
+
+#include "Misc/ScopeRWLock.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Riftline.h"
+#include "RiftlineTypes.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+    using FJsonPullReader = TJsonReader<TCHAR>;
+    using FCompactJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+    /** Backend payloads are a few levels deep; anything far deeper is malformed or hostile. */
+    constexpr int32 MaxDepth = 32;
+
+    struct FStructLayout
+    {
+        /** Properties each key fills; a key may fill more than one, which then share the first one's value. */
+        TMap<FString, TArray<const FProperty*, TInlineAllocator<1>>> Fields;
+    };
+
+    struct FKeyBinding
+    {
+        const TCHAR* Key;
+        const TCHAR* Property;
+    };
+
+    /** Gateway field names that differ from the property they fill. */
+    TArray<FKeyBinding> GetBindings(const UScriptStruct* Struct)
+    {
+        if (Struct == FRiftlineAuctionRow::StaticStruct())
+        {
+            return {
+                { TEXT("id"), TEXT("AuctionId") },
+                { TEXT("asset"), TEXT("AssetType") },
+                { TEXT("asset"), TEXT("Title") },
+                { TEXT("highestBid"), TEXT("Price") },
+                { TEXT("endTime"), TEXT("EndsAt") },
+            };
+        }
+        if (Struct == FRiftlineShardStatus::StaticStruct())
+        {
+            return { { TEXT("id"), TEXT("ShardId") } };
+        }
+        if (Struct == FRiftlineSessionProfile::StaticStruct())
+        {
+            return {
+                { TEXT("id"), TEXT("PlayerId") },
+                { TEXT("username"), TEXT("DisplayName") },
+                { TEXT("shard"), TEXT("CurrentShard") },
+            };
+        }
+        if (Struct == FRiftlineWalletView::StaticStruct())
+        {
+            return {
+                { TEXT("wallet"), TEXT("Address") },
+                { TEXT("softBalance"), TEXT("SoftCurrency") },
+            };
+        }
+        return {};
+    }
+
+    FString GetDefaultKey(const FProperty* Property)
+    {
+        FString Key = Property->GetName();
+        if (Property->IsA<FBoolProperty>() && Key.Len() > 1 && Key[0] == TEXT('b') && FChar::IsUpper(Key[1]))
+        {
+            Key.RightChopInline(1);
+        }
+        if (Key.Len() > 0)
+        {
+            Key[0] = FChar::ToLower(Key[0]);
+        }
+        return Key;
+    }
+
+    TUniquePtr<FStructLayout> BuildLayout(const UScriptStruct* Struct)
+    {
+        TUniquePtr<FStructLayout> Layout = MakeUnique<FStructLayout>();
+        for (TFieldIterator<FProperty> It(Struct); It; ++It)
+        {
+            Layout->Fields.FindOrAdd(GetDefaultKey(*It)).Add(*It);
+        }
+        for (const FKeyBinding& Binding : GetBindings(Struct))
+        {
+            if (const FProperty* Property = FindFProperty<FProperty>(Struct, Binding.Property))
+            {
+                Layout->Fields.FindOrAdd(Binding.Key).AddUnique(Property);
+            }
+        }
+        return Layout;
+    }
+
+    /** Layouts are built on first use and never change, so the read lock is the only cost once warm. */
+    const FStructLayout& GetLayout(const UScriptStruct* Struct)
+    {
+        static FRWLock LayoutLock;
+        static TMap<const UScriptStruct*, TUniquePtr<FStructLayout>> Layouts;
+        {
+            FReadScopeLock ReadLock(LayoutLock);
+            if (const TUniquePtr<FStructLayout>* Found = Layouts.Find(Struct))
+            {
+                return **Found;
+            }
+        }
+
+        TUniquePtr<FStructLayout> Built = BuildLayout(Struct);
+        FWriteScopeLock WriteLock(LayoutLock);
+        TUniquePtr<FStructLayout>& Slot = Layouts.FindOrAdd(Struct);
+        if (!Slot)
+        {
+            Slot = MoveTemp(Built);
+        }
+        return *Slot;
+    }
+
+    bool SkipValue(FJsonPullReader& Reader, EJsonNotation Notation)
+    {
+        switch (Notation)
+        {
+        case EJsonNotation::ObjectStart:
+            return Reader.SkipObject();
+        case EJsonNotation::ArrayStart:
+            return Reader.SkipArray();
+        case EJsonNotation::Error:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    /** Re-serialises the object or array the reader has just opened, so free-form payloads survive as text. */
+    bool CaptureValue(FJsonPullReader& Reader, EJsonNotation Notation, FString& Out)
+    {
+        Out.Reset();
+        const TSharedRef<FCompactJsonWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+
+        // One entry per open container, true for objects, whose members carry identifiers.
+        TArray<bool, TInlineAllocator<8>> Open;
+        do
+        {
+            const bool bMember = Open.Num() > 0 && Open.Last();
+            const FString& Identifier = Reader.GetIdentifier();
+            switch (Notation)
+            {
+            case EJsonNotation::ObjectStart:
+                bMember ? Writer->WriteObjectStart(Identifier) : Writer->WriteObjectStart();
+                Open.Push(true);
+                break;
+            case EJsonNotation::ArrayStart:
+                bMember ? Writer->WriteArrayStart(Identifier) : Writer->WriteArrayStart();
+                Open.Push(false);
+                break;
+            case EJsonNotation::ObjectEnd:
+                Writer->WriteObjectEnd();
+                Open.Pop(false);
+                break;
+            case EJsonNotation::ArrayEnd:
+                Writer->WriteArrayEnd();
+                Open.Pop(false);
+                break;
+            case EJsonNotation::String:
+                bMember ? Writer->WriteValue(Identifier, Reader.GetValueAsString()) : Writer->WriteValue(Reader.GetValueAsString());
+                break;
+            case EJsonNotation::Number:
+                bMember ? Writer->WriteValue(Identifier, Reader.GetValueAsNumber()) : Writer->WriteValue(Reader.GetValueAsNumber());
+                break;
+            case EJsonNotation::Boolean:
+                bMember ? Writer->WriteValue(Identifier, Reader.GetValueAsBoolean()) : Writer->WriteValue(Reader.GetValueAsBoolean());
+                break;
+            case EJsonNotation::Null:
+                bMember ? Writer->WriteNull(Identifier) : Writer->WriteNull();
+                break;
+            default:
+                return false;
+            }
+
+            if (Open.Num() == 0)
+            {
+                Writer->Close();
+                return true;
+            }
+            if (Open.Num() > MaxDepth)
+            {
+                return false;
+            }
+        }
+        while (Reader.ReadNext(Notation));
+        return false;
+    }
+
+    void SetNumber(const FNumericProperty* Property, void* Value, double Number)
+    {
+        if (Property->IsFloatingPoint())
+        {
+            Property->SetFloatingPointPropertyValue(Value, Number);
+            return;
+        }
+        if (!FMath::IsFinite(Number))
+        {
+            return;
+        }
+
+        // Balances arrive as arbitrary-size integers; saturate rather than wrap into a narrower field.
+        const double Max = Property->ElementSize >= 8 ? 9.2e18 : static_cast<double>(MAX_int32);
+        const double Min = Property->ElementSize >= 8 ? -9.2e18 : static_cast<double>(MIN_int32);
+        Property->SetIntPropertyValue(Value, static_cast<int64>(FMath::Clamp(Number, Min, Max)));
+    }
+
+    FDateTime FromUnixMilliseconds(int64 Milliseconds)
+    {
+        return FDateTime::FromUnixTimestamp(Milliseconds / 1000) + FTimespan::FromMilliseconds(static_cast<double>(Milliseconds % 1000));
+    }
+
+    /** Strings, numbers and booleans; values of the wrong kind leave the field as it was. */
+    void ReadScalar(const FJsonPullReader& Reader, EJsonNotation Notation, const FProperty* Property, void* Value)
+    {
+        if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+        {
+            FString& Target = *StrProperty->GetPropertyValuePtr(Value);
+            if (Notation == EJsonNotation::String)
+            {
+                Target = Reader.GetValueAsString();
+            }
+            else if (Notation == EJsonNotation::Number)
+            {
+                Target = Reader.GetValueAsNumberString();
+            }
+            else if (Notation == EJsonNotation::Boolean)
+            {
+                Target = Reader.GetValueAsBoolean() ? TEXT("true") : TEXT("false");
+            }
+        }
+        else if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+        {
+            if (Notation == EJsonNotation::String)
+            {
+                NameProperty->SetPropertyValue(Value, FName(*Reader.GetValueAsString()));
+            }
+        }
+        else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+        {
+            if (Notation == EJsonNotation::Boolean)
+            {
+                BoolProperty->SetPropertyValue(Value, Reader.GetValueAsBoolean());
+            }
+            else if (Notation == EJsonNotation::Number)
+            {
+                BoolProperty->SetPropertyValue(Value, Reader.GetValueAsNumber() != 0.0);
+            }
+            else if (Notation == EJsonNotation::String)
+            {
+                BoolProperty->SetPropertyValue(Value, Reader.GetValueAsString().ToBool());
+            }
+        }
+        else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+        {
+            int64 EnumValue = INDEX_NONE;
+            if (Notation == EJsonNotation::String)
+            {
+                EnumValue = EnumProperty->GetEnum()->GetValueByNameString(Reader.GetValueAsString());
+            }
+            else if (Notation == EJsonNotation::Number)
+            {
+                EnumValue = static_cast<int64>(Reader.GetValueAsNumber());
+            }
+            if (EnumValue != INDEX_NONE && EnumProperty->GetEnum()->IsValidEnumValue(EnumValue))
+            {
+                EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Value, EnumValue);
+            }
+        }
+        else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+        {
+            const UEnum* Enum = NumericProperty->GetIntPropertyEnum();
+            double Number = 0.0;
+            if (Notation == EJsonNotation::Number)
+            {
+                SetNumber(NumericProperty, Value, Reader.GetValueAsNumber());
+            }
+            else if (Notation == EJsonNotation::String && Enum)
+            {
+                const int64 EnumValue = Enum->GetValueByNameString(Reader.GetValueAsString());
+                if (EnumValue != INDEX_NONE)
+                {
+                    NumericProperty->SetIntPropertyValue(Value, EnumValue);
+                }
+            }
+            else if (Notation == EJsonNotation::String && LexTryParseString(Number, *Reader.GetValueAsString()))
+            {
+                SetNumber(NumericProperty, Value, Number);
+            }
+        }
+        else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+        {
+            if (StructProperty->Struct != TBaseStructure<FDateTime>::Get())
+            {
+                return;
+            }
+            FDateTime& Target = *static_cast<FDateTime*>(Value);
+            if (Notation == EJsonNotation::String)
+            {
+                FDateTime Parsed;
+                if (FDateTime::ParseIso8601(*Reader.GetValueAsString(), Parsed))
+                {
+                    Target = Parsed;
+                }
+            }
+            else if (Notation == EJsonNotation::Number)
+            {
+                Target = FromUnixMilliseconds(static_cast<int64>(Reader.GetValueAsNumber()));
+            }
+        }
+    }
+
+    bool ReadObject(FJsonPullReader& Reader, const UScriptStruct* Struct, void* Out, int32 Depth);
+
+    bool ReadValue(FJsonPullReader& Reader, EJsonNotation Notation, const FProperty* Property, void* Value, int32 Depth)
+    {
+        switch (Notation)
+        {
+        case EJsonNotation::Null:
+            return true;
+        case EJsonNotation::ObjectStart:
+            if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+            {
+                if (StructProperty->Struct != TBaseStructure<FDateTime>::Get())
+                {
+                    return ReadObject(Reader, StructProperty->Struct, Value, Depth + 1);
+                }
+            }
+            if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+            {
+                return CaptureValue(Reader, Notation, *StrProperty->GetPropertyValuePtr(Value));
+            }
+            return Reader.SkipObject();
+        case EJsonNotation::ArrayStart:
+            if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+            {
+                if (Depth >= MaxDepth)
+                {
+                    return false;
+                }
+                FScriptArrayHelper Helper(ArrayProperty, Value);
+                Helper.EmptyValues();
+                EJsonNotation ElementNotation;
+                while (Reader.ReadNext(ElementNotation))
+                {
+                    if (ElementNotation == EJsonNotation::ArrayEnd)
+                    {
+                        return true;
+                    }
+                    const int32 Index = Helper.AddValue();
+                    if (!ReadValue(Reader, ElementNotation, ArrayProperty->Inner, Helper.GetRawPtr(Index), Depth + 1))
+                    {
+                        return false;
+                    }
+                }
+                return false;
+            }
+            if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+            {
+                return CaptureValue(Reader, Notation, *StrProperty->GetPropertyValuePtr(Value));
+            }
+            return Reader.SkipArray();
+        case EJsonNotation::String:
+        case EJsonNotation::Number:
+        case EJsonNotation::Boolean:
+            ReadScalar(Reader, Notation, Property, Value);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /** Reads members up to the closing brace of an object whose opening brace the reader has just returned. */
+    bool ReadObject(FJsonPullReader& Reader, const UScriptStruct* Struct, void* Out, int32 Depth)
+    {
+        if (Depth >= MaxDepth)
+        {
+            return false;
+        }
+
+        const FStructLayout& Layout = GetLayout(Struct);
+        EJsonNotation Notation;
+        while (Reader.ReadNext(Notation))
+        {
+            if (Notation == EJsonNotation::ObjectEnd)
+            {
+                return true;
+            }
+
+            const TArray<const FProperty*, TInlineAllocator<1>>* Targets = Layout.Fields.Find(Reader.GetIdentifier());
+            if (!Targets)
+            {
+                if (!SkipValue(Reader, Notation))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            const FProperty* First = (*Targets)[0];
+            void* FirstValue = First->ContainerPtrToValuePtr<void>(Out);
+            if (!ReadValue(Reader, Notation, First, FirstValue, Depth))
+            {
+                return false;
+            }
+            for (int32 Index = 1; Index < Targets->Num(); ++Index)
+            {
+                const FProperty* Other = (*Targets)[Index];
+                if (Other->SameType(First))
+                {
+                    Other->CopyCompleteValue(Other->ContainerPtrToValuePtr<void>(Out), FirstValue);
+                }
+            }
+        }
+        return false;
+    }
+}
+
+namespace RiftlineJson
+{
+    bool DecodeStruct(const UScriptStruct* Struct, void* Out, const FString& Json)
+    {
+        LLM_SCOPE_BYTAG(Riftline_Network);
+        RIFTLINE_SCOPE(JsonDecodeStruct);
+
+        const TSharedRef<FJsonPullReader> Reader = TJsonReaderFactory<TCHAR>::Create(Json);
+        EJsonNotation Notation;
+        return Reader->ReadNext(Notation) && Notation == EJsonNotation::ObjectStart && ReadObject(*Reader, Struct, Out, 0);
+    }
+
+    bool DecodeStructArray(const UScriptStruct* Struct, TFunctionRef<void*()> AddElement, const FString& Json)
+    {
+        LLM_SCOPE_BYTAG(Riftline_Network);
+        RIFTLINE_SCOPE(JsonDecodeStructArray);
+
+        const TSharedRef<FJsonPullReader> Reader = TJsonReaderFactory<TCHAR>::Create(Json);
+        EJsonNotation Notation;
+        if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ArrayStart)
+        {
+            return false;
+        }
+
+        while (Reader->ReadNext(Notation))
+        {
+            if (Notation == EJsonNotation::ArrayEnd)
+            {
+                return true;
+            }
+            if (Notation == EJsonNotation::ObjectStart)
+            {
+                if (!ReadObject(*Reader, Struct, AddElement(), 1))
+                {
+                    return false;
+                }
+            }
+            else if (!SkipValue(*Reader, Notation))
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    FString Utf8ToString(const TArray<uint8>& Utf8)
+    {
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Utf8.GetData()), Utf8.Num());
+        return FString(Converted.Length(), Converted.Get());
+    }
+}
@@ -0,0 +1,149 @@
+#include "RiftlineNetworkQuality.h"
+
+#include "RiftlineHttpScheduler.h"
+#include <atomic>
+
+namespace
+{
+    std::atomic<int64> ServerClockOffsetTicks{0};
+
+    /** Nearest-rank percentile of an already sorted array. */
+    float Percentile(const TArray<float>& Sorted, float Quantile)
+    {
+        if (Sorted.Num() == 0)
+        {
+            return 0.f;
+        }
+        const int32 Rank = FMath::CeilToInt(Quantile * Sorted.Num());
+        return Sorted[FMath::Clamp(Rank - 1, 0, Sorted.Num() - 1)];
+    }
+}
+
+void FRiftlineNetworkQuality::RecordAttempt(const FString& Host, const FRiftlineHttpResult& Result)
+{
+    // 4xx answers are the application's business; the link itself delivered them fine.
+    const bool bFailed = !Result.bConnected || Result.Code >= 500;
+    RecentFailures = (RecentFailures << 1) | (bFailed ? 1 : 0);
+    RecentAttemptCount = FMath::Min(RecentAttemptCount + 1, RecentCount);
+
+    FRiftlineNetworkHostWindow& HostWindow = Window.FindOrAdd(Host);
+    ++HostWindow.Requests;
+    HostWindow.Failures += bFailed ? 1 : 0;
+    if (!Result.bConnected)
+    {
+        return;
+    }
+
+    float RoundTripMs = Result.LatencyMs;
+    if (Result.SentAtMs > 0 && Result.ServerReceivedAtMs > 0 && Result.ServerDurationMs >= 0.f)
+    {
+        // The receive time is derived from the monotonic latency so a wall-clock step mid-request cannot skew it.
+        const int64 ClientReceiveMs = Result.SentAtMs + FMath::RoundToInt64(Result.LatencyMs);
+        const int64 ServerSendMs = Result.ServerReceivedAtMs + FMath::RoundToInt64(Result.ServerDurationMs);
+        if (RecordClockSample(Result.SentAtMs, Result.ServerReceivedAtMs, ServerSendMs, ClientReceiveMs))
+        {
+            RoundTripMs = FMath::Max(Result.LatencyMs - Result.ServerDurationMs, 0.f);
+        }
+    }
+    AddRoundTrip(Host, RoundTripMs);
+}
+
+bool FRiftlineNetworkQuality::RecordClockSample(int64 ClientSendMs, int64 ServerReceiveMs, int64 ServerSendMs, int64 ClientReceiveMs)
+{
+    const int64 DelayMs = (ClientReceiveMs - ClientSendMs) - (ServerSendMs - ServerReceiveMs);
+    if (ClientReceiveMs < ClientSendMs || ServerSendMs < ServerReceiveMs || DelayMs < 0)
+    {
+        return false;
+    }
+
+    FClockSample& Sample = ClockSamples[NextClockSample];
+    Sample.OffsetMs = ((ServerReceiveMs - ClientSendMs) + (ServerSendMs - ClientReceiveMs)) / 2;
+    Sample.DelayMs = DelayMs;
+    NextClockSample = (NextClockSample + 1) % ClockFilterCount;
+    ClockSampleCount = FMath::Min(ClockSampleCount + 1, ClockFilterCount);
+
+    const FClockSample* Best = &ClockSamples[0];
+    for (int32 Index = 1; Index < ClockSampleCount; ++Index)
+    {
+        if (ClockSamples[Index].DelayMs < Best->DelayMs)
+        {
+            Best = &ClockSamples[Index];
+        }
+    }
+    ClockOffsetMs = Best->OffsetMs;
+    ClockErrorMs = Best->DelayMs / 2;
+    return true;
+}
+
+FRiftlineNetworkQualitySnapshot FRiftlineNetworkQuality::GetSnapshot() const
+{
+    TArray<float> Sorted(RecentRoundTrips, RecentRoundTripCount);
+    Sorted.Sort();
+
+    int32 Failures = 0;
+    for (int32 Index = 0; Index < RecentAttemptCount; ++Index)
+    {
+        Failures += (RecentFailures >> Index) & 1;
+    }
+
+    FRiftlineNetworkQualitySnapshot Snapshot;
+    Snapshot.RttP50Ms = Percentile(Sorted, 0.50f);
+    Snapshot.RttP95Ms = Percentile(Sorted, 0.95f);
+    Snapshot.FailureRate = RecentAttemptCount > 0 ? static_cast<float>(Failures) / RecentAttemptCount : 0.f;
+    Snapshot.ClockOffsetMs = static_cast<float>(ClockOffsetMs);
+    Snapshot.ClockErrorMs = static_cast<float>(ClockErrorMs);
+    Snapshot.bClockSynced = HasClockSync();
+    Snapshot.Samples = RecentRoundTripCount;
+    return Snapshot;
+}
+
+void FRiftlineNetworkQuality::ConsumeWindow(TMap<FString, FRiftlineNetworkHostWindow>& Out)
+{
+    Out = MoveTemp(Window);
+    Window.Reset();
+}
+
+void FRiftlineNetworkQuality::AddRoundTrip(const FString& Host, float RoundTripMs)
+{
+    RecentRoundTrips[NextRoundTrip] = RoundTripMs;
+    NextRoundTrip = (NextRoundTrip + 1) % RecentCount;
+    RecentRoundTripCount = FMath::Min(RecentRoundTripCount + 1, RecentCount);
+
+    const double Microseconds = FMath::Clamp(static_cast<double>(RoundTripMs) * 1000.0, 0.0, static_cast<double>(MAX_uint32));
+    Window.FindOrAdd(Host).RoundTrips.Add(static_cast<uint32>(Microseconds));
+}
+
+namespace RiftlineNetwork
+{
+    FDateTime GetServerNow()
+    {
+        return FDateTime::UtcNow() + FTimespan(ServerClockOffsetTicks.load(std::memory_order_relaxed));
+    }
+
+    void SetServerClockOffset(const FTimespan& Offset)
+    {
+        ServerClockOffsetTicks.store(Offset.GetTicks(), std::memory_order_relaxed);
+    }
+
+    bool ParseServerTiming(const FString& Value, float& OutMs)
+    {
+        const int32 Start = Value.Find(TEXT("dur="), ESearchCase::IgnoreCase);
+        if (Start == INDEX_NONE)
+        {
+            return false;
+        }
+
+        int32 End = Start + 4;
+        while (End < Value.Len() && (FChar::IsDigit(Value[End]) || Value[End] == TEXT('.')))
+        {
+            ++End;
+        }
+        if (End == Start + 4)
+        {
+            return false;
+        }
+
+        OutMs = FCString::Atof(*Value.Mid(Start + 4, End - Start - 4));
+        return true;
+    }
+}
@@ -0,0 +1,181 @@
+#include "RiftlinePerformanceMonitor.h"
+
+#include "DynamicRHI.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "RenderCore.h"
+
+namespace
+{
+    uint32 CyclesToMicroseconds(uint32 Cycles)
+    {
+        return static_cast<uint32>(FPlatformTime::ToMilliseconds64(Cycles) * 1000.0);
+    }
+
+    FRiftlineFrameTimeStats Summarise(const FRiftlineHistogram& Histogram)
+    {
+        FRiftlineFrameTimeStats Stats;
+        Stats.AvgMs = static_cast<float>(Histogram.GetMean() / 1000.0);
+        Stats.P50Ms = Histogram.ValueAtQuantile(0.50) / 1000.f;
+        Stats.P90Ms = Histogram.ValueAtQuantile(0.90) / 1000.f;
+        Stats.P99Ms = Histogram.ValueAtQuantile(0.99) / 1000.f;
+        Stats.MaxMs = Histogram.GetMax() / 1000.f;
+        return Stats;
+    }
+}
+
+void FRiftlineHistogram::Add(uint32 ValueUs)
+{
+    ValueUs = FMath::Min<uint32>(ValueUs, (1u << MaxValueBits) - 1);
+    ++Counts[BucketIndex(ValueUs)];
+    ++Count;
+    Sum += ValueUs;
+    Max = FMath::Max(Max, ValueUs);
+}
+
+void FRiftlineHistogram::Reset()
+{
+    FMemory::Memzero(Counts, sizeof(Counts));
+    Count = 0;
+    Sum = 0;
+    Max = 0;
+}
+
+uint32 FRiftlineHistogram::ValueAtQuantile(double Quantile) const
+{
+    if (Count == 0)
+    {
+        return 0;
+    }
+
+    const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Quantile, 0.0, 1.0) * Count)));
+    uint64 Seen = 0;
+    for (int32 Index = 0; Index < BucketCount; ++Index)
+    {
+        Seen += Counts[Index];
+        if (Seen >= Rank)
+        {
+            return FMath::Min(BucketMidpoint(Index), Max);
+        }
+    }
+    return Max;
+}
+
+int32 FRiftlineHistogram::BucketIndex(uint32 ValueUs)
+{
+    if (ValueUs < static_cast<uint32>(SubBucketCount))
+    {
+        return static_cast<int32>(ValueUs);
+    }
+    const int32 Exponent = static_cast<int32>(FMath::FloorLog2(ValueUs));
+    const int32 Shift = Exponent - SubBucketBits;
+    const int32 SubBucket = static_cast<int32>(ValueUs >> Shift) - SubBucketCount;
+    return (Shift + 1) * SubBucketCount + SubBucket;
+}
+
+uint32 FRiftlineHistogram::BucketMidpoint(int32 Index)
+{
+    if (Index < SubBucketCount)
+    {
+        return static_cast<uint32>(Index);
+    }
+    const int32 Shift = Index / SubBucketCount - 1;
+    const uint32 Lower = static_cast<uint32>(SubBucketCount + Index % SubBucketCount) << Shift;
+    return Lower + ((1u << Shift) >> 1);
+}
+
+FRiftlinePerformanceMonitor::FRiftlinePerformanceMonitor(float InHitchThresholdMs, int32 InMaxHitchReportsPerWindow)
+    : HitchThresholdUs(static_cast<uint32>(FMath::Max(InHitchThresholdMs, 1.f) * 1000.f))
+    , MaxHitchReportsPerWindow(FMath::Max(InMaxHitchReportsPerWindow, 0))
+{
+}
+
+FRiftlinePerformanceMonitor::~FRiftlinePerformanceMonitor()
+{
+    Stop();
+}
+
+void FRiftlinePerformanceMonitor::Start()
+{
+    Stop();
+    LastFrameSeconds = 0.0;
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FRiftlinePerformanceMonitor::HandleEndFrame);
+    ForegroundHandle = FCoreDelegates::ApplicationHasEnteredForegroundDelegate.AddRaw(this, &FRiftlinePerformanceMonitor::HandleEnteredForeground);
+}
+
+void FRiftlinePerformanceMonitor::Stop()
+{
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    FCoreDelegates::ApplicationHasEnteredForegroundDelegate.Remove(ForegroundHandle);
+    EndFrameHandle.Reset();
+    ForegroundHandle.Reset();
+}
+
+bool FRiftlinePerformanceMonitor::ConsumeWindow(FRiftlineFrameTimeSummary& Out)
+{
+    FRiftlineHistogram& FrameTimes = Histograms[static_cast<int32>(ERiftlineFrameTimer::Frame)];
+    if (FrameTimes.GetCount() == 0)
+    {
+        return false;
+    }
+
+    Out.Frames = static_cast<int64>(FrameTimes.GetCount());
+    Out.Hitches = Hitches;
+    for (int32 Index = 0; Index < UE_ARRAY_COUNT(Histograms); ++Index)
+    {
+        Out.Timers[Index] = Summarise(Histograms[Index]);
+        Histograms[Index].Reset();
+    }
+
+    Hitches = 0;
+    return true;
+}
+
+void FRiftlinePerformanceMonitor::HandleEndFrame()
+{
+    const double Now = FPlatformTime::Seconds();
+    const double Previous = LastFrameSeconds;
+    LastFrameSeconds = Now;
+    if (Previous <= 0.0)
+    {
+        return;
+    }
+
+    uint32 TimesUs[static_cast<int32>(ERiftlineFrameTimer::Count)];
+    TimesUs[static_cast<int32>(ERiftlineFrameTimer::Frame)] = static_cast<uint32>(FMath::Min((Now - Previous) * 1000000.0, static_cast<double>(MAX_uint32)));
+    TimesUs[static_cast<int32>(ERiftlineFrameTimer::GameThread)] = CyclesToMicroseconds(GGameThreadTime);
+    TimesUs[static_cast<int32>(ERiftlineFrameTimer::RenderThread)] = CyclesToMicroseconds(GRenderThreadTime);
+    TimesUs[static_cast<int32>(ERiftlineFrameTimer::RHIThread)] = CyclesToMicroseconds(GRHIThreadTime);
+    TimesUs[static_cast<int32>(ERiftlineFrameTimer::GPU)] = CyclesToMicroseconds(RHIGetGPUFrameCycles());
+
+    for (int32 Index = 0; Index < UE_ARRAY_COUNT(Histograms); ++Index)
+    {
+        // The RHI thread and GPU timers read zero on platforms that do not run or expose them.
+        if (TimesUs[Index] > 0 || Index == static_cast<int32>(ERiftlineFrameTimer::Frame))
+        {
+            Histograms[Index].Add(TimesUs[Index]);
+        }
+    }
+
+    if (TimesUs[static_cast<int32>(ERiftlineFrameTimer::Frame)] < HitchThresholdUs)
+    {
+        return;
+    }
+
+    ++Hitches;
+    if (Hitches <= MaxHitchReportsPerWindow && OnHitch.IsBound())
+    {
+        FRiftlineHitchSample Sample;
+        for (int32 Index = 0; Index < UE_ARRAY_COUNT(TimesUs); ++Index)
+        {
+            Sample.TimesMs[Index] = TimesUs[Index] / 1000.f;
+        }
+        OnHitch.Execute(Sample);
+    }
+}
+
+void FRiftlinePerformanceMonitor::HandleEnteredForeground()
+{
+    // Time spent suspended is not a frame; restart the delta so it does not register as a hitch.
+    LastFrameSeconds = 0.0;
+}
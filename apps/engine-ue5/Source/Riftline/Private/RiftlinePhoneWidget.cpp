@@ -1,20 +1,42 @@
 #include "RiftlinePhoneWidget.h"
 
+#include "Async/Async.h"
 #include "Components/Button.h"
+#include "Components/ListView.h"
+#include "Components/PanelWidget.h"
 #include "Components/TextBlock.h"
 #include "Components/Widget.h"
 #include "Components/WidgetSwitcher.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Riftline.h"
+#include "RiftlineAuctionEntryWidget.h"
+#include "RiftlineBackendSubsystem.h"
 #include "RiftlineGameInstance.h"
+#include "RiftlineNetworkQuality.h"
+#include "RiftlineTelemetry.h"
+
+namespace
+{
+    const FName SourcePhone(TEXT("phone"));
+}
 
 URiftlinePhoneWidget::URiftlinePhoneWidget(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
     , ActiveTab(ERiftlinePhoneTab::Shards)
 {
+    // Phones reclaim idle tabs quickly; desktops can afford to keep them for a session.
+    TabIdleReleaseSeconds = PLATFORM_ANDROID || PLATFORM_IOS ? 120.f : 900.f;
+    AuctionRefreshMinSeconds = 30.f;
 }
 
 void URiftlinePhoneWidget::NativeOnInitialized()
 {
+    LLM_SCOPE_BYTAG(Riftline_UI);
+
     Super::NativeOnInitialized();
 
     if (TabShard)
@@ -38,31 +60,69 @@ void URiftlinePhoneWidget::NativeOnInitialized()
         TabMessages->OnClicked.AddDynamic(this, &URiftlinePhoneWidget::HandleMessagesTabClicked);
     }
 
+    if (URiftlineBackendSubsystem* Backend = ResolveBackend())
+    {
+        Backend->OnAuctionsLoaded.AddUniqueDynamic(this, &URiftlinePhoneWidget::OnAuctionsUpdated);
+    }
+
+    TabContent.SetNum(NumTabs);
+    MemoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddUObject(this, &URiftlinePhoneWidget::HandleMemoryTrim);
+
     ActiveTab = DefaultTab;
     SetActiveTab(ActiveTab, false);
 }
 
+void URiftlinePhoneWidget::BeginDestroy()
+{
+    FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimHandle);
+    Super::BeginDestroy();
+}
+
+void URiftlinePhoneWidget::HandleSessionChanges(const FRiftlineSessionStore& Store, ERiftlineSessionField Changed)
+{
+    RIFTLINE_SCOPE(PhoneSessionChanges);
+
+    const FRiftlineSessionProfile& Profile = Store.GetProfile();
+    if (EnumHasAnyFlags(Changed, ERiftlineSessionField::Identity | ERiftlineSessionField::Wallet))
+    {
+        HandleSessionUpdated(Profile);
+    }
+    if (EnumHasAnyFlags(Changed, ERiftlineSessionField::Shard) && Profile.CurrentShard.ShardId != INDEX_NONE)
+    {
+        HandleShardStatus(Profile.CurrentShard);
+    }
+    if (EnumHasAnyFlags(Changed, ERiftlineSessionField::Wanted))
+    {
+        HandleWantedUpdated(Profile.Wanted);
+    }
+    if (EnumHasAnyFlags(Changed, ERiftlineSessionField::Compliance))
+    {
+        HandleComplianceUpdated(Profile.Compliance);
+    }
+    if (EnumHasAnyFlags(Changed, ERiftlineSessionField::WalletView))
+    {
+        HandleWalletUpdated(Store.GetWalletView());
+    }
+    if (EnumHasAnyFlags(Changed, ERiftlineSessionField::Missions))
+    {
+        HandleMissionsUpdated(Store.GetMissions());
+    }
+}
+
 void URiftlinePhoneWidget::HandleSessionUpdated(const FRiftlineSessionProfile& Profile)
 {
+    RIFTLINE_SCOPE(PhoneHandleSessionUpdated);
+
     const bool bWalletChanged = CachedSession.Wallet != Profile.Wallet;
     CachedSession = Profile;
 
-  if (Profile.CurrentShard.ShardId != INDEX_NONE)
-  {
-    KnownShards.AddUnique(Profile.CurrentShard);
-    UpdateShardDetails(Profile.CurrentShard);
-  }
-
-  CachedCompliance = Profile.Compliance;
-  UpdateComplianceDetails(Profile.Compliance);
-
     OnSessionUpdated(Profile);
 
     if (bWalletChanged && !Profile.Wallet.IsEmpty() && !bWalletLoginTelemetrySent)
     {
-        TMap<FString, FString> Properties;
-        Properties.Add(TEXT("address"), Profile.Wallet);
-        EmitTelemetry(TEXT("wallet.login"), Properties);
+        FRiftlineTelemetryEvent Event(RiftlineTelemetry::Events::WalletLogin);
+        Event.AddString(RiftlineTelemetry::Keys::Address, Profile.Wallet);
+        EmitTelemetry(Event);
         bWalletLoginTelemetrySent = true;
     }
 }
@@ -84,7 +144,16 @@ void URiftlinePhoneWidget::HandleComplianceUpdated(const FRiftlineComplianceStat
 void URiftlinePhoneWidget::HandleShardStatus(const FRiftlineShardStatus& Status)
 {
     CachedSession.CurrentShard = Status;
-    KnownShards.AddUnique(Status);
+
+    // Population ticks update the shard's existing entry rather than adding one per tick.
+    if (FRiftlineShardStatus* Known = KnownShards.FindByPredicate([&Status](const FRiftlineShardStatus& Shard) { return Shard.ShardId == Status.ShardId; }))
+    {
+        *Known = Status;
+    }
+    else
+    {
+        KnownShards.Add(Status);
+    }
     UpdateShardDetails(Status);
     OnShardStatusChanged(Status);
 }
@@ -114,56 +183,259 @@ void URiftlinePhoneWidget::OnComplianceChanged(const FRiftlineComplianceState& C
 
 void URiftlinePhoneWidget::OnAuctionsUpdated(const TArray<FRiftlineAuctionRow>& Rows)
 {
-    CachedAuctions = Rows;
-    RefreshAuctionsUI();
+    RIFTLINE_SCOPE(PhoneAuctionsUpdated);
+    LLM_SCOPE_BYTAG(Riftline_UI);
+
+    URiftlineAuctionModel* Model = GetAuctionModel();
+    Model->ReplaceAll(Rows);
+
+    FRiftlineTelemetryEvent Event(RiftlineTelemetry::Events::MarketList);
+    Event.Add(RiftlineTelemetry::Keys::Count, Model->Num());
+    EmitTelemetry(Event);
+}
+
+void URiftlinePhoneWidget::ApplyAuctionUpserts(const TArray<FRiftlineAuctionRow>& Rows)
+{
+    LLM_SCOPE_BYTAG(Riftline_UI);
+    GetAuctionModel()->Upsert(Rows);
+}
+
+void URiftlinePhoneWidget::ApplyAuctionRemovals(const TArray<int32>& AuctionIds)
+{
+    GetAuctionModel()->Remove(AuctionIds);
+}
+
+URiftlineAuctionModel* URiftlinePhoneWidget::GetAuctionModel()
+{
+    if (!Auctions)
+    {
+        Auctions = NewObject<URiftlineAuctionModel>(this);
+        Auctions->OnChanged.AddDynamic(this, &URiftlinePhoneWidget::HandleAuctionChanges);
+    }
+    return Auctions;
+}
+
+void URiftlinePhoneWidget::SetAuctionListView(UListView* ListView)
+{
+    AuctionList = ListView;
+    bAuctionListStale = true;
+    if (IsAuctionTabShown())
+    {
+        RefreshAuctionsUI();
+    }
+    UpdateAuctionCountdownTimer();
+}
 
-    TMap<FString, FString> Properties;
-    Properties.Add(TEXT("count"), FString::FromInt(CachedAuctions.Num()));
-    EmitTelemetry(TEXT("market.list"), Properties);
+void URiftlinePhoneWidget::HandleAuctionChanges(const FRiftlineAuctionChangeSet& Changes)
+{
+    // Row edits reach the visible entries through their items; only membership and order changes touch the list.
+    bAuctionListStale |= Changes.bOrderChanged;
+    if (IsAuctionTabShown())
+    {
+        RefreshAuctionsUI();
+    }
+    OnAuctionsChanged(Changes);
 }
 
 void URiftlinePhoneWidget::SetActiveTab(ERiftlinePhoneTab Tab, bool bEmitTelemetry)
 {
+    RIFTLINE_SCOPE(PhoneSetActiveTab);
+
+    const ERiftlinePhoneTab Previous = ActiveTab;
     ActiveTab = Tab;
     if (Tabs)
     {
         Tabs->SetActiveWidgetIndex(static_cast<int32>(Tab));
     }
 
+    LazyTabs[static_cast<int32>(Tab)].InactiveSince = -1.0;
+    if (Previous != Tab)
+    {
+        LazyTabs[static_cast<int32>(Previous)].InactiveSince = FPlatformTime::Seconds();
+        UWorld* World = GetWorld();
+        if (World && TabIdleReleaseSeconds > 0.f && !World->GetTimerManager().IsTimerActive(IdleReleaseTimer))
+        {
+            World->GetTimerManager().SetTimer(IdleReleaseTimer, this, &URiftlinePhoneWidget::ReleaseIdleTabs, FMath::Max(TabIdleReleaseSeconds * 0.5f, 1.f), true);
+        }
+    }
+
+    // Nothing is loaded for a phone that has never been opened.
+    if (bPhoneShown)
+    {
+        EnsureTabContent(Tab);
+    }
+
     if (Tab == ERiftlinePhoneTab::Auctions)
     {
+        // A stale list view is re-rendered from the model; only the age of the listings decides whether to refetch.
         RefreshAuctionsUI();
+
+        // Opening the phone re-enters the active tab, and realtime upserts keep the model current in between.
+        // Listings land through OnAuctionsUpdated once decoded off the game thread.
+        const double Now = FPlatformTime::Seconds();
+        const bool bListingsOld = AuctionsRequestedAt < 0.0 || Now - AuctionsRequestedAt >= AuctionRefreshMinSeconds;
+        URiftlineBackendSubsystem* Backend = bPhoneShown && bListingsOld ? ResolveBackend() : nullptr;
+        if (Backend)
+        {
+            AuctionsRequestedAt = Now;
+            Backend->RefreshAuctions();
+        }
     }
+    UpdateAuctionCountdownTimer();
 
     if (!bEmitTelemetry)
     {
         return;
     }
 
-    const UEnum* EnumClass = StaticEnum<ERiftlinePhoneTab>();
-    FString TabName = EnumClass ? EnumClass->GetNameStringByValue(static_cast<int64>(Tab)) : TEXT("Unknown");
-
-    TMap<FString, FString> Properties;
-    Properties.Add(TEXT("tab"), TabName);
-    EmitTelemetry(TEXT("ui.phone.tab"), Properties);
+    FRiftlineTelemetryEvent TabEvent(RiftlineTelemetry::Events::PhoneTab);
+    TabEvent.Add(RiftlineTelemetry::Keys::Tab, Tab);
+    EmitTelemetry(TabEvent);
 
     if (Tab == ERiftlinePhoneTab::Auctions)
     {
-        TMap<FString, FString> MarketProps;
-        MarketProps.Add(TEXT("source"), TEXT("phone"));
-        MarketProps.Add(TEXT("items"), FString::FromInt(CachedAuctions.Num()));
-        EmitTelemetry(TEXT("market.view"), MarketProps);
+        FRiftlineTelemetryEvent MarketEvent(RiftlineTelemetry::Events::MarketView);
+        MarketEvent.Add(RiftlineTelemetry::Keys::Source, SourcePhone)
+            .Add(RiftlineTelemetry::Keys::Items, Auctions ? Auctions->Num() : 0);
+        EmitTelemetry(MarketEvent);
     }
 }
 
 void URiftlinePhoneWidget::NotifyPhoneVisible(bool bVisible)
 {
+    bPhoneShown = bVisible;
     OnPhoneVisibilityChanged(bVisible);
 
     if (bVisible)
     {
         SetActiveTab(ActiveTab, false);
     }
+    else
+    {
+        UpdateAuctionCountdownTimer();
+    }
+}
+
+UUserWidget* URiftlinePhoneWidget::GetTabContent(ERiftlinePhoneTab Tab) const
+{
+    const int32 Index = static_cast<int32>(Tab);
+    return TabContent.IsValidIndex(Index) ? TabContent[Index] : nullptr;
+}
+
+void URiftlinePhoneWidget::ReleaseInactiveTabs(float MinIdleSeconds)
+{
+    const double Now = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumTabs; ++Index)
+    {
+        const FLazyTab& Lazy = LazyTabs[Index];
+        const bool bHeld = GetTabContent(static_cast<ERiftlinePhoneTab>(Index)) || Lazy.Handle.IsValid();
+        if (bHeld && Index != static_cast<int32>(ActiveTab) && Lazy.InactiveSince >= 0.0 && Now - Lazy.InactiveSince >= MinIdleSeconds)
+        {
+            ReleaseTab(Index);
+        }
+    }
+}
+
+void URiftlinePhoneWidget::EnsureTabContent(ERiftlinePhoneTab Tab)
+{
+    const int32 Index = static_cast<int32>(Tab);
+    const TSoftClassPtr<UUserWidget>* ContentClass = TabContentClasses.Find(Tab);
+    if (!ContentClass || ContentClass->IsNull() || GetTabContent(Tab) || LazyTabs[Index].Handle.IsValid())
+    {
+        return;
+    }
+
+    LazyTabs[Index].Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        ContentClass->ToSoftObjectPath(),
+        FStreamableDelegate::CreateUObject(this, &URiftlinePhoneWidget::CreateTabContent, Tab),
+        FStreamableManager::AsyncLoadHighPriority);
+}
+
+void URiftlinePhoneWidget::CreateTabContent(ERiftlinePhoneTab Tab)
+{
+    RIFTLINE_SCOPE(PhoneCreateTabContent);
+    LLM_SCOPE_BYTAG(Riftline_UI);
+
+    const int32 Index = static_cast<int32>(Tab);
+    if (!TabContent.IsValidIndex(Index) || TabContent[Index])
+    {
+        return;
+    }
+
+    UClass* ContentClass = TabContentClasses.FindRef(Tab).Get();
+    UPanelWidget* Container = Tabs ? Cast<UPanelWidget>(Tabs->GetWidgetAtIndex(Index)) : nullptr;
+    if (!ContentClass || !Container)
+    {
+        UE_LOG(LogRiftline, Warning, TEXT("Phone tab %d has no loadable class or no panel to hold it"), Index);
+        return;
+    }
+
+    UUserWidget* Content = CreateWidget<UUserWidget>(this, ContentClass);
+    Container->AddChild(Content);
+    TabContent[Index] = Content;
+    OnTabContentCreated(Tab, Content);
+
+    if (Tab == ERiftlinePhoneTab::Auctions)
+    {
+        RefreshAuctionsUI();
+    }
+}
+
+void URiftlinePhoneWidget::ReleaseTab(int32 Index)
+{
+    FLazyTab& Lazy = LazyTabs[Index];
+    if (Lazy.Handle.IsValid())
+    {
+        if (Lazy.Handle->IsLoadingInProgress())
+        {
+            Lazy.Handle->CancelHandle();
+        }
+        else
+        {
+            Lazy.Handle->ReleaseHandle();
+        }
+        Lazy.Handle.Reset();
+    }
+    Lazy.InactiveSince = -1.0;
+
+    if (UUserWidget* Content = GetTabContent(static_cast<ERiftlinePhoneTab>(Index)))
+    {
+        if (AuctionList && AuctionList->GetTypedOuter<UUserWidget>() == Content)
+        {
+            SetAuctionListView(nullptr);
+        }
+        Content->RemoveFromParent();
+        TabContent[Index] = nullptr;
+        OnTabContentReleased(static_cast<ERiftlinePhoneTab>(Index));
+    }
+}
+
+void URiftlinePhoneWidget::ReleaseIdleTabs()
+{
+    ReleaseInactiveTabs(TabIdleReleaseSeconds);
+
+    bool bAnyHeld = false;
+    for (int32 Index = 0; Index < NumTabs; ++Index)
+    {
+        bAnyHeld |= Index != static_cast<int32>(ActiveTab) && (GetTabContent(static_cast<ERiftlinePhoneTab>(Index)) || LazyTabs[Index].Handle.IsValid());
+    }
+    if (!bAnyHeld && GetWorld())
+    {
+        GetWorld()->GetTimerManager().ClearTimer(IdleReleaseTimer);
+    }
+}
+
+void URiftlinePhoneWidget::HandleMemoryTrim()
+{
+    // Platforms may signal from their own threads; the widget tree is only touched on the game thread.
+    AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<URiftlinePhoneWidget>(this)]()
+    {
+        if (URiftlinePhoneWidget* Phone = WeakThis.Get())
+        {
+            UE_LOG(LogRiftline, Log, TEXT("Memory trim: releasing inactive phone tabs"));
+            Phone->ReleaseInactiveTabs(0.f);
+        }
+    });
 }
 
 void URiftlinePhoneWidget::HandleShardTabClicked()
@@ -191,21 +463,11 @@ void URiftlinePhoneWidget::HandleMessagesTabClicked()
     SetActiveTab(ERiftlinePhoneTab::Messages);
 }
 
-void URiftlinePhoneWidget::EmitTelemetry(const FString& Event) const
+void URiftlinePhoneWidget::EmitTelemetry(const FRiftlineTelemetryEvent& Event) const
 {
-    EmitTelemetry(Event, TMap<FString, FString>());
-}
-
-void URiftlinePhoneWidget::EmitTelemetry(const FString& Event, const TMap<FString, FString>& Properties) const
-{
-    if (Event.IsEmpty())
-    {
-        return;
-    }
-
     if (URiftlineGameInstance* GameInstance = ResolveGameInstance())
     {
-        GameInstance->PushTelemetryEvent(Event, Properties);
+        GameInstance->PushTelemetry(Event);
     }
 }
 
@@ -218,6 +480,12 @@ URiftlineGameInstance* URiftlinePhoneWidget::ResolveGameInstance() const
     return nullptr;
 }
 
+URiftlineBackendSubsystem* URiftlinePhoneWidget::ResolveBackend() const
+{
+    const URiftlineGameInstance* GameInstance = ResolveGameInstance();
+    return GameInstance ? GameInstance->GetSubsystem<URiftlineBackendSubsystem>() : nullptr;
+}
+
 void URiftlinePhoneWidget::UpdateShardDetails(const FRiftlineShardStatus& Status)
 {
     if (ShardNameText)
@@ -264,10 +532,58 @@ void URiftlinePhoneWidget::UpdateWalletDetails(const FRiftlineWalletView& Wallet
 
 void URiftlinePhoneWidget::RefreshAuctionsUI()
 {
+    RIFTLINE_SCOPE(PhoneRefreshAuctions);
+
+    const int32 Count = Auctions ? Auctions->Num() : 0;
     if (AuctionsEmptyState)
     {
-        AuctionsEmptyState->SetVisibility(CachedAuctions.Num() > 0 ? ESlateVisibility::Collapsed : ESlateVisibility::Visible);
+        AuctionsEmptyState->SetVisibility(Count > 0 ? ESlateVisibility::Collapsed : ESlateVisibility::Visible);
     }
 
-    OnAuctionsChanged(CachedAuctions);
+    // The list only builds entries for visible rows, so handing it thousands of items is cheap.
+    if (AuctionList && bAuctionListStale)
+    {
+        AuctionList->SetListItems(GetAuctionModel()->GetItems());
+        bAuctionListStale = false;
+    }
+}
+
+void URiftlinePhoneWidget::UpdateAuctionCountdownTimer()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    FTimerManager& Timers = World->GetTimerManager();
+    const bool bWanted = AuctionList && IsAuctionTabShown();
+    if (bWanted && !Timers.IsTimerActive(AuctionCountdownTimer))
+    {
+        Timers.SetTimer(AuctionCountdownTimer, this, &URiftlinePhoneWidget::UpdateAuctionCountdown, 1.f, true);
+    }
+    else if (!bWanted)
+    {
+        Timers.ClearTimer(AuctionCountdownTimer);
+    }
+}
+
+void URiftlinePhoneWidget::UpdateAuctionCountdown()
+{
+    RIFTLINE_SCOPE(PhoneAuctionCountdown);
+
+    if (!AuctionList)
+    {
+        return;
+    }
+
+    // One clock read for every visible row; rows scrolled out of view have no widget to update.
+    const FDateTime Now = RiftlineNetwork::GetServerNow();
+    for (UUserWidget* Entry : AuctionList->GetDisplayedEntryWidgets())
+    {
+        if (URiftlineAuctionEntryWidget* AuctionEntry = Cast<URiftlineAuctionEntryWidget>(Entry))
+        {
+            AuctionEntry->RefreshCountdown(Now);
+        }
+    }
 }
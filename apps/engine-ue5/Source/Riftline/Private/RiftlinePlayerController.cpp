@@ -1,7 +1,15 @@
 #include "RiftlinePlayerController.h"
 
+#include "Riftline.h"
 #include "RiftlineGameInstance.h"
 #include "RiftlinePhoneWidget.h"
+#include "RiftlineTelemetry.h"
+
+namespace
+{
+    const FName SourceToggle(TEXT("toggle"));
+    const FName SourceMapKey(TEXT("map_key"));
+}
 
 ARiftlinePlayerController::ARiftlinePlayerController()
 {
@@ -14,6 +22,8 @@ ARiftlinePlayerController::ARiftlinePlayerController()
 
 void ARiftlinePlayerController::BeginPlay()
 {
+    LLM_SCOPE_BYTAG(Riftline_UI);
+
     Super::BeginPlay();
 
     if (!PhoneWidgetClass)
@@ -50,12 +60,12 @@ void ARiftlinePlayerController::SetupInputComponent()
 
 void ARiftlinePlayerController::TogglePhone()
 {
-    SetPhoneVisibility(!bPhoneVisible, TEXT("toggle"));
+    SetPhoneVisibility(!bPhoneVisible, SourceToggle);
 }
 
 void ARiftlinePlayerController::OpenMap()
 {
-    SetPhoneVisibility(true, TEXT("map_key"));
+    SetPhoneVisibility(true, SourceMapKey);
 
     if (PhoneWidget)
     {
@@ -81,8 +91,10 @@ void ARiftlinePlayerController::UpdateInputMode()
     }
 }
 
-void ARiftlinePlayerController::SetPhoneVisibility(bool bVisible, const FString& SourceTag)
+void ARiftlinePlayerController::SetPhoneVisibility(bool bVisible, FName SourceTag)
 {
+    RIFTLINE_SCOPE(SetPhoneVisibility);
+
     if (bPhoneVisible == bVisible)
     {
         if (PhoneWidget)
@@ -104,11 +116,11 @@ void ARiftlinePlayerController::SetPhoneVisibility(bool bVisible, const FString&
 
     if (URiftlineGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance<URiftlineGameInstance>() : nullptr)
     {
-        TMap<FString, FString> Properties;
-        if (!SourceTag.IsEmpty())
+        FRiftlineTelemetryEvent Event(bPhoneVisible ? RiftlineTelemetry::Events::PhoneOpen : RiftlineTelemetry::Events::PhoneClose);
+        if (!SourceTag.IsNone())
         {
-            Properties.Add(TEXT("source"), SourceTag);
+            Event.Add(RiftlineTelemetry::Keys::Source, SourceTag);
         }
-        GI->PushTelemetryEvent(bPhoneVisible ? TEXT("ui.phone.open") : TEXT("ui.phone.close"), Properties);
+        GI->PushTelemetry(Event);
     }
 }
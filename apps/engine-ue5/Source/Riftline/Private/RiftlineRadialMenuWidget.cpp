@@ -1,17 +1,38 @@
 #include "RiftlineRadialMenuWidget.h"
 
+#include "Riftline.h"
+
 void URiftlineRadialMenuWidget::SetEntries(const TArray<FRiftlineInteractionOption>& InEntries)
 {
+    SharedEntries.Reset();
     Entries = InEntries;
     HandleEntriesChanged();
 }
 
-void URiftlineRadialMenuWidget::ClearEntries()
+void URiftlineRadialMenuWidget::SetSharedEntries(const FRiftlineInteractionOptionsPtr& InEntries)
 {
-    Entries.Reset();
+    if (SharedEntries == InEntries && (InEntries.IsValid() || Entries.Num() == 0))
+    {
+        return;
+    }
+
+    SharedEntries = InEntries;
+    if (InEntries.IsValid())
+    {
+        Entries = *InEntries;
+    }
+    else
+    {
+        Entries.Reset();
+    }
     HandleEntriesChanged();
 }
 
+void URiftlineRadialMenuWidget::ClearEntries()
+{
+    SetSharedEntries(nullptr);
+}
+
 void URiftlineRadialMenuWidget::SelectEntryByIndex(int32 Index)
 {
     if (!Entries.IsValidIndex(Index))
@@ -19,5 +40,6 @@ void URiftlineRadialMenuWidget::SelectEntryByIndex(int32 Index)
         return;
     }
 
+    RIFTLINE_COUNTER_INC(RiftlineDelegateBroadcasts);
     OnEntrySelected.Broadcast(Entries[Index].Id);
 }
@@ -0,0 +1,326 @@
+#include "RiftlineRealtimeProtocol.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/Base64.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    TSharedPtr<FJsonObject> ParseObject(const FString& Json)
+    {
+        TSharedPtr<FJsonObject> Object;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+        return FJsonSerializer::Deserialize(Reader, Object) ? Object : nullptr;
+    }
+
+    /** The JSON socket encodes int64 fields as strings; the modules write plain numbers. Accepts either. */
+    bool TryGetInt64(const FJsonObject& Object, const TCHAR* Field, int64& Out)
+    {
+        FString Text;
+        if (Object.TryGetStringField(Field, Text))
+        {
+            return LexTryParseString(Out, *Text);
+        }
+        double Number = 0.0;
+        if (Object.TryGetNumberField(Field, Number))
+        {
+            Out = static_cast<int64>(Number);
+            return true;
+        }
+        return false;
+    }
+
+    FDateTime FromUnixMilliseconds(int64 Milliseconds)
+    {
+        return FDateTime::FromUnixTimestamp(Milliseconds / 1000) + FTimespan::FromMilliseconds(static_cast<double>(Milliseconds % 1000));
+    }
+
+    bool DecodeBase64Text(const FString& Encoded, EBase64Mode Mode, FString& Out)
+    {
+        // Token segments drop the padding the decoder expects.
+        FString Padded = Encoded;
+        while (Padded.Len() % 4 != 0)
+        {
+            Padded.AppendChar(TEXT('='));
+        }
+
+        TArray<uint8> Bytes;
+        if (!FBase64::Decode(Padded, Bytes, Mode))
+        {
+            return false;
+        }
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+        Out = FString(Converted.Length(), Converted.Get());
+        return true;
+    }
+
+    /** Wanted record as stored by the modules: level 0..4, heat 0..100, expiresAt in Unix milliseconds. */
+    void DecodeWanted(const FJsonObject& Record, FRiftlineWantedState& Out)
+    {
+        int64 Level = 0;
+        TryGetInt64(Record, TEXT("level"), Level);
+        Out.Level = static_cast<ERiftlineWantedLevel>(FMath::Clamp<int64>(Level, 0, static_cast<int64>(ERiftlineWantedLevel::Critical)));
+
+        double Heat = 0.0;
+        Record.TryGetNumberField(TEXT("heat"), Heat);
+        Out.Heat = FMath::Clamp(static_cast<float>(Heat) / 100.f, 0.f, 1.f);
+
+        int64 ExpiresAt = 0;
+        Out.ExpiresAt = TryGetInt64(Record, TEXT("expiresAt"), ExpiresAt) && ExpiresAt > 0 ? FromUnixMilliseconds(ExpiresAt) : FDateTime(0);
+    }
+
+    void DecodeCompliance(const FJsonObject& Record, FRiftlineComplianceState& Out)
+    {
+        FString Status;
+        Out.bKycVerified = Record.TryGetStringField(TEXT("kycStatus"), Status) && Status == TEXT("verified");
+        Out.bAmlClear = !Record.TryGetStringField(TEXT("amlStatus"), Status) || Status == TEXT("clear");
+        int64 RiskScore = 0;
+        TryGetInt64(Record, TEXT("riskScore"), RiskScore);
+        Out.RiskScore = static_cast<int32>(RiskScore);
+        Record.TryGetStringField(TEXT("lastCaseId"), Out.LastCaseId);
+    }
+
+    void DecodeWalletView(const FJsonObject& Record, FRiftlineWalletView& Out)
+    {
+        int64 Value = 0;
+        Record.TryGetStringField(TEXT("address"), Out.Address);
+        Out.SoftCurrency = TryGetInt64(Record, TEXT("softCurrency"), Value) ? static_cast<int32>(Value) : 0;
+        Out.WantedMinutes = TryGetInt64(Record, TEXT("wantedMinutes"), Value) ? static_cast<int32>(Value) : 0;
+        Out.ShardId = TryGetInt64(Record, TEXT("shardId"), Value) ? static_cast<int32>(Value) : INDEX_NONE;
+    }
+
+    void DecodeNotification(const FJsonObject& Notification, FRiftlineRealtimeEnvelope& Out)
+    {
+        FString Subject;
+        FString Content;
+        if (!Notification.TryGetStringField(TEXT("subject"), Subject) || !Notification.TryGetStringField(TEXT("content"), Content))
+        {
+            return;
+        }
+        const TSharedPtr<FJsonObject> Record = ParseObject(Content);
+        if (!Record.IsValid())
+        {
+            return;
+        }
+
+        FRiftlineRealtimeUpdate Update;
+        FString CreatedAt;
+        if (Notification.TryGetStringField(TEXT("create_time"), CreatedAt))
+        {
+            FDateTime::ParseIso8601(*CreatedAt, Update.CreatedAt);
+        }
+
+        if (Subject == RiftlineRealtime::Subjects::Wanted)
+        {
+            Update.Kind = ERiftlineRealtimeUpdate::Wanted;
+            DecodeWanted(*Record, Update.Wanted);
+        }
+        else if (Subject == RiftlineRealtime::Subjects::Compliance)
+        {
+            Update.Kind = ERiftlineRealtimeUpdate::Compliance;
+            DecodeCompliance(*Record, Update.Compliance);
+        }
+        else if (Subject == RiftlineRealtime::Subjects::Wallet)
+        {
+            Update.Kind = ERiftlineRealtimeUpdate::WalletView;
+            DecodeWalletView(*Record, Update.WalletView);
+        }
+        else
+        {
+            return;
+        }
+        Out.Updates.Add(MoveTemp(Update));
+    }
+
+    /** Returns how many notifications were listed, including subjects that carry no state. */
+    int32 DecodeNotifications(const FJsonObject& Container, FRiftlineRealtimeEnvelope& Out)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Notifications = nullptr;
+        if (!Container.TryGetArrayField(TEXT("notifications"), Notifications))
+        {
+            return 0;
+        }
+        for (const TSharedPtr<FJsonValue>& Value : *Notifications)
+        {
+            const TSharedPtr<FJsonObject>* Notification = nullptr;
+            if (Value.IsValid() && Value->TryGetObject(Notification))
+            {
+                DecodeNotification(**Notification, Out);
+            }
+        }
+        return Notifications->Num();
+    }
+
+    void DecodeMatchData(const FJsonObject& MatchData, FRiftlineRealtimeEnvelope& Out)
+    {
+        MatchData.TryGetStringField(TEXT("match_id"), Out.MatchId);
+
+        int64 OpCode = 0;
+        FString Data;
+        if (!TryGetInt64(MatchData, TEXT("op_code"), OpCode) || !MatchData.TryGetStringField(TEXT("data"), Data))
+        {
+            return;
+        }
+
+        FString Json;
+        if (!DecodeBase64Text(Data, EBase64Mode::Standard, Json))
+        {
+            return;
+        }
+        const TSharedPtr<FJsonObject> Payload = ParseObject(Json);
+        if (!Payload.IsValid())
+        {
+            return;
+        }
+
+        if (OpCode == RiftlineRealtime::OpCodes::WantedUpdate)
+        {
+            const TSharedPtr<FJsonObject>* Wanted = nullptr;
+            if (Payload->TryGetObjectField(TEXT("wanted"), Wanted))
+            {
+                FRiftlineRealtimeUpdate& Update = Out.Updates.AddDefaulted_GetRef();
+                Update.Kind = ERiftlineRealtimeUpdate::Wanted;
+                Payload->TryGetStringField(TEXT("userId"), Update.UserId);
+                DecodeWanted(**Wanted, Update.Wanted);
+            }
+        }
+        else if (OpCode == RiftlineRealtime::OpCodes::ShardStatus)
+        {
+            int64 Population = 0;
+            if (TryGetInt64(*Payload, TEXT("population"), Population))
+            {
+                FRiftlineRealtimeUpdate& Update = Out.Updates.AddDefaulted_GetRef();
+                Update.Kind = ERiftlineRealtimeUpdate::ShardPopulation;
+                Update.Population = static_cast<int32>(Population);
+            }
+        }
+    }
+
+    FString WriteEnvelope(const FString& Cid, const TCHAR* Field, const TSharedRef<FJsonObject>& Body)
+    {
+        const TSharedRef<FJsonObject> Envelope = MakeShared<FJsonObject>();
+        Envelope->SetStringField(TEXT("cid"), Cid);
+        Envelope->SetObjectField(Field, Body);
+
+        FString Output;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+        FJsonSerializer::Serialize(Envelope, Writer);
+        return Output;
+    }
+}
+
+namespace RiftlineRealtime
+{
+    bool DecodeEnvelope(const FString& Message, FRiftlineRealtimeEnvelope& Out)
+    {
+        const TSharedPtr<FJsonObject> Root = ParseObject(Message);
+        if (!Root.IsValid())
+        {
+            return false;
+        }
+
+        Root->TryGetStringField(TEXT("cid"), Out.Cid);
+
+        const TSharedPtr<FJsonObject>* Body = nullptr;
+        if (Root->TryGetObjectField(TEXT("match_data"), Body))
+        {
+            Out.Type = FRiftlineRealtimeEnvelope::EType::MatchData;
+            DecodeMatchData(**Body, Out);
+        }
+        else if (Root->TryGetObjectField(TEXT("notifications"), Body))
+        {
+            Out.Type = FRiftlineRealtimeEnvelope::EType::Notifications;
+            DecodeNotifications(**Body, Out);
+        }
+        else if (Root->HasField(TEXT("pong")))
+        {
+            Out.Type = FRiftlineRealtimeEnvelope::EType::Pong;
+        }
+        else if (Root->TryGetObjectField(TEXT("match"), Body))
+        {
+            Out.Type = FRiftlineRealtimeEnvelope::EType::Match;
+            (*Body)->TryGetStringField(TEXT("match_id"), Out.MatchId);
+        }
+        else if (Root->TryGetObjectField(TEXT("error"), Body))
+        {
+            Out.Type = FRiftlineRealtimeEnvelope::EType::Error;
+            (*Body)->TryGetStringField(TEXT("message"), Out.Error);
+        }
+        return true;
+    }
+
+    bool DecodeNotificationList(const FString& Body, FRiftlineRealtimeEnvelope& Out, FString& OutCursor, int32& OutListed)
+    {
+        const TSharedPtr<FJsonObject> Root = ParseObject(Body);
+        if (!Root.IsValid())
+        {
+            return false;
+        }
+
+        Out.Type = FRiftlineRealtimeEnvelope::EType::Notifications;
+        OutListed = DecodeNotifications(*Root, Out);
+        Root->TryGetStringField(TEXT("cacheable_cursor"), OutCursor);
+        return true;
+    }
+
+    bool DecodeShardMatch(const FString& Body, FString& OutMatchId)
+    {
+        const TSharedPtr<FJsonObject> Root = ParseObject(Body);
+        return Root.IsValid() && Root->TryGetStringField(TEXT("matchId"), OutMatchId) && !OutMatchId.IsEmpty();
+    }
+
+    bool DecodeSession(const FString& Body, FString& OutToken, FString& OutRefreshToken)
+    {
+        const TSharedPtr<FJsonObject> Root = ParseObject(Body);
+        if (!Root.IsValid() || !Root->TryGetStringField(TEXT("token"), OutToken) || OutToken.IsEmpty())
+        {
+            return false;
+        }
+        Root->TryGetStringField(TEXT("refresh_token"), OutRefreshToken);
+        return true;
+    }
+
+    bool ParseToken(const FString& Token, FString& OutUserId, FDateTime& OutExpiresAt)
+    {
+        TArray<FString> Segments;
+        if (Token.ParseIntoArray(Segments, TEXT("."), false) != 3)
+        {
+            return false;
+        }
+
+        FString Claims;
+        if (!DecodeBase64Text(Segments[1], EBase64Mode::UrlSafe, Claims))
+        {
+            return false;
+        }
+        const TSharedPtr<FJsonObject> Root = ParseObject(Claims);
+        int64 Expiry = 0;
+        if (!Root.IsValid() || !Root->TryGetStringField(TEXT("uid"), OutUserId) || !TryGetInt64(*Root, TEXT("exp"), Expiry))
+        {
+            return false;
+        }
+        OutExpiresAt = FDateTime::FromUnixTimestamp(Expiry);
+        return true;
+    }
+
+    FString EncodePing(const FString& Cid)
+    {
+        return WriteEnvelope(Cid, TEXT("ping"), MakeShared<FJsonObject>());
+    }
+
+    FString EncodeMatchJoin(const FString& Cid, const FString& MatchId)
+    {
+        const TSharedRef<FJsonObject> Join = MakeShared<FJsonObject>();
+        Join->SetStringField(TEXT("match_id"), MatchId);
+        return WriteEnvelope(Cid, TEXT("match_join"), Join);
+    }
+
+    FString EncodeMatchLeave(const FString& Cid, const FString& MatchId)
+    {
+        const TSharedRef<FJsonObject> Leave = MakeShared<FJsonObject>();
+        Leave->SetStringField(TEXT("match_id"), MatchId);
+        return WriteEnvelope(Cid, TEXT("match_leave"), Leave);
+    }
+}
@@ -0,0 +1,556 @@
+#include "RiftlineRealtimeSubsystem.h"
+
+#include "Engine/GameInstance.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "IWebSocket.h"
+#include "Misc/Base64.h"
+#include "Misc/CoreDelegates.h"
+#include "Riftline.h"
+#include "RiftlineGameInstance.h"
+#include "RiftlineHttpScheduler.h"
+#include "RiftlineNetworkQuality.h"
+#include "TimerManager.h"
+#include "WebSocketsModule.h"
+
+namespace
+{
+    constexpr int32 NotificationPageSize = 100;
+
+    FString TrimBaseUrl(const FString& Url)
+    {
+        FString Base = Url;
+        Base.RemoveFromEnd(TEXT("/"));
+        return Base;
+    }
+
+    /** The game instance holds Nakama's HTTP address; the socket lives on the same port. */
+    FString MakeSocketUrl(const FString& HttpUrl, const FString& Token)
+    {
+        FString Base = TrimBaseUrl(HttpUrl);
+        if (Base.StartsWith(TEXT("https://")))
+        {
+            Base = TEXT("wss://") + Base.RightChop(8);
+        }
+        else if (Base.StartsWith(TEXT("http://")))
+        {
+            Base = TEXT("ws://") + Base.RightChop(7);
+        }
+        return FString::Printf(TEXT("%s/ws?lang=en&status=false&format=json&token=%s"), *Base, *Token);
+    }
+
+    FRiftlineHttpRequest MakeNakamaRequest(const FString& BaseUrl, const FString& Path, const FString& Verb)
+    {
+        FRiftlineHttpRequest Request;
+        Request.Url = TrimBaseUrl(BaseUrl) + Path;
+        Request.Verb = Verb;
+        Request.Priority = ERiftlineHttpPriority::Gameplay;
+        Request.SetHeader(TEXT("Accept"), TEXT("application/json"));
+        return Request;
+    }
+
+    /** Completes on the game thread with the body of a 2xx response, or bSucceeded false. */
+    template <typename FuncType>
+    void SendNakamaRequest(const URiftlineGameInstance& GameInstance, FRiftlineHttpRequest&& Request, FuncType OnComplete)
+    {
+        if (const TSharedPtr<FRiftlineHttpScheduler, ESPMode::ThreadSafe> Scheduler = GameInstance.GetHttpScheduler())
+        {
+            Scheduler->Submit(MoveTemp(Request), FRiftlineHttpCompleteDelegate::CreateLambda([OnComplete = MoveTemp(OnComplete)](const FRiftlineHttpResult& Result)
+            {
+                OnComplete(Result.IsOk(), Result.IsOk() ? Result.GetContentAsString() : FString());
+            }));
+        }
+    }
+}
+
+bool URiftlineRealtimeSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    return Super::ShouldCreateSubsystem(Outer) && Cast<URiftlineGameInstance>(Outer) && !IsRunningDedicatedServer();
+}
+
+void URiftlineRealtimeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    URiftlineGameInstance* GameInstance = CastChecked<URiftlineGameInstance>(GetGameInstance());
+    SessionSubscription = GameInstance->GetSessionStore().Subscribe(
+        ERiftlineSessionField::Identity | ERiftlineSessionField::Shard,
+        FRiftlineSessionChangeDelegate::CreateUObject(this, &URiftlineRealtimeSubsystem::HandleSessionChanges));
+
+    BackgroundHandle = FCoreDelegates::ApplicationWillEnterBackgroundDelegate.AddUObject(this, &URiftlineRealtimeSubsystem::HandleEnterBackground);
+    ForegroundHandle = FCoreDelegates::ApplicationHasEnteredForegroundDelegate.AddUObject(this, &URiftlineRealtimeSubsystem::HandleEnterForeground);
+}
+
+void URiftlineRealtimeSubsystem::Deinitialize()
+{
+    Disconnect();
+
+    CastChecked<URiftlineGameInstance>(GetGameInstance())->GetSessionStore().Unsubscribe(SessionSubscription);
+    FCoreDelegates::ApplicationWillEnterBackgroundDelegate.Remove(BackgroundHandle);
+    FCoreDelegates::ApplicationHasEnteredForegroundDelegate.Remove(ForegroundHandle);
+
+    Super::Deinitialize();
+}
+
+void URiftlineRealtimeSubsystem::Connect()
+{
+    if (bWantConnection)
+    {
+        return;
+    }
+
+    bWantConnection = true;
+    Attempt = 0;
+    BeginAttempt();
+}
+
+void URiftlineRealtimeSubsystem::Disconnect()
+{
+    bWantConnection = false;
+    GetGameInstance()->GetTimerManager().ClearTimer(ReconnectTimer);
+    CloseSocket();
+    SetState(ERiftlineRealtimeState::Disconnected);
+}
+
+void URiftlineRealtimeSubsystem::JoinShardMatch(const FString& MatchId)
+{
+    ShardMatchId = MatchId;
+    if (State == ERiftlineRealtimeState::Connected && !ShardMatchId.IsEmpty())
+    {
+        Socket->Send(RiftlineRealtime::EncodeMatchJoin(NextCidString(), ShardMatchId));
+    }
+}
+
+void URiftlineRealtimeSubsystem::BeginAttempt()
+{
+    const URiftlineGameInstance* GameInstance = CastChecked<URiftlineGameInstance>(GetGameInstance());
+    if (!bWantConnection || bSuspended || GameInstance->GetNakamaUrl().IsEmpty())
+    {
+        SetState(ERiftlineRealtimeState::Disconnected);
+        return;
+    }
+
+    if (HasUsableToken())
+    {
+        OpenSocket();
+    }
+    else if (!RefreshToken.IsEmpty())
+    {
+        RefreshSession();
+    }
+    else
+    {
+        Authenticate();
+    }
+}
+
+void URiftlineRealtimeSubsystem::Authenticate()
+{
+    SetState(ERiftlineRealtimeState::Authenticating);
+
+    const URiftlineGameInstance* GameInstance = CastChecked<URiftlineGameInstance>(GetGameInstance());
+    FRiftlineHttpRequest Request = MakeNakamaRequest(GameInstance->GetNakamaUrl(), TEXT("/v2/account/authenticate/device?create=true"), TEXT("POST"));
+    Request.SetHeader(TEXT("Authorization"), TEXT("Basic ") + FBase64::Encode(GameInstance->GetNakamaServerKey() + TEXT(":")))
+        .SetHeader(TEXT("Content-Type"), TEXT("application/json"))
+        .SetContentAsString(FString::Printf(TEXT("{\"id\":\"%s\"}"), *FPlatformMisc::GetLoginId()));
+
+    const uint32 RequestGeneration = Generation;
+    SendNakamaRequest(*GameInstance, MoveTemp(Request), [WeakThis = TWeakObjectPtr<URiftlineRealtimeSubsystem>(this), RequestGeneration](bool bSucceeded, const FString& Body)
+    {
+        if (WeakThis.IsValid())
+        {
+            WeakThis->HandleSessionResponse(bSucceeded, Body, RequestGeneration);
+        }
+    });
+}
+
+void URiftlineRealtimeSubsystem::RefreshSession()
+{
+    SetState(ERiftlineRealtimeState::Authenticating);
+
+    const URiftlineGameInstance* GameInstance = CastChecked<URiftlineGameInstance>(GetGameInstance());
+    FRiftlineHttpRequest Request = MakeNakamaRequest(GameInstance->GetNakamaUrl(), TEXT("/v2/account/session/refresh"), TEXT("POST"));
+    Request.SetHeader(TEXT("Authorization"), TEXT("Basic ") + FBase64::Encode(GameInstance->GetNakamaServerKey() + TEXT(":")))
+        .SetHeader(TEXT("Content-Type"), TEXT("application/json"))
+        .SetContentAsString(FString::Printf(TEXT("{\"token\":\"%s\"}"), *RefreshToken));
+
+    const uint32 RequestGeneration = Generation;
+    SendNakamaRequest(*GameInstance, MoveTemp(Request), [WeakThis = TWeakObjectPtr<URiftlineRealtimeSubsystem>(this), RequestGeneration](bool bSucceeded, const FString& Body)
+    {
+        if (WeakThis.IsValid())
+        {
+            WeakThis->HandleSessionResponse(bSucceeded, Body, RequestGeneration);
+        }
+    });
+}
+
+void URiftlineRealtimeSubsystem::HandleSessionResponse(bool bSucceeded, const FString& Body, uint32 RequestGeneration)
+{
+    if (RequestGeneration != Generation || !bWantConnection)
+    {
+        return;
+    }
+
+    if (!bSucceeded
+        || !RiftlineRealtime::DecodeSession(Body, Token, RefreshToken)
+        || !RiftlineRealtime::ParseToken(Token, UserId, TokenExpiresAt))
+    {
+        // A rejected refresh token falls back to device authentication on the next attempt.
+        UE_LOG(LogRiftline, Warning, TEXT("Nakama authentication failed; retrying"));
+        Token.Reset();
+        RefreshToken.Reset();
+        ScheduleReconnect();
+        return;
+    }
+
+    OpenSocket();
+}
+
+void URiftlineRealtimeSubsystem::OpenSocket()
+{
+    LLM_SCOPE_BYTAG(Riftline_Network);
+
+    SetState(ERiftlineRealtimeState::Connecting);
+
+    const URiftlineGameInstance* GameInstance = CastChecked<URiftlineGameInstance>(GetGameInstance());
+    Socket = FWebSocketsModule::Get().CreateWebSocket(MakeSocketUrl(GameInstance->GetNakamaUrl(), Token));
+
+    const uint32 SocketGeneration = Generation;
+    Socket->OnConnected().AddUObject(this, &URiftlineRealtimeSubsystem::HandleConnected, SocketGeneration);
+    Socket->OnConnectionError().AddUObject(this, &URiftlineRealtimeSubsystem::HandleConnectionError, SocketGeneration);
+    Socket->OnClosed().AddUObject(this, &URiftlineRealtimeSubsystem::HandleClosed, SocketGeneration);
+    Socket->OnMessage().AddUObject(this, &URiftlineRealtimeSubsystem::HandleMessage, SocketGeneration);
+    Socket->Connect();
+}
+
+void URiftlineRealtimeSubsystem::CloseSocket()
+{
+    // Callbacks still queued for this socket carry the old generation and are dropped.
+    ++Generation;
+    bAwaitingPong = false;
+    GetGameInstance()->GetTimerManager().ClearTimer(PingTimer);
+
+    if (Socket.IsValid())
+    {
+        Socket->Close();
+        Socket.Reset();
+    }
+}
+
+void URiftlineRealtimeSubsystem::ScheduleReconnect()
+{
+    if (!bWantConnection || bSuspended)
+    {
+        SetState(ERiftlineRealtimeState::Disconnected);
+        return;
+    }
+
+    const float Delay = RiftlineHttp::ComputeBackoff(Attempt++, BaseReconnectDelay, MaxReconnectDelay, FMath::FRand());
+    SetState(ERiftlineRealtimeState::WaitingToReconnect);
+    GetGameInstance()->GetTimerManager().SetTimer(ReconnectTimer, this, &URiftlineRealtimeSubsystem::BeginAttempt, Delay, false);
+    UE_LOG(LogRiftline, Log, TEXT("Nakama socket reconnecting in %.1fs (attempt %d)"), Delay, Attempt);
+}
+
+void URiftlineRealtimeSubsystem::SendPing()
+{
+    if (bAwaitingPong)
+    {
+        UE_LOG(LogRiftline, Warning, TEXT("Nakama socket stopped answering pings; reconnecting"));
+        CloseSocket();
+        ScheduleReconnect();
+        return;
+    }
+
+    bAwaitingPong = true;
+    Socket->Send(RiftlineRealtime::EncodePing(NextCidString()));
+}
+
+void URiftlineRealtimeSubsystem::FetchMissedNotifications()
+{
+    PendingNotifications.Updates.Reset();
+    FetchNotificationPage(NotificationCursor);
+}
+
+void URiftlineRealtimeSubsystem::FetchNotificationPage(const FString& Cursor)
+{
+    const URiftlineGameInstance* GameInstance = CastChecked<URiftlineGameInstance>(GetGameInstance());
+    FString Path = FString::Printf(TEXT("/v2/notification?limit=%d"), NotificationPageSize);
+    if (!Cursor.IsEmpty())
+    {
+        Path += TEXT("&cacheable_cursor=") + FGenericPlatformHttp::UrlEncode(Cursor);
+    }
+
+    // The listing is idempotent, so unlike authentication (which the reconnect loop retries) it may retry in place.
+    FRiftlineHttpRequest Request = MakeNakamaRequest(GameInstance->GetNakamaUrl(), Path, TEXT("GET"));
+    Request.SetHeader(TEXT("Authorization"), TEXT("Bearer ") + Token);
+    Request.MaxAttempts = 3;
+
+    const uint32 RequestGeneration = Generation;
+    SendNakamaRequest(*GameInstance, MoveTemp(Request), [WeakThis = TWeakObjectPtr<URiftlineRealtimeSubsystem>(this), RequestGeneration, Cursor](bool bSucceeded, const FString& Body)
+    {
+        URiftlineRealtimeSubsystem* Self = WeakThis.Get();
+        if (!Self || RequestGeneration != Self->Generation)
+        {
+            return;
+        }
+
+        FRiftlineRealtimeEnvelope Page;
+        FString NextCursor;
+        int32 Listed = 0;
+        FString Reached = Cursor;
+        if (bSucceeded && RiftlineRealtime::DecodeNotificationList(Body, Page, NextCursor, Listed))
+        {
+            Self->PendingNotifications.Updates.Append(MoveTemp(Page.Updates));
+            if (!NextCursor.IsEmpty())
+            {
+                if (Listed == NotificationPageSize && NextCursor != Cursor)
+                {
+                    Self->FetchNotificationPage(NextCursor);
+                    return;
+                }
+                Reached = NextCursor;
+            }
+        }
+
+        // The listing runs oldest first, so applying it only once it ends keeps older pages from briefly replacing
+        // newer state, and the cursor only moves past what has been applied.
+        Self->NotificationCursor = Reached;
+        Self->ApplyEnvelope(Self->PendingNotifications);
+        Self->PendingNotifications.Updates.Reset();
+    });
+}
+
+void URiftlineRealtimeSubsystem::ResolveShardMatch()
+{
+    if (State != ERiftlineRealtimeState::Connected || SessionShardId == INDEX_NONE)
+    {
+        return;
+    }
+
+    const URiftlineGameInstance* GameInstance = CastChecked<URiftlineGameInstance>(GetGameInstance());
+    FRiftlineHttpRequest Request = MakeNakamaRequest(
+        GameInstance->GetNakamaUrl(), FString::Printf(TEXT("/v2/rpc/%s?unwrap=true"), RiftlineRealtime::Rpcs::ShardMatch), TEXT("POST"));
+    Request.SetHeader(TEXT("Authorization"), TEXT("Bearer ") + Token)
+        .SetHeader(TEXT("Content-Type"), TEXT("application/json"))
+        .SetContentAsString(FString::Printf(TEXT("{\"shardId\":%d}"), SessionShardId));
+    Request.MaxAttempts = 3;
+
+    const uint32 RequestGeneration = Generation;
+    const int32 RequestShardId = SessionShardId;
+    SendNakamaRequest(*GameInstance, MoveTemp(Request), [WeakThis = TWeakObjectPtr<URiftlineRealtimeSubsystem>(this), RequestGeneration, RequestShardId](bool bSucceeded, const FString& Body)
+    {
+        URiftlineRealtimeSubsystem* Self = WeakThis.Get();
+        if (!Self || RequestGeneration != Self->Generation || RequestShardId != Self->SessionShardId)
+        {
+            return;
+        }
+
+        // Left unjoined, the next reconnect asks again.
+        FString MatchId;
+        if (!bSucceeded || !RiftlineRealtime::DecodeShardMatch(Body, MatchId))
+        {
+            UE_LOG(LogRiftline, Warning, TEXT("Could not resolve the match of shard %d"), RequestShardId);
+            return;
+        }
+        Self->JoinShardMatch(MatchId);
+    });
+}
+
+void URiftlineRealtimeSubsystem::LeaveShardMatch()
+{
+    if (State == ERiftlineRealtimeState::Connected && !ShardMatchId.IsEmpty())
+    {
+        Socket->Send(RiftlineRealtime::EncodeMatchLeave(NextCidString(), ShardMatchId));
+    }
+    ShardMatchId.Reset();
+}
+
+void URiftlineRealtimeSubsystem::HandleConnected(uint32 SocketGeneration)
+{
+    if (SocketGeneration != Generation)
+    {
+        return;
+    }
+
+    UE_LOG(LogRiftline, Log, TEXT("Nakama socket connected"));
+    Attempt = 0;
+    SetState(ERiftlineRealtimeState::Connected);
+    GetGameInstance()->GetTimerManager().SetTimer(PingTimer, this, &URiftlineRealtimeSubsystem::SendPing, PingInterval, true);
+
+    // Resume: rejoin the shard match and pick up whatever was pushed while the socket was down.
+    if (!ShardMatchId.IsEmpty())
+    {
+        Socket->Send(RiftlineRealtime::EncodeMatchJoin(NextCidString(), ShardMatchId));
+    }
+    else
+    {
+        ResolveShardMatch();
+    }
+    FetchMissedNotifications();
+}
+
+void URiftlineRealtimeSubsystem::HandleConnectionError(const FString& Error, uint32 SocketGeneration)
+{
+    if (SocketGeneration != Generation)
+    {
+        return;
+    }
+
+    // The upgrade may have been refused for the token itself, so the next attempt authenticates afresh.
+    UE_LOG(LogRiftline, Warning, TEXT("Nakama socket failed to connect: %s"), *Error);
+    Token.Reset();
+    CloseSocket();
+    ScheduleReconnect();
+}
+
+void URiftlineRealtimeSubsystem::HandleClosed(int32 StatusCode, const FString& Reason, bool bWasClean, uint32 SocketGeneration)
+{
+    if (SocketGeneration != Generation)
+    {
+        return;
+    }
+
+    UE_LOG(LogRiftline, Log, TEXT("Nakama socket closed (%d %s)"), StatusCode, *Reason);
+    CloseSocket();
+    ScheduleReconnect();
+}
+
+void URiftlineRealtimeSubsystem::HandleMessage(const FString& Message, uint32 SocketGeneration)
+{
+    if (SocketGeneration != Generation)
+    {
+        return;
+    }
+
+    RIFTLINE_SCOPE(RealtimeMessage);
+
+    // Any traffic proves the connection is alive.
+    bAwaitingPong = false;
+
+    FRiftlineRealtimeEnvelope Envelope;
+    if (!RiftlineRealtime::DecodeEnvelope(Message, Envelope))
+    {
+        UE_LOG(LogRiftline, Verbose, TEXT("Ignoring malformed Nakama message"));
+        return;
+    }
+
+    if (Envelope.Type == FRiftlineRealtimeEnvelope::EType::Error)
+    {
+        UE_LOG(LogRiftline, Warning, TEXT("Nakama socket error: %s"), *Envelope.Error);
+        return;
+    }
+    ApplyEnvelope(Envelope);
+}
+
+void URiftlineRealtimeSubsystem::ApplyEnvelope(const FRiftlineRealtimeEnvelope& Envelope)
+{
+    URiftlineGameInstance* GameInstance = CastChecked<URiftlineGameInstance>(GetGameInstance());
+    for (const FRiftlineRealtimeUpdate& Update : Envelope.Updates)
+    {
+        // The shard match broadcasts every player's escalations; only ours changes the session.
+        if (Update.Kind == ERiftlineRealtimeUpdate::Wanted && !Update.UserId.IsEmpty() && Update.UserId != UserId)
+        {
+            continue;
+        }
+
+        // Match data is current as it arrives, so it stamps the state as of now and a notification listed later that
+        // predates it is skipped instead of rolling it back.
+        const FDateTime Stamp = Update.CreatedAt.GetTicks() != 0 ? Update.CreatedAt : RiftlineNetwork::GetServerNow();
+        FDateTime& Applied = LastApplied[static_cast<int32>(Update.Kind)];
+        if (Stamp < Applied)
+        {
+            continue;
+        }
+        Applied = Stamp;
+
+        switch (Update.Kind)
+        {
+        case ERiftlineRealtimeUpdate::Wanted:
+            GameInstance->ApplyWantedState(Update.Wanted);
+            break;
+        case ERiftlineRealtimeUpdate::Compliance:
+            GameInstance->UpdateCompliance(Update.Compliance);
+            break;
+        case ERiftlineRealtimeUpdate::ShardPopulation:
+        {
+            FRiftlineShardStatus Shard = GameInstance->GetSessionProfile().CurrentShard;
+            Shard.Population = Update.Population;
+            GameInstance->UpdateShardStatus(Shard);
+            break;
+        }
+        case ERiftlineRealtimeUpdate::WalletView:
+            GameInstance->UpdateWalletView(Update.WalletView);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void URiftlineRealtimeSubsystem::HandleSessionChanges(const FRiftlineSessionStore& Store, ERiftlineSessionField Changed)
+{
+    const FRiftlineSessionProfile& Profile = Store.GetProfile();
+    if (Profile.PlayerId != SessionPlayerId)
+    {
+        // Nothing of the previous player's connection carries over: not the socket session, nor the listing position,
+        // nor the state it applied.
+        Disconnect();
+        SessionPlayerId = Profile.PlayerId;
+        Token.Reset();
+        RefreshToken.Reset();
+        UserId.Reset();
+        TokenExpiresAt = FDateTime(0);
+        NotificationCursor.Reset();
+        for (FDateTime& Applied : LastApplied)
+        {
+            Applied = FDateTime(0);
+        }
+        ShardMatchId.Reset();
+        SessionShardId = INDEX_NONE;
+    }
+
+    if (SessionPlayerId.IsEmpty())
+    {
+        Disconnect();
+        return;
+    }
+
+    if (Profile.CurrentShard.ShardId != SessionShardId)
+    {
+        LeaveShardMatch();
+        SessionShardId = Profile.CurrentShard.ShardId;
+        ResolveShardMatch();
+    }
+    Connect();
+}
+
+void URiftlineRealtimeSubsystem::HandleEnterBackground()
+{
+    bSuspended = true;
+    GetGameInstance()->GetTimerManager().ClearTimer(ReconnectTimer);
+    CloseSocket();
+    SetState(ERiftlineRealtimeState::Disconnected);
+}
+
+void URiftlineRealtimeSubsystem::HandleEnterForeground()
+{
+    bSuspended = false;
+    if (bWantConnection)
+    {
+        Attempt = 0;
+        BeginAttempt();
+    }
+}
+
+void URiftlineRealtimeSubsystem::SetState(ERiftlineRealtimeState NewState)
+{
+    if (State != NewState)
+    {
+        State = NewState;
+        OnStateChanged.Broadcast(State);
+    }
+}
+
+bool URiftlineRealtimeSubsystem::HasUsableToken() const
+{
+    return !Token.IsEmpty() && TokenExpiresAt - RiftlineNetwork::GetServerNow() > FTimespan::FromSeconds(TokenRefreshMargin);
+}
@@ -0,0 +1,128 @@
+#include "RiftlineScalabilityGovernor.h"
+
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Riftline.h"
+#include "RiftlinePerformanceMonitor.h"
+#include "Scalability.h"
+
+namespace
+{
+    constexpr float PressureBudgetRatio = 1.1f;
+    constexpr float HeadroomBudgetRatio = 0.85f;
+    constexpr float PressureHitchRatio = 0.02f;
+
+    float BudgetMs(const FRiftlineGovernorStep& Step)
+    {
+        return 1000.f / FMath::Max(Step.MaxFps, 1.f);
+    }
+
+    /** The frame-rate cap pads wall frame time, so headroom is judged on the busiest thread's own cost. */
+    float WorkloadP90Ms(const FRiftlineFrameTimeSummary& Frames)
+    {
+        const float Workload = FMath::Max3(
+            Frames[ERiftlineFrameTimer::GameThread].P90Ms,
+            Frames[ERiftlineFrameTimer::RenderThread].P90Ms,
+            Frames[ERiftlineFrameTimer::GPU].P90Ms);
+        return Workload > 0.f ? Workload : Frames[ERiftlineFrameTimer::Frame].P90Ms;
+    }
+}
+
+FRiftlineScalabilityGovernor::FRiftlineScalabilityGovernor(const TArray<FRiftlineGovernorStep>& InSteps, int32 InDownWindows, int32 InUpWindows)
+    : Steps(InSteps)
+    , DownWindows(FMath::Max(InDownWindows, 1))
+    , UpWindows(FMath::Max(InUpWindows, 1))
+{
+    if (Steps.Num() == 0)
+    {
+        Steps.AddDefaulted();
+    }
+}
+
+void FRiftlineScalabilityGovernor::Start()
+{
+    // The weakest group decides: a profile that lowered any of them has judged the device unable to carry more.
+    ApplyStep(FindStartStep(Steps, Scalability::GetQualityLevels().GetMinQualityLevel()));
+}
+
+int32 FRiftlineScalabilityGovernor::FindStartStep(const TArray<FRiftlineGovernorStep>& Steps, int32 QualityLevel)
+{
+    for (int32 Index = 0; Index < Steps.Num(); ++Index)
+    {
+        if (Steps[Index].ScalabilityLevel <= QualityLevel)
+        {
+            return Index;
+        }
+    }
+    return FMath::Max(Steps.Num() - 1, 0);
+}
+
+ERiftlineGovernorReason FRiftlineScalabilityGovernor::Evaluate(const FRiftlineDeviceState& Device, const FRiftlineFrameTimeSummary& Frames)
+{
+    const int32 LastStep = Steps.Num() - 1;
+
+    if (Device.Thermal == ERiftlineThermalState::Critical && CurrentStep < LastStep)
+    {
+        ApplyStep(LastStep);
+        return ERiftlineGovernorReason::Thermal;
+    }
+
+    const bool bThermalPressure = Device.Thermal >= ERiftlineThermalState::Serious;
+    const bool bFramePressure = Frames[ERiftlineFrameTimer::Frame].P90Ms > BudgetMs(Steps[CurrentStep]) * PressureBudgetRatio
+        || Frames.Hitches > Frames.Frames * PressureHitchRatio;
+
+    if (bThermalPressure || bFramePressure)
+    {
+        HeadroomStreak = 0;
+        if (++PressureStreak >= DownWindows && CurrentStep < LastStep)
+        {
+            ApplyStep(CurrentStep + 1);
+            return bThermalPressure ? ERiftlineGovernorReason::Thermal : ERiftlineGovernorReason::FrameTime;
+        }
+        return ERiftlineGovernorReason::None;
+    }
+
+    PressureStreak = 0;
+
+    // A device that is still warm keeps its current rung rather than heating back up.
+    const bool bThermalHeadroom = Device.Thermal <= ERiftlineThermalState::Nominal;
+    if (CurrentStep > 0 && bThermalHeadroom && WorkloadP90Ms(Frames) < BudgetMs(Steps[CurrentStep - 1]) * HeadroomBudgetRatio)
+    {
+        if (++HeadroomStreak >= UpWindows)
+        {
+            ApplyStep(CurrentStep - 1);
+            return ERiftlineGovernorReason::Headroom;
+        }
+    }
+    else
+    {
+        HeadroomStreak = 0;
+    }
+    return ERiftlineGovernorReason::None;
+}
+
+void FRiftlineScalabilityGovernor::ApplyStep(int32 Step)
+{
+    CurrentStep = FMath::Clamp(Step, 0, Steps.Num() - 1);
+    PressureStreak = 0;
+    HeadroomStreak = 0;
+
+    const FRiftlineGovernorStep& Target = Steps[CurrentStep];
+
+    Scalability::FQualityLevels Levels = Scalability::GetQualityLevels();
+    Levels.SetFromSingleQualityLevel(Target.ScalabilityLevel);
+    Scalability::SetQualityLevels(Levels);
+
+    if (GEngine)
+    {
+        GEngine->SetMaxFPS(Target.MaxFps);
+    }
+
+    if (IConsoleVariable* ScreenPercentage = IConsoleManager::Get().FindConsoleVariable(TEXT("r.ScreenPercentage")))
+    {
+        ScreenPercentage->Set(Target.ScreenPercentage, ECVF_SetByCode);
+    }
+
+    UE_LOG(LogRiftline, Log, TEXT("Scalability governor at step %d (quality %d, %.0f fps, %.0f%%)"),
+        CurrentStep, Target.ScalabilityLevel, Target.MaxFps, Target.ScreenPercentage);
+}
@@ -0,0 +1,223 @@
+#include "RiftlineSessionStore.h"
+
+#include "Misc/CoreDelegates.h"
+#include "Riftline.h"
+
+namespace
+{
+    bool SameMissions(const TArray<FText>& A, const TArray<FText>& B)
+    {
+        if (A.Num() != B.Num())
+        {
+            return false;
+        }
+        for (int32 Index = 0; Index < A.Num(); ++Index)
+        {
+            if (!A[Index].IdenticalTo(B[Index]) && !A[Index].ToString().Equals(B[Index].ToString(), ESearchCase::CaseSensitive))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+FRiftlineSessionStore::~FRiftlineSessionStore()
+{
+    Stop();
+}
+
+void FRiftlineSessionStore::Start()
+{
+    Stop();
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FRiftlineSessionStore::HandleEndFrame);
+}
+
+void FRiftlineSessionStore::Stop()
+{
+    if (EndFrameHandle.IsValid())
+    {
+        FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+        EndFrameHandle.Reset();
+    }
+}
+
+void FRiftlineSessionStore::SetProfile(const FRiftlineSessionProfile& NewProfile)
+{
+    ERiftlineSessionField Changed = ERiftlineSessionField::None;
+    if (!Profile.PlayerId.Equals(NewProfile.PlayerId, ESearchCase::CaseSensitive)
+        || !Profile.DisplayName.Equals(NewProfile.DisplayName, ESearchCase::CaseSensitive))
+    {
+        Changed |= ERiftlineSessionField::Identity;
+    }
+    if (!Profile.Wallet.Equals(NewProfile.Wallet, ESearchCase::CaseSensitive))
+    {
+        Changed |= ERiftlineSessionField::Wallet;
+    }
+    if (!(Profile.CurrentShard == NewProfile.CurrentShard))
+    {
+        Changed |= ERiftlineSessionField::Shard;
+    }
+    if (!(Profile.Wanted == NewProfile.Wanted))
+    {
+        Changed |= ERiftlineSessionField::Wanted;
+    }
+    if (!(Profile.Compliance == NewProfile.Compliance))
+    {
+        Changed |= ERiftlineSessionField::Compliance;
+    }
+
+    if (Changed != ERiftlineSessionField::None)
+    {
+        Profile = NewProfile;
+        MarkChanged(Changed);
+    }
+}
+
+void FRiftlineSessionStore::SetShard(const FRiftlineShardStatus& Shard)
+{
+    if (!(Profile.CurrentShard == Shard))
+    {
+        Profile.CurrentShard = Shard;
+        MarkChanged(ERiftlineSessionField::Shard);
+    }
+}
+
+void FRiftlineSessionStore::SetWanted(const FRiftlineWantedState& Wanted)
+{
+    if (!(Profile.Wanted == Wanted))
+    {
+        Profile.Wanted = Wanted;
+        MarkChanged(ERiftlineSessionField::Wanted);
+    }
+}
+
+void FRiftlineSessionStore::SetCompliance(const FRiftlineComplianceState& Compliance)
+{
+    if (!(Profile.Compliance == Compliance))
+    {
+        Profile.Compliance = Compliance;
+        MarkChanged(ERiftlineSessionField::Compliance);
+    }
+}
+
+void FRiftlineSessionStore::SetWalletView(const FRiftlineWalletView& NewWalletView)
+{
+    if (!(WalletView == NewWalletView))
+    {
+        WalletView = NewWalletView;
+        MarkChanged(ERiftlineSessionField::WalletView);
+    }
+}
+
+void FRiftlineSessionStore::SetMissions(const TArray<FText>& NewMissions)
+{
+    if (!SameMissions(Missions, NewMissions))
+    {
+        Missions = NewMissions;
+        MarkChanged(ERiftlineSessionField::Missions);
+    }
+}
+
+uint32 FRiftlineSessionStore::GetVersion(ERiftlineSessionField Field) const
+{
+    check(FMath::IsPowerOfTwo(static_cast<uint32>(Field)));
+    return Versions[FMath::CountTrailingZeros(static_cast<uint32>(Field))];
+}
+
+FDelegateHandle FRiftlineSessionStore::Subscribe(ERiftlineSessionField Fields, FRiftlineSessionChangeDelegate Delegate)
+{
+    FSubscriber& Subscriber = (bDispatching ? AddedDuringDispatch : Subscribers).AddDefaulted_GetRef();
+    Subscriber.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+    Subscriber.Fields = Fields;
+    Subscriber.Delegate = MoveTemp(Delegate);
+    return Subscriber.Handle;
+}
+
+void FRiftlineSessionStore::Unsubscribe(FDelegateHandle Handle)
+{
+    for (int32 Index = 0; Index < Subscribers.Num(); ++Index)
+    {
+        if (Subscribers[Index].Handle == Handle)
+        {
+            // Removal waits for the dispatch loop to finish so indices stay valid while it runs.
+            if (bDispatching)
+            {
+                Subscribers[Index].Fields = ERiftlineSessionField::None;
+                Subscribers[Index].Delegate.Unbind();
+            }
+            else
+            {
+                Subscribers.RemoveAt(Index);
+            }
+            return;
+        }
+    }
+    AddedDuringDispatch.RemoveAll([Handle](const FSubscriber& Subscriber)
+    {
+        return Subscriber.Handle == Handle;
+    });
+}
+
+void FRiftlineSessionStore::Flush()
+{
+    if (Pending == ERiftlineSessionField::None || bDispatching)
+    {
+        return;
+    }
+
+    RIFTLINE_SCOPE(SessionStoreFlush);
+
+    {
+        TGuardValue<bool> DispatchGuard(bDispatching, true);
+        const ERiftlineSessionField Changed = Pending;
+        Pending = ERiftlineSessionField::None;
+
+        for (int32 Index = 0; Index < Subscribers.Num(); ++Index)
+        {
+            const ERiftlineSessionField Relevant = Subscribers[Index].Fields & Changed;
+            if (Relevant != ERiftlineSessionField::None && Subscribers[Index].Delegate.IsBound())
+            {
+                RIFTLINE_COUNTER_INC(RiftlineDelegateBroadcasts);
+                Subscribers[Index].Delegate.Execute(*this, Relevant);
+            }
+        }
+    }
+
+    Subscribers.RemoveAll([](const FSubscriber& Subscriber)
+    {
+        return !Subscriber.Delegate.IsBound();
+    });
+
+    // Subscribers added by a callback only hear about the next change.
+    Subscribers.Append(MoveTemp(AddedDuringDispatch));
+    AddedDuringDispatch.Reset();
+
+    // Writes made by subscribers go out with the next frame, or straight away when nothing drives the frame.
+    if (!EndFrameHandle.IsValid())
+    {
+        Flush();
+    }
+}
+
+void FRiftlineSessionStore::MarkChanged(ERiftlineSessionField Fields)
+{
+    for (int32 Bit = 0; Bit < NumFields; ++Bit)
+    {
+        if (EnumHasAnyFlags(Fields, static_cast<ERiftlineSessionField>(1 << Bit)))
+        {
+            ++Versions[Bit];
+        }
+    }
+    Pending |= Fields;
+
+    if (!EndFrameHandle.IsValid())
+    {
+        Flush();
+    }
+}
+
+void FRiftlineSessionStore::HandleEndFrame()
+{
+    Flush();
+}
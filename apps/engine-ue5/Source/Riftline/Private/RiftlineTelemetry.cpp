@@ -0,0 +1,413 @@
+#include "RiftlineTelemetry.h"
+
+#include "Misc/ScopeLock.h"
+#include "Riftline.h"
+#include "RiftlineDeviceState.h"
+#include "RiftlineTypes.h"
+
+namespace RiftlineTelemetry
+{
+    namespace Events
+    {
+        const FName RadialSelect(TEXT("ui.radial.select"));
+        const FName PhoneOpen(TEXT("ui.phone.open"));
+        const FName PhoneClose(TEXT("ui.phone.close"));
+        const FName PhoneTab(TEXT("ui.phone.tab"));
+        const FName MarketView(TEXT("market.view"));
+        const FName MarketList(TEXT("market.list"));
+        const FName WalletLogin(TEXT("wallet.login"));
+        const FName WantedState(TEXT("wanted_state"));
+        const FName ClientFrameTime(TEXT("client.frametime"));
+        const FName ClientThreadTime(TEXT("client.threadtime"));
+        const FName ClientHitch(TEXT("client.hitch"));
+        const FName ClientGovernor(TEXT("client.governor"));
+        const FName ClientThermal(TEXT("client.thermal"));
+        const FName ClientHttp(TEXT("client.http"));
+        const FName ClientNet(TEXT("client.net"));
+        const FName Rollup(TEXT("telemetry.rollup"));
+    }
+
+    namespace Keys
+    {
+        const FName Option(TEXT("option"));
+        const FName Source(TEXT("source"));
+        const FName Tab(TEXT("tab"));
+        const FName Items(TEXT("items"));
+        const FName Count(TEXT("count"));
+        const FName Address(TEXT("address"));
+        const FName Level(TEXT("level"));
+        const FName Expires(TEXT("expires"));
+        const FName Heat(TEXT("heat"));
+        const FName Avg(TEXT("avg"));
+        const FName P50(TEXT("p50"));
+        const FName P90(TEXT("p90"));
+        const FName P99(TEXT("p99"));
+        const FName Frames(TEXT("frames"));
+        const FName Hitches(TEXT("hitches"));
+        const FName Thread(TEXT("thread"));
+        const FName Frame(TEXT("frame"));
+        const FName Game(TEXT("game"));
+        const FName Render(TEXT("render"));
+        const FName Rhi(TEXT("rhi"));
+        const FName Gpu(TEXT("gpu"));
+        const FName Phone(TEXT("phone"));
+        const FName Shard(TEXT("shard"));
+        const FName Wanted(TEXT("wanted"));
+        const FName Interaction(TEXT("interaction"));
+        const FName Battery(TEXT("battery"));
+        const FName OnBattery(TEXT("onBattery"));
+        const FName Step(TEXT("step"));
+        const FName Reason(TEXT("reason"));
+        const FName State(TEXT("state"));
+        const FName Platform(TEXT("platform"));
+        const FName Event(TEXT("event"));
+        const FName Value(TEXT("value"));
+        const FName Suppressed(TEXT("suppressed"));
+        const FName Sum(TEXT("sum"));
+        const FName Min(TEXT("min"));
+        const FName Max(TEXT("max"));
+        const FName Priority(TEXT("priority"));
+        const FName Retries(TEXT("retries"));
+        const FName Failures(TEXT("failures"));
+        const FName Coalesced(TEXT("coalesced"));
+        const FName Host(TEXT("host"));
+        const FName P95(TEXT("p95"));
+        const FName Offset(TEXT("offset"));
+        const FName OffsetError(TEXT("offsetError"));
+    }
+
+    namespace Values
+    {
+        const FName None(TEXT("none"));
+        const FName Thermal(TEXT("thermal"));
+        const FName FrameTime(TEXT("frametime"));
+        const FName Headroom(TEXT("headroom"));
+        const FName Idle(TEXT("idle"));
+        const FName Targeting(TEXT("targeting"));
+    }
+}
+
+namespace
+{
+    void AppendEscapedName(FString& Out, FName Name)
+    {
+        TStringBuilder<FName::StringBufferSize> Buffer;
+        Name.AppendString(Buffer);
+        RiftlineTelemetry::AppendJsonEscaped(Out, Buffer.ToView());
+    }
+}
+
+bool RiftlineTelemetry::AddParsed(FRiftlineTelemetryEvent& Event, const FRiftlineTelemetrySchema& Schema, FName Key, const FString& Text)
+{
+    const TPair<FName, ERiftlineTelemetryValueType>* Field = Schema.Fields.FindByPredicate(
+        [Key](const TPair<FName, ERiftlineTelemetryValueType>& Entry) { return Entry.Key == Key; });
+    if (!Field)
+    {
+        return false;
+    }
+
+    switch (Field->Value)
+    {
+    case ERiftlineTelemetryValueType::Int:
+    {
+        int64 Value = 0;
+        if (!Text.IsNumeric() || Text.Contains(TEXT(".")) || !LexTryParseString(Value, *Text))
+        {
+            return false;
+        }
+        Event.Add(Key, Value);
+        return true;
+    }
+    case ERiftlineTelemetryValueType::Float:
+    {
+        double Value = 0.0;
+        if (!LexTryParseString(Value, *Text) || !FMath::IsFinite(Value))
+        {
+            return false;
+        }
+        Event.Add(Key, Value);
+        return true;
+    }
+    case ERiftlineTelemetryValueType::Bool:
+        if (Text.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Text == TEXT("1"))
+        {
+            Event.Add(Key, true);
+            return true;
+        }
+        if (Text.Equals(TEXT("false"), ESearchCase::IgnoreCase) || Text == TEXT("0"))
+        {
+            Event.Add(Key, false);
+            return true;
+        }
+        return false;
+    case ERiftlineTelemetryValueType::Name:
+        Event.Add(Key, FName(*Text));
+        return true;
+    case ERiftlineTelemetryValueType::Enum:
+    {
+        const UEnum* const* EnumType = Schema.EnumTypes.Find(Key);
+        const int64 Value = EnumType && *EnumType ? (*EnumType)->GetValueByNameString(Text) : INDEX_NONE;
+        if (Value == INDEX_NONE)
+        {
+            return false;
+        }
+        Event.AddEnum(Key, *EnumType, Value);
+        return true;
+    }
+    case ERiftlineTelemetryValueType::String:
+        Event.AddString(Key, Text);
+        return true;
+    default:
+        return false;
+    }
+}
+
+void RiftlineTelemetry::AppendJsonEscaped(FString& Out, FStringView Value)
+{
+    for (const TCHAR Char : Value)
+    {
+        switch (Char)
+        {
+        case TEXT('"'):  Out += TEXT("\\\""); break;
+        case TEXT('\\'): Out += TEXT("\\\\"); break;
+        case TEXT('\n'): Out += TEXT("\\n"); break;
+        case TEXT('\r'): Out += TEXT("\\r"); break;
+        case TEXT('\t'): Out += TEXT("\\t"); break;
+        default:
+            if (Char < 0x20)
+            {
+                Out.Appendf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+            }
+            else
+            {
+                Out.AppendChar(Char);
+            }
+            break;
+        }
+    }
+}
+
+FRiftlineTelemetryEvent& FRiftlineTelemetryEvent::Add(FName Key, bool bValue)
+{
+    AddField(Key, ERiftlineTelemetryValueType::Bool).bBoolValue = bValue;
+    return *this;
+}
+
+FRiftlineTelemetryEvent& FRiftlineTelemetryEvent::Add(FName Key, FName Value)
+{
+    AddField(Key, ERiftlineTelemetryValueType::Name).NameValue = Value;
+    return *this;
+}
+
+FRiftlineTelemetryEvent& FRiftlineTelemetryEvent::AddString(FName Key, const FString& Value)
+{
+    AddField(Key, ERiftlineTelemetryValueType::String).StringValue = Value;
+    return *this;
+}
+
+FRiftlineTelemetryEvent& FRiftlineTelemetryEvent::AddEnum(FName Key, const UEnum* EnumType, int64 Value)
+{
+    FRiftlineTelemetryField& Field = AddField(Key, ERiftlineTelemetryValueType::Enum);
+    Field.EnumType = EnumType;
+    Field.IntValue = Value;
+    return *this;
+}
+
+FRiftlineTelemetryEvent& FRiftlineTelemetryEvent::AddInt(FName Key, int64 Value)
+{
+    AddField(Key, ERiftlineTelemetryValueType::Int).IntValue = Value;
+    return *this;
+}
+
+FRiftlineTelemetryEvent& FRiftlineTelemetryEvent::AddFloat(FName Key, double Value)
+{
+    AddField(Key, ERiftlineTelemetryValueType::Float).FloatValue = FMath::IsFinite(Value) ? Value : 0.0;
+    return *this;
+}
+
+FRiftlineTelemetryField& FRiftlineTelemetryEvent::AddField(FName Key, ERiftlineTelemetryValueType Type)
+{
+    FRiftlineTelemetryField& Field = Fields.AddDefaulted_GetRef();
+    Field.Key = Key;
+    Field.Type = Type;
+    return Field;
+}
+
+void FRiftlineTelemetryEvent::AppendJson(FString& Out, int64 TimestampMs, int32 ShardId) const
+{
+    Out += TEXT("{\"event\":\"");
+    AppendEscapedName(Out, Name);
+    Out.Appendf(TEXT("\",\"ts\":%lld,"), TimestampMs);
+    if (ShardId != INDEX_NONE)
+    {
+        Out.Appendf(TEXT("\"shardId\":%d,"), ShardId);
+    }
+    Out += TEXT("\"properties\":{");
+
+    bool bFirst = true;
+    for (const FRiftlineTelemetryField& Field : Fields)
+    {
+        if (!bFirst)
+        {
+            Out.AppendChar(TEXT(','));
+        }
+        bFirst = false;
+
+        Out.AppendChar(TEXT('"'));
+        AppendEscapedName(Out, Field.Key);
+        Out += TEXT("\":");
+
+        switch (Field.Type)
+        {
+        case ERiftlineTelemetryValueType::Int:
+            Out.Appendf(TEXT("%lld"), Field.IntValue);
+            break;
+        case ERiftlineTelemetryValueType::Float:
+            Out.Appendf(TEXT("%.3f"), Field.FloatValue);
+            break;
+        case ERiftlineTelemetryValueType::Bool:
+            Out += Field.bBoolValue ? TEXT("true") : TEXT("false");
+            break;
+        case ERiftlineTelemetryValueType::Name:
+            Out.AppendChar(TEXT('"'));
+            AppendEscapedName(Out, Field.NameValue);
+            Out.AppendChar(TEXT('"'));
+            break;
+        case ERiftlineTelemetryValueType::Enum:
+            Out.AppendChar(TEXT('"'));
+            FRiftlineTelemetrySchemaRegistry::Get().AppendEnumEntryName(Out, Field.EnumType, Field.IntValue);
+            Out.AppendChar(TEXT('"'));
+            break;
+        case ERiftlineTelemetryValueType::String:
+            Out.AppendChar(TEXT('"'));
+            RiftlineTelemetry::AppendJsonEscaped(Out, Field.StringValue);
+            Out.AppendChar(TEXT('"'));
+            break;
+        }
+    }
+
+    Out += TEXT("}}");
+}
+
+FRiftlineTelemetrySchemaRegistry& FRiftlineTelemetrySchemaRegistry::Get()
+{
+    static FRiftlineTelemetrySchemaRegistry Registry;
+    return Registry;
+}
+
+void FRiftlineTelemetrySchemaRegistry::Register(FRiftlineTelemetrySchema&& Schema)
+{
+    ensureMsgf(Schema.Fields.Num() <= FRiftlineTelemetryEvent::InlineFieldCount,
+        TEXT("Telemetry event %s has %d fields; raise InlineFieldCount so it stays off the heap"), *Schema.Event.ToString(), Schema.Fields.Num());
+    const FName Event = Schema.Event;
+    Schemas.Add(Event, MoveTemp(Schema));
+}
+
+const FRiftlineTelemetrySchema* FRiftlineTelemetrySchemaRegistry::Find(FName Event) const
+{
+    return Schemas.Find(Event);
+}
+
+bool FRiftlineTelemetrySchemaRegistry::Validate(const FRiftlineTelemetryEvent& Event) const
+{
+    const FRiftlineTelemetrySchema* Schema = Find(Event.GetName());
+    if (!Schema)
+    {
+        // Unregistered events (for example from Blueprint) are accepted as-is.
+        return true;
+    }
+
+    for (const FRiftlineTelemetryField& Field : Event.GetFields())
+    {
+        const TPair<FName, ERiftlineTelemetryValueType>* Expected = Schema->Fields.FindByPredicate(
+            [&Field](const TPair<FName, ERiftlineTelemetryValueType>& Entry) { return Entry.Key == Field.Key; });
+        if (!Expected || Expected->Value != Field.Type)
+        {
+            UE_LOG(LogRiftline, Warning, TEXT("Telemetry event %s has unexpected field %s"), *Event.GetName().ToString(), *Field.Key.ToString());
+            return false;
+        }
+    }
+    return true;
+}
+
+void FRiftlineTelemetrySchemaRegistry::AppendEnumEntryName(FString& Out, const UEnum* EnumType, int64 Value)
+{
+    if (!EnumType)
+    {
+        Out.AppendInt(static_cast<int32>(Value));
+        return;
+    }
+
+    FScopeLock Lock(&EnumNamesLock);
+    TMap<int64, FString>* Names = EnumNames.Find(EnumType);
+    if (!Names)
+    {
+        Names = &EnumNames.Add(EnumType);
+        for (int32 Index = 0; Index < EnumType->NumEnums(); ++Index)
+        {
+            Names->Add(EnumType->GetValueByIndex(Index), EnumType->GetNameStringByIndex(Index));
+        }
+    }
+
+    if (const FString* EntryName = Names->Find(Value))
+    {
+        Out += *EntryName;
+    }
+    else
+    {
+        Out.AppendInt(static_cast<int32>(Value));
+    }
+}
+
+void FRiftlineTelemetrySchemaRegistry::RegisterBuiltInSchemas()
+{
+    if (bBuiltInsRegistered)
+    {
+        return;
+    }
+    bBuiltInsRegistered = true;
+
+    using namespace RiftlineTelemetry;
+    using EType = ERiftlineTelemetryValueType;
+
+    Register({ Events::RadialSelect, { { Keys::Option, EType::Name } } });
+    Register({ Events::PhoneOpen, { { Keys::Source, EType::Name } } });
+    Register({ Events::PhoneClose, { { Keys::Source, EType::Name } } });
+    const UEnum* PhoneTabs = StaticEnum<ERiftlinePhoneTab>();
+    const UEnum* WantedLevels = StaticEnum<ERiftlineWantedLevel>();
+    const UEnum* ThermalStates = StaticEnum<ERiftlineThermalState>();
+
+    Register({ Events::PhoneTab, { { Keys::Tab, EType::Enum } }, { { Keys::Tab, PhoneTabs } } });
+    Register({ Events::MarketView, { { Keys::Source, EType::Name }, { Keys::Items, EType::Int } } });
+    Register({ Events::MarketList, { { Keys::Count, EType::Int } } });
+    Register({ Events::WalletLogin, { { Keys::Address, EType::String } } });
+    // Expiry and heat keep the string encoding wanted_state has always had on the wire.
+    Register({ Events::WantedState, { { Keys::Level, EType::Enum }, { Keys::Expires, EType::String }, { Keys::Heat, EType::String } },
+        { { Keys::Level, WantedLevels } } });
+    Register({ Events::ClientFrameTime, {
+        { Keys::Frames, EType::Int }, { Keys::Hitches, EType::Int }, { Keys::Avg, EType::Float },
+        { Keys::P50, EType::Float }, { Keys::P90, EType::Float }, { Keys::P99, EType::Float }, { Keys::Max, EType::Float } } });
+    Register({ Events::ClientThreadTime, {
+        { Keys::Thread, EType::Name }, { Keys::Avg, EType::Float },
+        { Keys::P50, EType::Float }, { Keys::P90, EType::Float }, { Keys::P99, EType::Float }, { Keys::Max, EType::Float } } });
+    Register({ Events::ClientHitch, {
+        { Keys::Frame, EType::Float }, { Keys::Game, EType::Float }, { Keys::Render, EType::Float }, { Keys::Rhi, EType::Float },
+        { Keys::Gpu, EType::Float }, { Keys::Tab, EType::Enum }, { Keys::Phone, EType::Bool }, { Keys::Shard, EType::Int },
+        { Keys::Wanted, EType::Enum }, { Keys::Interaction, EType::Name } },
+        { { Keys::Tab, PhoneTabs }, { Keys::Wanted, WantedLevels } } });
+    Register({ Events::ClientThermal, {
+        { Keys::State, EType::Enum }, { Keys::Platform, EType::Name }, { Keys::Battery, EType::Float }, { Keys::OnBattery, EType::Bool } },
+        { { Keys::State, ThermalStates } } });
+    Register({ Events::ClientHttp, {
+        { Keys::Priority, EType::Name }, { Keys::Count, EType::Int }, { Keys::Retries, EType::Int }, { Keys::Failures, EType::Int },
+        { Keys::Coalesced, EType::Int }, { Keys::Avg, EType::Float }, { Keys::P50, EType::Float }, { Keys::P90, EType::Float },
+        { Keys::P99, EType::Float }, { Keys::Max, EType::Float } } });
+    Register({ Events::ClientNet, {
+        { Keys::Host, EType::Name }, { Keys::Count, EType::Int }, { Keys::Failures, EType::Int }, { Keys::P50, EType::Float },
+        { Keys::P95, EType::Float }, { Keys::Max, EType::Float }, { Keys::Offset, EType::Float }, { Keys::OffsetError, EType::Float } } });
+    Register({ Events::ClientGovernor, { { Keys::Step, EType::Int }, { Keys::Reason, EType::Name }, { Keys::State, EType::Enum } },
+        { { Keys::State, ThermalStates } } });
+    Register({ Events::Rollup, {
+        { Keys::Event, EType::Name }, { Keys::Value, EType::Name }, { Keys::Count, EType::Int }, { Keys::Suppressed, EType::Int },
+        { Keys::Sum, EType::Float }, { Keys::Min, EType::Float }, { Keys::Max, EType::Float } } });
+}
@@ -0,0 +1,488 @@
+#include "RiftlineTelemetryJournal.h"
+
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Riftline.h"
+#include "RiftlineTelemetryPipeline.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    const TCHAR* ChunkPrefix = TEXT("chunk-");
+    const TCHAR* ChunkExtension = TEXT(".rlj");
+    constexpr uint32 MaxRecordBytes = 64 * 1024;
+
+    /** "RLJ1"; larger than MaxRecordBytes, so a chunk written before headers existed never starts with it. */
+    constexpr uint32 ChunkMagic = 0x314A4C52;
+    constexpr int32 ChunkPrefixBytes = 2 * sizeof(uint32);
+    constexpr int32 MaxHeaderBytes = 1024;
+
+    /** A chunk is read whole for upload, so it stays well under what a phone can hold in memory at once. */
+    constexpr int64 MinChunkBytes = 4 * 1024;
+    constexpr int64 MaxChunkBytes = 4 * 1024 * 1024;
+
+    /** Returns the offset of the first record, or INDEX_NONE if the header is torn; headerless chunks start at 0. */
+    int64 ParseChunkHeader(const uint8* Data, int64 Size, FString& OutPlayerId)
+    {
+        OutPlayerId.Reset();
+        uint32 Magic = 0;
+        if (Size < static_cast<int64>(sizeof(uint32)))
+        {
+            return 0;
+        }
+        FMemory::Memcpy(&Magic, Data, sizeof(uint32));
+        if (Magic != ChunkMagic)
+        {
+            return 0;
+        }
+
+        uint32 Length = 0;
+        if (Size < ChunkPrefixBytes)
+        {
+            return INDEX_NONE;
+        }
+        FMemory::Memcpy(&Length, Data + sizeof(uint32), sizeof(uint32));
+        if (Length > static_cast<uint32>(MaxHeaderBytes - ChunkPrefixBytes) || ChunkPrefixBytes + Length > Size)
+        {
+            return INDEX_NONE;
+        }
+
+        FMemoryReaderView Reader(MakeArrayView(Data + ChunkPrefixBytes, static_cast<int32>(Length)));
+        Reader << OutPlayerId;
+        if (Reader.IsError())
+        {
+            OutPlayerId.Reset();
+            return INDEX_NONE;
+        }
+        return ChunkPrefixBytes + Length;
+    }
+}
+
+FRiftlineTelemetryJournal::FRiftlineTelemetryJournal(const FString& InDirectory, int64 InMaxBytes, int64 InChunkBytes, int32 InMaxRecordsPerChunk)
+    : Directory(InDirectory)
+    , MaxBytes(FMath::Max<int64>(InMaxBytes, 64 * 1024))
+    , ChunkBytes(FMath::Clamp<int64>(InChunkBytes, MinChunkBytes, FMath::Min(MaxChunkBytes, MaxBytes)))
+    , MaxRecordsPerChunk(FMath::Max(InMaxRecordsPerChunk, 1))
+{
+}
+
+FRiftlineTelemetryJournal::~FRiftlineTelemetryJournal()
+{
+    Close();
+}
+
+void FRiftlineTelemetryJournal::Open()
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*Directory);
+
+    TArray<FString> Files;
+    IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, FString(ChunkPrefix) + TEXT("*") + ChunkExtension), true, false);
+
+    SealedChunks.Reset();
+    for (const FString& File : Files)
+    {
+        const FString SequenceText = FPaths::GetBaseFilename(File).RightChop(FCString::Strlen(ChunkPrefix));
+        FChunk Chunk;
+        Chunk.Sequence = FCString::Strtoui64(*SequenceText, nullptr, 10);
+        Chunk.Bytes = PlatformFile.FileSize(*ChunkPath(Chunk.Sequence));
+        if (Chunk.Sequence == 0 || Chunk.Bytes <= 0)
+        {
+            PlatformFile.DeleteFile(*FPaths::Combine(Directory, File));
+            continue;
+        }
+        // Recovered chunks are counted so evicting them reports the records actually lost.
+        Chunk.Records = ScanChunk(Chunk.Sequence, Chunk.PlayerId);
+        SealedChunks.Add(Chunk);
+        NextSequence = FMath::Max(NextSequence, Chunk.Sequence + 1);
+    }
+
+    SealedChunks.Sort([](const FChunk& A, const FChunk& B) { return A.Sequence < B.Sequence; });
+    EnforceBudget();
+
+    if (SealedChunks.Num() > 0)
+    {
+        UE_LOG(LogRiftline, Log, TEXT("Telemetry journal recovered %d chunk(s) (%lld bytes)"), SealedChunks.Num(), GetTotalBytes());
+    }
+}
+
+void FRiftlineTelemetryJournal::Close()
+{
+    Seal();
+}
+
+void FRiftlineTelemetryJournal::SetPlayerId(const FString& InPlayerId)
+{
+    if (PlayerId == InPlayerId)
+    {
+        return;
+    }
+
+    // Records already in the active chunk belong to the previous player, so they are sealed under its header.
+    Seal();
+    PlayerId = InPlayerId;
+}
+
+bool FRiftlineTelemetryJournal::Append(const FRiftlineTelemetryRecord& Record)
+{
+    if (!ActiveHandle && !OpenActiveChunk())
+    {
+        return false;
+    }
+
+    Scratch.Reset();
+    FMemoryWriter Writer(Scratch);
+    uint32 Length = 0;
+    Writer << Length;
+    SerializeRecord(Writer, const_cast<FRiftlineTelemetryRecord&>(Record));
+
+    Length = static_cast<uint32>(Scratch.Num() - sizeof(uint32));
+    if (Length > MaxRecordBytes)
+    {
+        return false;
+    }
+    FMemory::Memcpy(Scratch.GetData(), &Length, sizeof(uint32));
+
+    if (!ActiveHandle->Write(Scratch.GetData(), Scratch.Num()))
+    {
+        UE_LOG(LogRiftline, Warning, TEXT("Telemetry journal write failed; sealing chunk %llu"), ActiveSequence);
+        Seal();
+        return false;
+    }
+
+    ActiveBytes += Scratch.Num();
+    ++ActiveRecords;
+
+    if (ActiveBytes >= ChunkBytes || ActiveRecords >= MaxRecordsPerChunk)
+    {
+        Seal();
+    }
+    return true;
+}
+
+void FRiftlineTelemetryJournal::Commit()
+{
+    if (ActiveHandle)
+    {
+        ActiveHandle->Flush();
+    }
+}
+
+void FRiftlineTelemetryJournal::Seal()
+{
+    if (!ActiveHandle)
+    {
+        return;
+    }
+
+    ActiveHandle->Flush(true);
+    ActiveHandle.Reset();
+
+    if (ActiveRecords > 0)
+    {
+        FChunk Chunk;
+        Chunk.Sequence = ActiveSequence;
+        Chunk.Bytes = ActiveBytes;
+        Chunk.Records = ActiveRecords;
+        Chunk.PlayerId = PlayerId;
+        SealedChunks.Add(Chunk);
+    }
+    else
+    {
+        FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*ChunkPath(ActiveSequence));
+    }
+
+    ActiveBytes = 0;
+    ActiveRecords = 0;
+    EnforceBudget();
+}
+
+bool FRiftlineTelemetryJournal::ReadOldest(TArray<FRiftlineTelemetryRecord>& OutRecords, uint64& OutSequence, FString* OutPlayerId) const
+{
+    OutRecords.Reset();
+    OutSequence = 0;
+    if (SealedChunks.Num() == 0)
+    {
+        return false;
+    }
+    OutSequence = SealedChunks[0].Sequence;
+    if (OutPlayerId)
+    {
+        *OutPlayerId = SealedChunks[0].PlayerId;
+    }
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *ChunkPath(SealedChunks[0].Sequence), FILEREAD_Silent))
+    {
+        return false;
+    }
+
+    FString HeaderPlayerId;
+    const int64 FirstRecord = ParseChunkHeader(Bytes.GetData(), Bytes.Num(), HeaderPlayerId);
+    if (FirstRecord == INDEX_NONE)
+    {
+        return true;
+    }
+
+    FMemoryReader Reader(Bytes);
+    Reader.Seek(FirstRecord);
+    while (Reader.Tell() + static_cast<int64>(sizeof(uint32)) <= Bytes.Num())
+    {
+        uint32 Length = 0;
+        Reader << Length;
+        if (Length == 0 || Length > MaxRecordBytes || Reader.Tell() + Length > Bytes.Num())
+        {
+            // Torn tail from an interrupted write; everything before it is intact.
+            break;
+        }
+
+        const int64 RecordEnd = Reader.Tell() + Length;
+        FRiftlineTelemetryRecord& Record = OutRecords.AddDefaulted_GetRef();
+        SerializeRecord(Reader, Record);
+        if (Reader.IsError() || Reader.Tell() != RecordEnd)
+        {
+            OutRecords.Pop();
+            break;
+        }
+    }
+    return true;
+}
+
+void FRiftlineTelemetryJournal::Pop(uint64 Sequence)
+{
+    const int32 Index = SealedChunks.IndexOfByPredicate([Sequence](const FChunk& Chunk) { return Chunk.Sequence == Sequence; });
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*ChunkPath(Sequence));
+    SealedChunks.RemoveAt(Index);
+    if (InFlightSequence == Sequence)
+    {
+        InFlightSequence = 0;
+    }
+}
+
+int64 FRiftlineTelemetryJournal::GetTotalBytes() const
+{
+    int64 Total = ActiveBytes;
+    for (const FChunk& Chunk : SealedChunks)
+    {
+        Total += Chunk.Bytes;
+    }
+    return Total;
+}
+
+void FRiftlineTelemetryJournal::SerializeRecord(FArchive& Ar, FRiftlineTelemetryRecord& Record)
+{
+    FName EventName = Record.Event.GetName();
+    Ar << EventName;
+    Ar << Record.TimestampMs;
+    Ar << Record.ShardId;
+
+    int32 FieldCount = Record.Event.GetFields().Num();
+    Ar << FieldCount;
+
+    if (Ar.IsLoading())
+    {
+        Record.Event = FRiftlineTelemetryEvent(EventName);
+        for (int32 Index = 0; Index < FieldCount && !Ar.IsError(); ++Index)
+        {
+            FName Key;
+            uint8 Type = 0;
+            Ar << Key;
+            Ar << Type;
+            switch (static_cast<ERiftlineTelemetryValueType>(Type))
+            {
+            case ERiftlineTelemetryValueType::Int:
+            {
+                int64 Value = 0;
+                Ar << Value;
+                Record.Event.Add(Key, Value);
+                break;
+            }
+            case ERiftlineTelemetryValueType::Float:
+            {
+                double Value = 0.0;
+                Ar << Value;
+                Record.Event.Add(Key, Value);
+                break;
+            }
+            case ERiftlineTelemetryValueType::Bool:
+            {
+                bool bValue = false;
+                Ar << bValue;
+                Record.Event.Add(Key, bValue);
+                break;
+            }
+            case ERiftlineTelemetryValueType::Name:
+            {
+                FName Value;
+                Ar << Value;
+                Record.Event.Add(Key, Value);
+                break;
+            }
+            case ERiftlineTelemetryValueType::String:
+            {
+                FString Value;
+                Ar << Value;
+                Record.Event.AddString(Key, Value);
+                break;
+            }
+            default:
+                Ar.SetError();
+                break;
+            }
+        }
+        return;
+    }
+
+    FString EnumName;
+    for (const FRiftlineTelemetryField& Field : Record.Event.GetFields())
+    {
+        FName Key = Field.Key;
+        // Enum fields are persisted by entry name so the journal never stores UEnum pointers.
+        uint8 Type = static_cast<uint8>(Field.Type == ERiftlineTelemetryValueType::Enum ? ERiftlineTelemetryValueType::Name : Field.Type);
+        Ar << Key;
+        Ar << Type;
+        switch (Field.Type)
+        {
+        case ERiftlineTelemetryValueType::Int:
+        {
+            int64 Value = Field.IntValue;
+            Ar << Value;
+            break;
+        }
+        case ERiftlineTelemetryValueType::Float:
+        {
+            double Value = Field.FloatValue;
+            Ar << Value;
+            break;
+        }
+        case ERiftlineTelemetryValueType::Bool:
+        {
+            bool bValue = Field.bBoolValue;
+            Ar << bValue;
+            break;
+        }
+        case ERiftlineTelemetryValueType::Name:
+        {
+            FName Value = Field.NameValue;
+            Ar << Value;
+            break;
+        }
+        case ERiftlineTelemetryValueType::Enum:
+        {
+            EnumName.Reset();
+            FRiftlineTelemetrySchemaRegistry::Get().AppendEnumEntryName(EnumName, Field.EnumType, Field.IntValue);
+            FName Value(*EnumName);
+            Ar << Value;
+            break;
+        }
+        case ERiftlineTelemetryValueType::String:
+        {
+            FString Value = Field.StringValue;
+            Ar << Value;
+            break;
+        }
+        }
+    }
+}
+
+FString FRiftlineTelemetryJournal::ChunkPath(uint64 Sequence) const
+{
+    return FPaths::Combine(Directory, FString::Printf(TEXT("%s%010llu%s"), ChunkPrefix, Sequence, ChunkExtension));
+}
+
+bool FRiftlineTelemetryJournal::OpenActiveChunk()
+{
+    ActiveSequence = NextSequence++;
+    ActiveBytes = 0;
+    ActiveRecords = 0;
+    ActiveHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*ChunkPath(ActiveSequence), true, false));
+    if (!ActiveHandle)
+    {
+        UE_LOG(LogRiftline, Warning, TEXT("Telemetry journal could not open %s"), *ChunkPath(ActiveSequence));
+        return false;
+    }
+
+    Scratch.Reset();
+    FMemoryWriter Writer(Scratch);
+    uint32 Magic = ChunkMagic;
+    uint32 Length = 0;
+    Writer << Magic;
+    Writer << Length;
+    Writer << PlayerId;
+    Length = static_cast<uint32>(Scratch.Num() - ChunkPrefixBytes);
+    FMemory::Memcpy(Scratch.GetData() + sizeof(uint32), &Length, sizeof(uint32));
+    if (Scratch.Num() > MaxHeaderBytes || !ActiveHandle->Write(Scratch.GetData(), Scratch.Num()))
+    {
+        UE_LOG(LogRiftline, Warning, TEXT("Telemetry journal could not write the header of %s"), *ChunkPath(ActiveSequence));
+        ActiveHandle.Reset();
+        FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*ChunkPath(ActiveSequence));
+        return false;
+    }
+    ActiveBytes = Scratch.Num();
+    EnforceBudget();
+    return true;
+}
+
+int32 FRiftlineTelemetryJournal::ScanChunk(uint64 Sequence, FString& OutPlayerId) const
+{
+    OutPlayerId.Reset();
+    TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*ChunkPath(Sequence)));
+    if (!Handle)
+    {
+        return 0;
+    }
+
+    const int64 Size = Handle->Size();
+    TArray<uint8> Header;
+    Header.SetNumUninitialized(static_cast<int32>(FMath::Min<int64>(Size, MaxHeaderBytes)));
+    if (!Handle->Read(Header.GetData(), Header.Num()))
+    {
+        return 0;
+    }
+    int64 Offset = ParseChunkHeader(Header.GetData(), Header.Num(), OutPlayerId);
+    if (Offset == INDEX_NONE)
+    {
+        return 0;
+    }
+
+    // Walks the length prefixes only; a torn tail ends the count just as it ends ReadOldest.
+    int32 Records = 0;
+    uint32 Length = 0;
+    while (Offset + static_cast<int64>(sizeof(uint32)) <= Size && Handle->Seek(Offset) && Handle->Read(reinterpret_cast<uint8*>(&Length), sizeof(uint32)))
+    {
+        Offset += sizeof(uint32) + Length;
+        if (Length == 0 || Length > MaxRecordBytes || Offset > Size)
+        {
+            break;
+        }
+        ++Records;
+    }
+    return Records;
+}
+
+void FRiftlineTelemetryJournal::EnforceBudget()
+{
+    // The chunk being uploaded is skipped: evicting it would let its acknowledgement delete a chunk never sent.
+    int32 Index = 0;
+    while (Index < SealedChunks.Num() && GetTotalBytes() > MaxBytes)
+    {
+        const FChunk Chunk = SealedChunks[Index];
+        if (Chunk.Sequence == InFlightSequence)
+        {
+            ++Index;
+            continue;
+        }
+        EvictedRecords += Chunk.Records;
+        UE_LOG(LogRiftline, Verbose, TEXT("Telemetry journal over budget; evicting chunk %llu"), Chunk.Sequence);
+        Pop(Chunk.Sequence);
+    }
+}
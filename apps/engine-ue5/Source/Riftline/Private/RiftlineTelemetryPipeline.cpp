@@ -0,0 +1,630 @@
+#include "RiftlineTelemetryPipeline.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Riftline.h"
+#include "RiftlineTelemetryJournal.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    constexpr double InitialRetryDelay = 5.0;
+    constexpr double MaxRetryDelay = 300.0;
+
+    enum EUploadResult : int32
+    {
+        UploadPending = 0,
+        UploadAccepted = 1,
+        UploadFailed = 2,
+        UploadRejected = 3,
+        UploadUnsupportedFormat = 4,
+        UploadPiggybackRefused = 5
+    };
+
+    int32 ClassifyUpload(const FRiftlineHttpResult& Result)
+    {
+        if (!Result.bConnected)
+        {
+            return UploadFailed;
+        }
+
+        const int32 Code = Result.Code;
+        if (EHttpResponseCodes::IsOk(Code))
+        {
+            return UploadAccepted;
+        }
+        if (Code == EHttpResponseCodes::UnsupportedMediaType)
+        {
+            return UploadUnsupportedFormat;
+        }
+        // An expired or not yet applied session token; the chunk waits for a fresh one instead of being discarded.
+        if (Code == EHttpResponseCodes::Denied || Code == EHttpResponseCodes::Forbidden)
+        {
+            return UploadFailed;
+        }
+        if (Code >= 400 && Code < 500 && Code != EHttpResponseCodes::RequestTimeout && Code != EHttpResponseCodes::TooManyRequests)
+        {
+            return UploadRejected;
+        }
+        return UploadFailed;
+    }
+
+    /** A gateway that predates piggybacking answers the heartbeat but silently ignores the events it carried. */
+    bool ReportsAcceptedEvents(const FRiftlineHttpResult& Result)
+    {
+        TSharedPtr<FJsonObject> Body;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Result.GetContentAsString());
+        return FJsonSerializer::Deserialize(Reader, Body) && Body.IsValid() && Body->HasField(TEXT("accepted"));
+    }
+
+    /** Completes a heartbeat that was never sent, so the game instance does not wait on it until its own timeout. */
+    void AbandonHeartbeat(FRiftlineHttpCompleteDelegate&& OnComplete)
+    {
+        if (!OnComplete.IsBound())
+        {
+            return;
+        }
+        if (IsInGameThread())
+        {
+            OnComplete.Execute(FRiftlineHttpResult());
+            return;
+        }
+        AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete)]()
+        {
+            OnComplete.ExecuteIfBound(FRiftlineHttpResult());
+        });
+    }
+}
+
+FRiftlineTelemetryPipeline::FRiftlineTelemetryPipeline(const FRiftlineTelemetryPipelineSettings& InSettings)
+    : Settings(InSettings)
+    , Queue(static_cast<uint32>(FMath::Max(InSettings.QueueCapacity, 16)))
+{
+    Settings.BatchSize = FMath::Max(Settings.BatchSize, 1);
+    Settings.FlushInterval = FMath::Max(Settings.FlushInterval, 0.5f);
+    if (Settings.JournalDirectory.IsEmpty())
+    {
+        Settings.JournalDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"));
+    }
+    ActiveWireFormat = Settings.WireFormat;
+}
+
+FRiftlineTelemetryPipeline::~FRiftlineTelemetryPipeline()
+{
+    StopAndFlush();
+}
+
+void FRiftlineTelemetryPipeline::Start()
+{
+    if (Thread)
+    {
+        return;
+    }
+
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, TEXT("RiftlineTelemetry"), 0, TPri_BelowNormal);
+    if (!Thread)
+    {
+        UE_LOG(LogRiftline, Warning, TEXT("Telemetry worker could not be started; events will be dropped"));
+    }
+}
+
+void FRiftlineTelemetryPipeline::StopAndFlush()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    // The worker has exited, so its journal and upload state are safe to drive from here.
+    if (Journal)
+    {
+        FlushOnShutdown();
+        Journal->Close();
+        Journal.Reset();
+    }
+
+    if (WakeEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+
+    FHeartbeatRequest Unsent;
+    if (TakeHeartbeat(Unsent))
+    {
+        AbandonHeartbeat(MoveTemp(Unsent.OnComplete));
+    }
+}
+
+bool FRiftlineTelemetryPipeline::Enqueue(const FRiftlineTelemetryEvent& Event, int64 TimestampMs, int32 ShardId)
+{
+    if (!Thread || bStopRequested.load(std::memory_order_relaxed))
+    {
+        DroppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const bool bQueued = Queue.TryEnqueueWith([&](FRiftlineTelemetryRecord& Slot)
+    {
+        Slot.Event = Event;
+        Slot.TimestampMs = TimestampMs;
+        Slot.ShardId = ShardId;
+        Slot.PlayerEpoch = PlayerEpoch.load(std::memory_order_acquire);
+    });
+
+    if (!bQueued)
+    {
+        DroppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const uint64 Enqueued = EnqueuedCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    const uint64 Depth = Enqueued - DequeuedCount.load(std::memory_order_relaxed);
+    RIFTLINE_COUNTER_SET(RiftlineTelemetryQueueDepth, static_cast<uint32>(Depth));
+    if (Depth == static_cast<uint64>(Settings.BatchSize))
+    {
+        WakeEvent->Trigger();
+    }
+    return true;
+}
+
+void FRiftlineTelemetryPipeline::RequestFlush()
+{
+    bFlushRequested.store(true, std::memory_order_relaxed);
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+void FRiftlineTelemetryPipeline::SetPlayerId(const FString& InPlayerId)
+{
+    FScopeLock Lock(&IdentityLock);
+    if (PlayerId == InPlayerId)
+    {
+        return;
+    }
+    PlayerId = InPlayerId;
+
+    // Records already in the ring keep the epoch they were enqueued under, so they still reach the old player's chunks.
+    const uint32 Epoch = PlayerEpoch.load(std::memory_order_relaxed) + 1;
+    PlayerIdsByEpoch.Add(Epoch, InPlayerId);
+    PlayerEpoch.store(Epoch, std::memory_order_release);
+}
+
+void FRiftlineTelemetryPipeline::SetAuthToken(const FString& Token)
+{
+    FScopeLock Lock(&IdentityLock);
+    AuthToken = Token;
+}
+
+bool FRiftlineTelemetryPipeline::RequestHeartbeat(int32 ShardId, FRiftlineHttpCompleteDelegate&& OnComplete)
+{
+    if (!Thread || Settings.HeartbeatUrl.IsEmpty() || !Settings.Scheduler.IsValid() || GetPlayerId().IsEmpty())
+    {
+        return false;
+    }
+
+    FRiftlineHttpCompleteDelegate Replaced;
+    {
+        FScopeLock Lock(&HeartbeatLock);
+        if (PendingHeartbeat.IsSet())
+        {
+            Replaced = MoveTemp(PendingHeartbeat->OnComplete);
+        }
+        FHeartbeatRequest& Heartbeat = PendingHeartbeat.Emplace();
+        Heartbeat.ShardId = ShardId;
+        Heartbeat.OnComplete = MoveTemp(OnComplete);
+        bHeartbeatRequested.store(true, std::memory_order_relaxed);
+    }
+    AbandonHeartbeat(MoveTemp(Replaced));
+    WakeEvent->Trigger();
+    return true;
+}
+
+uint64 FRiftlineTelemetryPipeline::GetQueueDepth() const
+{
+    const uint64 Enqueued = EnqueuedCount.load(std::memory_order_relaxed);
+    const uint64 Dequeued = DequeuedCount.load(std::memory_order_relaxed);
+    return Enqueued > Dequeued ? Enqueued - Dequeued : 0;
+}
+
+uint32 FRiftlineTelemetryPipeline::Run()
+{
+    LLM_SCOPE_BYTAG(Riftline_Network);
+    const uint32 WaitMs = static_cast<uint32>(FMath::Max(Settings.FlushInterval * 250.f, 50.f));
+
+    Journal = MakeUnique<FRiftlineTelemetryJournal>(Settings.JournalDirectory, Settings.MaxJournalBytes, Settings.JournalChunkBytes, Settings.MaxRecordsPerUpload);
+    Journal->Open();
+
+    while (!bStopRequested.load(std::memory_order_relaxed))
+    {
+        WakeEvent->Wait(WaitMs);
+        DrainQueue();
+        Journal->Commit();
+
+        const double Now = FPlatformTime::Seconds();
+        const bool bFlush = bFlushRequested.exchange(false, std::memory_order_relaxed);
+        const int32 ActiveRecords = Journal->GetActiveRecordCount();
+
+        // While heartbeats are flowing a partial batch waits to ride the next one instead of paying for its own request.
+        const bool bPiggyback = !bPiggybackRefused && LastHeartbeatAt > 0.0 && Now - LastHeartbeatAt < Settings.MaxPiggybackWait;
+        const double PartialBatchWait = bPiggyback ? FMath::Max(Settings.FlushInterval, Settings.MaxPiggybackWait) : Settings.FlushInterval;
+        const bool bHeartbeatDue = bHeartbeatRequested.load(std::memory_order_relaxed);
+        const bool bBatchReady = ActiveRecords >= Settings.BatchSize
+            || (ActiveRecords > 0 && (bHeartbeatDue || Now - ChunkStartedAt >= PartialBatchWait));
+
+        // While the gateway is unreachable the active chunk keeps growing, so the backlog drains in large chunks.
+        if ((bFlush || bBatchReady) && Now >= RetryAt)
+        {
+            Journal->Seal();
+        }
+
+        PumpUploads();
+    }
+
+    // Sealed so StopAndFlush can try to upload it; anything not acknowledged then is uploaded by the next session.
+    DrainQueue();
+    Journal->Seal();
+    return 0;
+}
+
+void FRiftlineTelemetryPipeline::Stop()
+{
+    bStopRequested.store(true, std::memory_order_relaxed);
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+void FRiftlineTelemetryPipeline::DrainQueue()
+{
+    RIFTLINE_SCOPE(TelemetryDrainQueue);
+
+    FRiftlineTelemetryRecord Record;
+    while (Queue.TryDequeue(Record))
+    {
+        DequeuedCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (Record.PlayerEpoch != JournalPlayerEpoch)
+        {
+            JournalPlayerEpoch = Record.PlayerEpoch;
+            Journal->SetPlayerId(ResolvePlayerId(JournalPlayerEpoch));
+        }
+        if (Journal->GetActiveRecordCount() == 0)
+        {
+            ChunkStartedAt = FPlatformTime::Seconds();
+        }
+        if (!Journal->Append(Record))
+        {
+            DroppedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    RIFTLINE_COUNTER_SET(RiftlineTelemetryQueueDepth, static_cast<uint32>(GetQueueDepth()));
+}
+
+void FRiftlineTelemetryPipeline::PumpUploads()
+{
+    if (InFlightUpload.IsValid())
+    {
+        const int32 Result = InFlightUpload->Result.load(std::memory_order_acquire);
+        if (Result == UploadPending)
+        {
+            // Heartbeats never wait behind a slow upload; this one goes out without telemetry.
+            FHeartbeatRequest Heartbeat;
+            if (TakeHeartbeat(Heartbeat))
+            {
+                SubmitHeartbeat(MoveTemp(Heartbeat), false);
+            }
+            return;
+        }
+        const bool bWasHeartbeat = InFlightUpload->bHeartbeat;
+        InFlightUpload.Reset();
+        Journal->SetInFlight(0);
+
+        // Only an explicit refusal turns piggybacking off; auth and transient failures are retried like any upload.
+        const bool bJsonRefused = Result == UploadUnsupportedFormat && ActiveWireFormat == ERiftlineTelemetryWireFormat::Json;
+        if (bWasHeartbeat && (Result == UploadPiggybackRefused || bJsonRefused))
+        {
+            UE_LOG(LogRiftline, Log, TEXT("Gateway does not take telemetry on heartbeats; uploading it separately"));
+            bPiggybackRefused = true;
+            return;
+        }
+
+        if (Result == UploadUnsupportedFormat && ActiveWireFormat != ERiftlineTelemetryWireFormat::Json)
+        {
+            UE_LOG(LogRiftline, Log, TEXT("Gateway does not accept binary telemetry; falling back to JSON"));
+            ActiveWireFormat = ERiftlineTelemetryWireFormat::Json;
+            return;
+        }
+
+        if (Result == UploadFailed || Result == UploadUnsupportedFormat)
+        {
+            RetryDelay = RetryDelay <= 0.0 ? InitialRetryDelay : FMath::Min(RetryDelay * 2.0, MaxRetryDelay);
+            RetryAt = FPlatformTime::Seconds() + RetryDelay * FMath::FRandRange(0.8, 1.2);
+            return;
+        }
+
+        ReportedDropped = UploadDroppedMark;
+        if (Result == UploadRejected)
+        {
+            UE_LOG(LogRiftline, Warning, TEXT("Telemetry chunk rejected by gateway; discarding %d event(s)"), UploadRecords.Num());
+        }
+        Journal->Pop(UploadSequence);
+        RetryDelay = 0.0;
+        RetryAt = 0.0;
+    }
+
+    const bool bCanUpload = FPlatformTime::Seconds() >= RetryAt && Journal->HasSealedChunks();
+    FHeartbeatRequest Heartbeat;
+    if (TakeHeartbeat(Heartbeat))
+    {
+        SubmitHeartbeat(MoveTemp(Heartbeat), bCanUpload && !bPiggybackRefused);
+    }
+    else if (bCanUpload)
+    {
+        SubmitOldestChunk();
+    }
+}
+
+void FRiftlineTelemetryPipeline::SubmitOldestChunk()
+{
+    RIFTLINE_SCOPE(TelemetrySubmitChunk);
+
+    const FString CurrentPlayerId = GetPlayerId();
+    if (Settings.Url.IsEmpty() || !Settings.Scheduler.IsValid() || CurrentPlayerId.IsEmpty())
+    {
+        return;
+    }
+
+    FString ChunkPlayerId;
+    if (!Journal->ReadOldest(UploadRecords, UploadSequence, &ChunkPlayerId) || UploadRecords.Num() == 0)
+    {
+        Journal->Pop(UploadSequence);
+        return;
+    }
+
+    // Chunks recorded before sign-in, or by older builds, carry no player and go out under the current one. A previous
+    // player's chunk keeps its own id and is sent without the bearer token, which would stamp the current wallet on it.
+    const bool bCurrentPlayer = ChunkPlayerId.IsEmpty() || ChunkPlayerId == CurrentPlayerId;
+
+    // One attempt per chunk: failed chunks stay journalled and are retried on the pipeline's own, longer backoff.
+    FRiftlineHttpRequest Request;
+    Request.Url = Settings.Url;
+    Request.Verb = TEXT("POST");
+    Request.Priority = ERiftlineHttpPriority::Telemetry;
+    EncodeUpload(Request, bCurrentPlayer ? CurrentPlayerId : ChunkPlayerId, bCurrentPlayer, UploadRecords, nullptr);
+
+    TSharedPtr<FUploadState, ESPMode::ThreadSafe> Upload = MakeShared<FUploadState, ESPMode::ThreadSafe>();
+    InFlightUpload = Upload;
+    Journal->SetInFlight(UploadSequence);
+    Settings.Scheduler->Submit(MoveTemp(Request), FRiftlineHttpCompleteDelegate::CreateLambda([Upload](const FRiftlineHttpResult& Result)
+    {
+        Upload->Result.store(ClassifyUpload(Result), std::memory_order_release);
+    }));
+}
+
+void FRiftlineTelemetryPipeline::FlushOnShutdown()
+{
+    // Scheduler completions are delivered on the game thread, which is blocked here, so the scheduler is driven directly.
+    if (Settings.ShutdownFlushTimeout <= 0.f || !Settings.Scheduler.IsValid() || !IsInGameThread())
+    {
+        return;
+    }
+
+    const double Deadline = FPlatformTime::Seconds() + Settings.ShutdownFlushTimeout;
+    for (;;)
+    {
+        if (!InFlightUpload.IsValid())
+        {
+            if (FPlatformTime::Seconds() < RetryAt || !Journal->HasSealedChunks())
+            {
+                break;
+            }
+            SubmitOldestChunk();
+            if (!InFlightUpload.IsValid())
+            {
+                break;
+            }
+        }
+
+        const double Remaining = Deadline - FPlatformTime::Seconds();
+        if (Remaining <= 0.0)
+        {
+            break;
+        }
+        Settings.Scheduler->Flush(Remaining);
+
+        // Still on the wire or failed: the chunk stays journalled for the next session.
+        const int32 Result = InFlightUpload->Result.load(std::memory_order_acquire);
+        if (Result == UploadPending)
+        {
+            break;
+        }
+        InFlightUpload.Reset();
+        Journal->SetInFlight(0);
+        if (Result != UploadAccepted && Result != UploadRejected)
+        {
+            break;
+        }
+        ReportedDropped = UploadDroppedMark;
+        Journal->Pop(UploadSequence);
+    }
+}
+
+void FRiftlineTelemetryPipeline::SubmitHeartbeat(FHeartbeatRequest&& Heartbeat, bool bAttachChunk)
+{
+    RIFTLINE_SCOPE(TelemetrySubmitHeartbeat);
+
+    const FString CurrentPlayerId = GetPlayerId();
+    if (Settings.HeartbeatUrl.IsEmpty() || !Settings.Scheduler.IsValid() || CurrentPlayerId.IsEmpty())
+    {
+        AbandonHeartbeat(MoveTemp(Heartbeat.OnComplete));
+        return;
+    }
+    LastHeartbeatAt = FPlatformTime::Seconds();
+
+    // UploadRecords may still back an upload in flight, so only touch it when this heartbeat carries the next chunk.
+    static const TArray<FRiftlineTelemetryRecord> NoRecords;
+    bool bAttached = false;
+    if (bAttachChunk)
+    {
+        FString ChunkPlayerId;
+        const bool bRead = Journal->ReadOldest(UploadRecords, UploadSequence, &ChunkPlayerId) && UploadRecords.Num() > 0;
+        if (!bRead)
+        {
+            Journal->Pop(UploadSequence);
+        }
+
+        // The heartbeat is authenticated as the signed-in player, so a previous player's chunk is uploaded on its own.
+        bAttached = bRead && (ChunkPlayerId.IsEmpty() || ChunkPlayerId == CurrentPlayerId);
+    }
+
+    // A single attempt: the next heartbeat is only an interval away, and the game instance owns the backoff.
+    FRiftlineHttpRequest Request;
+    Request.Url = Settings.HeartbeatUrl;
+    Request.Verb = TEXT("POST");
+    Request.Priority = ERiftlineHttpPriority::Heartbeat;
+    EncodeUpload(Request, CurrentPlayerId, true, bAttached ? UploadRecords : NoRecords, &Heartbeat.ShardId);
+
+    TSharedPtr<FUploadState, ESPMode::ThreadSafe> Upload;
+    if (bAttached)
+    {
+        Upload = MakeShared<FUploadState, ESPMode::ThreadSafe>();
+        Upload->bHeartbeat = true;
+        InFlightUpload = Upload;
+        Journal->SetInFlight(UploadSequence);
+    }
+
+    Settings.Scheduler->Submit(MoveTemp(Request), FRiftlineHttpCompleteDelegate::CreateLambda(
+        [Upload, OnComplete = MoveTemp(Heartbeat.OnComplete)](const FRiftlineHttpResult& Result)
+    {
+        if (Upload.IsValid())
+        {
+            int32 UploadResult = ClassifyUpload(Result);
+            if ((UploadResult == UploadAccepted && !ReportsAcceptedEvents(Result)) || Result.Code == EHttpResponseCodes::RequestTooLarge)
+            {
+                UploadResult = UploadPiggybackRefused;
+            }
+            Upload->Result.store(UploadResult, std::memory_order_release);
+        }
+        OnComplete.ExecuteIfBound(Result);
+    }));
+}
+
+void FRiftlineTelemetryPipeline::EncodeUpload(FRiftlineHttpRequest& Request, const FString& UploadPlayerId, bool bAuthenticate, const TArray<FRiftlineTelemetryRecord>& Records, const int32* HeartbeatShardId)
+{
+    // Dropped counts are only reported alongside events, so a bare heartbeat leaves them for the next batch.
+    const uint64 Dropped = DroppedCount.load(std::memory_order_relaxed) + static_cast<uint64>(Journal->GetEvictedRecordCount());
+    const uint64 DroppedDelta = Records.Num() > 0 ? Dropped - ReportedDropped : 0;
+    if (Records.Num() > 0)
+    {
+        UploadDroppedMark = Dropped;
+    }
+
+    const FString Token = bAuthenticate ? GetAuthToken() : FString();
+    if (!Token.IsEmpty())
+    {
+        Request.SetHeader(TEXT("Authorization"), TEXT("Bearer ") + Token);
+    }
+
+    if (ActiveWireFormat == ERiftlineTelemetryWireFormat::Binary)
+    {
+        if (HeartbeatShardId)
+        {
+            RiftlineTelemetryWire::EncodeBinaryHeartbeat(EncodedBuffer, *HeartbeatShardId, UploadPlayerId, DroppedDelta, Records);
+            Request.SetHeader(TEXT("Content-Type"), RiftlineTelemetryWire::HeartbeatBinaryContentType);
+        }
+        else
+        {
+            RiftlineTelemetryWire::EncodeBinaryBatch(EncodedBuffer, UploadPlayerId, DroppedDelta, Records);
+            Request.SetHeader(TEXT("Content-Type"), RiftlineTelemetryWire::BinaryContentType);
+        }
+    }
+    else
+    {
+        if (HeartbeatShardId)
+        {
+            RiftlineTelemetryWire::EncodeJsonHeartbeat(RequestBuffer, *HeartbeatShardId, UploadPlayerId, DroppedDelta, Records);
+        }
+        else
+        {
+            RiftlineTelemetryWire::EncodeJsonBatch(RequestBuffer, UploadPlayerId, DroppedDelta, Records);
+        }
+        Request.SetHeader(TEXT("Content-Type"), RiftlineTelemetryWire::JsonContentType);
+        const FTCHARToUTF8 Utf8(*RequestBuffer);
+        EncodedBuffer.Reset();
+        EncodedBuffer.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    }
+
+    // A bare heartbeat is a few bytes; only bodies carrying events are worth compressing.
+    TArray<uint8> Compressed;
+    if (Records.Num() > 0 && RiftlineTelemetryWire::Compress(Compressed, EncodedBuffer.GetData(), EncodedBuffer.Num()))
+    {
+        Request.SetHeader(TEXT("Content-Encoding"), TEXT("gzip"));
+        Request.Content = MoveTemp(Compressed);
+    }
+    else
+    {
+        Request.Content = EncodedBuffer;
+    }
+}
+
+bool FRiftlineTelemetryPipeline::TakeHeartbeat(FHeartbeatRequest& Out)
+{
+    if (!bHeartbeatRequested.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    FScopeLock Lock(&HeartbeatLock);
+    if (!PendingHeartbeat.IsSet())
+    {
+        return false;
+    }
+    Out = MoveTemp(PendingHeartbeat.GetValue());
+    PendingHeartbeat.Reset();
+    bHeartbeatRequested.store(false, std::memory_order_relaxed);
+    return true;
+}
+
+FString FRiftlineTelemetryPipeline::GetPlayerId()
+{
+    FScopeLock Lock(&IdentityLock);
+    return PlayerId;
+}
+
+FString FRiftlineTelemetryPipeline::ResolvePlayerId(uint32 Epoch)
+{
+    FScopeLock Lock(&IdentityLock);
+
+    // A producer may still be finishing a record from the epoch before, so only older generations are forgotten.
+    for (auto It = PlayerIdsByEpoch.CreateIterator(); It; ++It)
+    {
+        if (It.Key() + 1 < Epoch)
+        {
+            It.RemoveCurrent();
+        }
+    }
+    const FString* Found = PlayerIdsByEpoch.Find(Epoch);
+    return Found ? *Found : FString();
+}
+
+FString FRiftlineTelemetryPipeline::GetAuthToken()
+{
+    FScopeLock Lock(&IdentityLock);
+    return AuthToken;
+}
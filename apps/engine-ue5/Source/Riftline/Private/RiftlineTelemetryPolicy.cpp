@@ -0,0 +1,188 @@
+#include "RiftlineTelemetryPolicy.h"
+
+#include "RiftlineTelemetry.h"
+
+void FRiftlineTelemetryPolicyEngine::SetPolicy(const FRiftlineTelemetryPolicy& Policy)
+{
+    if (Policy.Event.IsNone())
+    {
+        return;
+    }
+
+    FKindState& State = Kinds.FindOrAdd(Policy.Event);
+    State.Policy = Policy;
+    State.Policy.SampleRate = FMath::Clamp(Policy.SampleRate, 0.f, 1.f);
+    State.Policy.RateLimitBurst = FMath::Max(Policy.RateLimitBurst, 1);
+    State.Tokens = State.Policy.RateLimitBurst;
+    State.LastRefillSeconds = -1.0;
+    State.bActive = true;
+}
+
+void FRiftlineTelemetryPolicyEngine::ClearPolicy(FName Event)
+{
+    // The state is kept until the next rollup so counters gathered under the old policy are still reported.
+    if (FKindState* State = Kinds.Find(Event))
+    {
+        State->bActive = false;
+    }
+}
+
+void FRiftlineTelemetryPolicyEngine::ResetPolicies(const TArray<FRiftlineTelemetryPolicy>& Policies)
+{
+    for (TPair<FName, FKindState>& Pair : Kinds)
+    {
+        Pair.Value.bActive = false;
+    }
+    for (const FRiftlineTelemetryPolicy& Policy : Policies)
+    {
+        SetPolicy(Policy);
+    }
+}
+
+bool FRiftlineTelemetryPolicyEngine::Admit(const FRiftlineTelemetryEvent& Event, double NowSeconds)
+{
+    FKindState* State = Kinds.Find(Event.GetName());
+    if (!State || !State->bActive)
+    {
+        return true;
+    }
+
+    const FRiftlineTelemetryPolicy& Policy = State->Policy;
+    bool bSend = !Policy.bAggregateOnly;
+    if (bSend && Policy.SampleRate < 1.f)
+    {
+        bSend = FMath::FRand() < Policy.SampleRate;
+    }
+    if (bSend && Policy.RateLimitPerSecond > 0.f)
+    {
+        bSend = ConsumeToken(*State, NowSeconds);
+    }
+
+    FBucket& Bucket = State->Buckets.FindOrAdd(Policy.GroupByKey.IsNone() ? NAME_None : ResolveGroup(Event, Policy.GroupByKey));
+    ++Bucket.Count;
+    if (!bSend)
+    {
+        ++Bucket.Suppressed;
+    }
+
+    if (!Policy.ValueKey.IsNone())
+    {
+        for (const FRiftlineTelemetryField& Field : Event.GetFields())
+        {
+            if (Field.Key != Policy.ValueKey)
+            {
+                continue;
+            }
+
+            double Value = 0.0;
+            if (Field.Type == ERiftlineTelemetryValueType::Int)
+            {
+                Value = static_cast<double>(Field.IntValue);
+            }
+            else if (Field.Type == ERiftlineTelemetryValueType::Float)
+            {
+                Value = Field.FloatValue;
+            }
+            else
+            {
+                break;
+            }
+
+            Bucket.Min = Bucket.Samples == 0 ? Value : FMath::Min(Bucket.Min, Value);
+            Bucket.Max = Bucket.Samples == 0 ? Value : FMath::Max(Bucket.Max, Value);
+            Bucket.Sum += Value;
+            ++Bucket.Samples;
+            break;
+        }
+    }
+
+    return bSend;
+}
+
+void FRiftlineTelemetryPolicyEngine::CollectRollups(TArray<FRiftlineTelemetryEvent>& OutEvents)
+{
+    using namespace RiftlineTelemetry;
+
+    for (auto It = Kinds.CreateIterator(); It; ++It)
+    {
+        FKindState& State = It.Value();
+        for (const TPair<FName, FBucket>& Pair : State.Buckets)
+        {
+            const FBucket& Bucket = Pair.Value;
+
+            // Kinds that were neither aggregated nor suppressed already reached the server one row per event.
+            if (Bucket.Suppressed == 0 && Bucket.Samples == 0)
+            {
+                continue;
+            }
+
+            FRiftlineTelemetryEvent& Rollup = OutEvents.Emplace_GetRef(Events::Rollup);
+            Rollup.Add(Keys::Event, It.Key())
+                .Add(Keys::Count, Bucket.Count)
+                .Add(Keys::Suppressed, Bucket.Suppressed);
+            if (!Pair.Key.IsNone())
+            {
+                Rollup.Add(Keys::Value, Pair.Key);
+            }
+            if (Bucket.Samples > 0)
+            {
+                Rollup.Add(Keys::Sum, Bucket.Sum)
+                    .Add(Keys::Min, Bucket.Min)
+                    .Add(Keys::Max, Bucket.Max);
+            }
+        }
+        State.Buckets.Reset();
+
+        if (!State.bActive)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+bool FRiftlineTelemetryPolicyEngine::ConsumeToken(FKindState& State, double NowSeconds)
+{
+    const double Capacity = State.Policy.RateLimitBurst;
+    if (State.LastRefillSeconds >= 0.0)
+    {
+        const double Elapsed = FMath::Max(NowSeconds - State.LastRefillSeconds, 0.0);
+        State.Tokens = FMath::Min(Capacity, State.Tokens + Elapsed * State.Policy.RateLimitPerSecond);
+    }
+    State.LastRefillSeconds = NowSeconds;
+
+    if (State.Tokens < 1.0)
+    {
+        return false;
+    }
+    State.Tokens -= 1.0;
+    return true;
+}
+
+FName FRiftlineTelemetryPolicyEngine::ResolveGroup(const FRiftlineTelemetryEvent& Event, FName Key)
+{
+    for (const FRiftlineTelemetryField& Field : Event.GetFields())
+    {
+        if (Field.Key != Key)
+        {
+            continue;
+        }
+
+        switch (Field.Type)
+        {
+        case ERiftlineTelemetryValueType::Name:
+            return Field.NameValue;
+        case ERiftlineTelemetryValueType::Enum:
+            Scratch.Reset();
+            FRiftlineTelemetrySchemaRegistry::Get().AppendEnumEntryName(Scratch, Field.EnumType, Field.IntValue);
+            return FName(*Scratch);
+        case ERiftlineTelemetryValueType::Int:
+            return FName(*LexToString(Field.IntValue));
+        case ERiftlineTelemetryValueType::Bool:
+            return Field.bBoolValue ? FName(TEXT("true")) : FName(TEXT("false"));
+        default:
+            // Floats and free-form strings would make the rollup unbounded.
+            return NAME_None;
+        }
+    }
+    return NAME_None;
+}
@@ -0,0 +1,207 @@
+#include "RiftlineTelemetryWire.h"
+
+#include "Misc/Compression.h"
+#include "RiftlineTelemetry.h"
+#include "RiftlineTelemetryPipeline.h"
+
+namespace RiftlineTelemetryWire
+{
+    const TCHAR* JsonContentType = TEXT("application/json");
+    const TCHAR* BinaryContentType = TEXT("application/vnd.riftline.telemetry+bin");
+    const TCHAR* HeartbeatBinaryContentType = TEXT("application/vnd.riftline.heartbeat+bin");
+}
+
+namespace
+{
+    constexpr uint8 BatchMagic[4] = { 'R', 'L', 'T', '1' };
+    constexpr uint8 HeartbeatMagic[4] = { 'R', 'L', 'H', '1' };
+
+    void WriteVarint(TArray<uint8>& Out, uint64 Value)
+    {
+        while (Value >= 0x80)
+        {
+            Out.Add(static_cast<uint8>(Value | 0x80));
+            Value >>= 7;
+        }
+        Out.Add(static_cast<uint8>(Value));
+    }
+
+    void WriteSignedVarint(TArray<uint8>& Out, int64 Value)
+    {
+        WriteVarint(Out, (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63));
+    }
+
+    void WriteUtf8(TArray<uint8>& Out, const FString& Value)
+    {
+        const FTCHARToUTF8 Utf8(*Value);
+        WriteVarint(Out, static_cast<uint64>(Utf8.Length()));
+        Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    }
+
+    void WriteFloat(TArray<uint8>& Out, float Value)
+    {
+        uint32 Bits = 0;
+        FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+        Bits = INTEL_ORDER32(Bits);
+        Out.Append(reinterpret_cast<const uint8*>(&Bits), sizeof(Bits));
+    }
+
+    class FStringDictionary
+    {
+    public:
+        uint32 Intern(FName Name)
+        {
+            if (const uint32* Existing = Indices.Find(Name))
+            {
+                return *Existing;
+            }
+            const uint32 Index = static_cast<uint32>(Entries.Add(Name.ToString()));
+            Indices.Add(Name, Index);
+            return Index;
+        }
+
+        const TArray<FString>& GetEntries() const { return Entries; }
+
+    private:
+        TMap<FName, uint32> Indices;
+        TArray<FString> Entries;
+    };
+
+    FName ResolveNameValue(const FRiftlineTelemetryField& Field, FString& Scratch)
+    {
+        if (Field.Type == ERiftlineTelemetryValueType::Name)
+        {
+            return Field.NameValue;
+        }
+        Scratch.Reset();
+        FRiftlineTelemetrySchemaRegistry::Get().AppendEnumEntryName(Scratch, Field.EnumType, Field.IntValue);
+        return FName(*Scratch);
+    }
+
+    void AppendJsonBatchFields(FString& Out, uint64 Dropped, const TArray<FRiftlineTelemetryRecord>& Records)
+    {
+        Out.Appendf(TEXT("\"dropped\":%llu,\"events\":["), Dropped);
+        for (int32 Index = 0; Index < Records.Num(); ++Index)
+        {
+            if (Index > 0)
+            {
+                Out.AppendChar(TEXT(','));
+            }
+            Records[Index].Event.AppendJson(Out, Records[Index].TimestampMs, Records[Index].ShardId);
+        }
+        Out.AppendChar(TEXT(']'));
+    }
+}
+
+void RiftlineTelemetryWire::EncodeJsonBatch(FString& Out, const FString& PlayerId, uint64 Dropped, const TArray<FRiftlineTelemetryRecord>& Records)
+{
+    Out.Reset();
+    Out += TEXT("{\"playerId\":\"");
+    RiftlineTelemetry::AppendJsonEscaped(Out, PlayerId);
+    Out += TEXT("\",");
+    AppendJsonBatchFields(Out, Dropped, Records);
+    Out.AppendChar(TEXT('}'));
+}
+
+void RiftlineTelemetryWire::EncodeJsonHeartbeat(FString& Out, int32 ShardId, const FString& PlayerId, uint64 Dropped, const TArray<FRiftlineTelemetryRecord>& Records)
+{
+    Out.Reset();
+    Out += TEXT("{\"playerId\":\"");
+    RiftlineTelemetry::AppendJsonEscaped(Out, PlayerId);
+    Out.Appendf(TEXT("\",\"shardId\":%d"), ShardId);
+    if (Records.Num() > 0)
+    {
+        Out.AppendChar(TEXT(','));
+        AppendJsonBatchFields(Out, Dropped, Records);
+    }
+    Out.AppendChar(TEXT('}'));
+}
+
+void RiftlineTelemetryWire::EncodeBinaryBatch(TArray<uint8>& Out, const FString& PlayerId, uint64 Dropped, const TArray<FRiftlineTelemetryRecord>& Records)
+{
+    FStringDictionary Dictionary;
+    FString Scratch;
+
+    // Events are written first so the dictionary is complete before the header is assembled.
+    TArray<uint8> Body;
+    Body.Reserve(Records.Num() * 16);
+    WriteVarint(Body, static_cast<uint64>(Records.Num()));
+
+    int64 PreviousTimestamp = 0;
+    for (const FRiftlineTelemetryRecord& Record : Records)
+    {
+        WriteVarint(Body, Dictionary.Intern(Record.Event.GetName()));
+        WriteSignedVarint(Body, Record.TimestampMs - PreviousTimestamp);
+        WriteSignedVarint(Body, Record.ShardId);
+        PreviousTimestamp = Record.TimestampMs;
+
+        const auto& Fields = Record.Event.GetFields();
+        WriteVarint(Body, static_cast<uint64>(Fields.Num()));
+        for (const FRiftlineTelemetryField& Field : Fields)
+        {
+            WriteVarint(Body, Dictionary.Intern(Field.Key));
+            switch (Field.Type)
+            {
+            case ERiftlineTelemetryValueType::Int:
+                Body.Add(static_cast<uint8>(ERiftlineTelemetryValueType::Int));
+                WriteSignedVarint(Body, Field.IntValue);
+                break;
+            case ERiftlineTelemetryValueType::Float:
+                Body.Add(static_cast<uint8>(ERiftlineTelemetryValueType::Float));
+                WriteFloat(Body, static_cast<float>(Field.FloatValue));
+                break;
+            case ERiftlineTelemetryValueType::Bool:
+                Body.Add(static_cast<uint8>(ERiftlineTelemetryValueType::Bool));
+                Body.Add(Field.bBoolValue ? 1 : 0);
+                break;
+            case ERiftlineTelemetryValueType::Name:
+            case ERiftlineTelemetryValueType::Enum:
+                Body.Add(static_cast<uint8>(ERiftlineTelemetryValueType::Name));
+                WriteVarint(Body, Dictionary.Intern(ResolveNameValue(Field, Scratch)));
+                break;
+            case ERiftlineTelemetryValueType::String:
+                Body.Add(static_cast<uint8>(ERiftlineTelemetryValueType::String));
+                WriteUtf8(Body, Field.StringValue);
+                break;
+            }
+        }
+    }
+
+    Out.Reset(Body.Num() + 256);
+    Out.Append(BatchMagic, UE_ARRAY_COUNT(BatchMagic));
+    WriteUtf8(Out, PlayerId);
+    WriteVarint(Out, Dropped);
+    WriteVarint(Out, static_cast<uint64>(Dictionary.GetEntries().Num()));
+    for (const FString& Entry : Dictionary.GetEntries())
+    {
+        WriteUtf8(Out, Entry);
+    }
+    Out.Append(Body);
+}
+
+void RiftlineTelemetryWire::EncodeBinaryHeartbeat(TArray<uint8>& Out, int32 ShardId, const FString& PlayerId, uint64 Dropped, const TArray<FRiftlineTelemetryRecord>& Records)
+{
+    TArray<uint8> Batch;
+    if (Records.Num() > 0)
+    {
+        EncodeBinaryBatch(Batch, PlayerId, Dropped, Records);
+    }
+
+    Out.Reset(Batch.Num() + 8);
+    Out.Append(HeartbeatMagic, UE_ARRAY_COUNT(HeartbeatMagic));
+    WriteSignedVarint(Out, ShardId);
+    Out.Append(Batch);
+}
+
+bool RiftlineTelemetryWire::Compress(TArray<uint8>& Out, const uint8* Source, int32 SourceSize)
+{
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, SourceSize);
+    Out.SetNumUninitialized(CompressedSize);
+    if (!FCompression::CompressMemory(NAME_Gzip, Out.GetData(), CompressedSize, Source, SourceSize))
+    {
+        Out.Reset();
+        return false;
+    }
+    Out.SetNum(CompressedSize);
+    return true;
+}
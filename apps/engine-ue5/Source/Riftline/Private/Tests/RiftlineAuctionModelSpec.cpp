@@ -0,0 +1,73 @@
+#include "Misc/AutomationTest.h"
+#include "RiftlineAuctionModel.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineAuctionModelSpec, "Riftline.AuctionModel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    URiftlineAuctionModel* Model = nullptr;
+    FDateTime Now;
+
+    FRiftlineAuctionRow MakeRow(int32 AuctionId, int32 EndsInSeconds, const TCHAR* Price) const
+    {
+        FRiftlineAuctionRow Row;
+        Row.AuctionId = AuctionId;
+        Row.Title = FString::Printf(TEXT("Lot %d"), AuctionId);
+        Row.PayToken = TEXT("RFT");
+        Row.Price = Price;
+        Row.EndsAt = Now + FTimespan::FromSeconds(EndsInSeconds);
+        return Row;
+    }
+END_DEFINE_SPEC(FRiftlineAuctionModelSpec)
+
+void FRiftlineAuctionModelSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Model = NewObject<URiftlineAuctionModel>();
+        Now = FDateTime::UtcNow();
+        Model->Upsert({ MakeRow(1, 300, TEXT("10.00")), MakeRow(2, 100, TEXT("20.00")) });
+    });
+
+    It("orders listings by end time", [this]()
+    {
+        TestEqual(TEXT("Count"), Model->Num(), 2);
+        TestEqual(TEXT("First"), Model->GetItems()[0]->GetRow().AuctionId, 2);
+    });
+
+    It("reports an upsert of an unchanged row as no change", [this]()
+    {
+        const FRiftlineAuctionChangeSet Changes = Model->Upsert({ MakeRow(1, 300, TEXT("10.00")) });
+        TestTrue(TEXT("Empty"), Changes.IsEmpty());
+    });
+
+    It("updates a row in place without touching the order", [this]()
+    {
+        URiftlineAuctionItem* Before = Model->FindItem(1);
+        const FRiftlineAuctionChangeSet Changes = Model->Upsert({ MakeRow(1, 300, TEXT("12.00")) });
+        TestEqual(TEXT("Updated"), Changes.Updated.Num(), 1);
+        TestFalse(TEXT("Order changed"), Changes.bOrderChanged);
+        TestTrue(TEXT("Same item"), Model->FindItem(1) == Before);
+        TestEqual(TEXT("Price"), Before->GetRow().Price, FString(TEXT("12.00")));
+    });
+
+    It("diffs a snapshot into adds, updates and removals", [this]()
+    {
+        const FRiftlineAuctionChangeSet Changes = Model->ReplaceAll({ MakeRow(2, 100, TEXT("25.00")), MakeRow(3, 50, TEXT("5.00")) });
+        TestEqual(TEXT("Added"), Changes.Added, TArray<int32>({ 3 }));
+        TestEqual(TEXT("Updated"), Changes.Updated, TArray<int32>({ 2 }));
+        TestEqual(TEXT("Removed"), Changes.Removed, TArray<int32>({ 1 }));
+        TestEqual(TEXT("First"), Model->GetItems()[0]->GetRow().AuctionId, 3);
+    });
+
+    It("derives the end time from legacy countdowns", [this]()
+    {
+        FRiftlineAuctionRow Legacy;
+        Legacy.AuctionId = 4;
+        Legacy.SecondsRemaining = 60;
+        Model->Upsert({ Legacy });
+        const int32 Remaining = Model->FindItem(4)->GetSecondsRemainingAt(FDateTime::UtcNow());
+        TestTrue(TEXT("Remaining"), Remaining > 55 && Remaining <= 60);
+    });
+}
+
+#endif
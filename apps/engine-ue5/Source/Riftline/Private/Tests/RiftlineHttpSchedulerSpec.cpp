@@ -0,0 +1,65 @@
+#include "Misc/AutomationTest.h"
+#include "RiftlineHttpScheduler.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineHttpSchedulerSpec, "Riftline.Http", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FRiftlineHttpSchedulerSpec)
+
+void FRiftlineHttpSchedulerSpec::Define()
+{
+    It("backs off exponentially up to the cap", [this]()
+    {
+        TestEqual(TEXT("First, low jitter"), RiftlineHttp::ComputeBackoff(0, 1.f, 30.f, 0.f), 0.5f);
+        TestEqual(TEXT("Third, high jitter"), RiftlineHttp::ComputeBackoff(2, 1.f, 30.f, 1.f), 4.f);
+        TestEqual(TEXT("Capped"), RiftlineHttp::ComputeBackoff(12, 1.f, 30.f, 1.f), 30.f);
+    });
+
+    Describe("ParseRetryAfter", [this]()
+    {
+        const FDateTime Now(2030, 1, 1, 12, 0, 0);
+
+        It("reads delta seconds", [this, Now]()
+        {
+            float Seconds = 0.f;
+            TestTrue(TEXT("Parsed"), RiftlineHttp::ParseRetryAfter(TEXT(" 120 "), Now, Seconds));
+            TestEqual(TEXT("Seconds"), Seconds, 120.f);
+        });
+
+        It("reads an HTTP date relative to now", [this, Now]()
+        {
+            float Seconds = 0.f;
+            TestTrue(TEXT("Parsed"), RiftlineHttp::ParseRetryAfter(TEXT("Tue, 01 Jan 2030 12:00:45 GMT"), Now, Seconds));
+            TestEqual(TEXT("Seconds"), Seconds, 45.f);
+
+            TestTrue(TEXT("Past date"), RiftlineHttp::ParseRetryAfter(TEXT("Tue, 01 Jan 2030 11:00:00 GMT"), Now, Seconds));
+            TestEqual(TEXT("Clamped"), Seconds, 0.f);
+        });
+
+        It("rejects empty and malformed values", [this, Now]()
+        {
+            float Seconds = 0.f;
+            TestFalse(TEXT("Empty"), RiftlineHttp::ParseRetryAfter(FString(), Now, Seconds));
+            TestFalse(TEXT("Garbage"), RiftlineHttp::ParseRetryAfter(TEXT("soon"), Now, Seconds));
+        });
+    });
+
+    It("retries only transient failures", [this]()
+    {
+        TestTrue(TEXT("No response"), RiftlineHttp::IsRetryable(false, 0));
+        TestTrue(TEXT("429"), RiftlineHttp::IsRetryable(true, 429));
+        TestTrue(TEXT("503"), RiftlineHttp::IsRetryable(true, 503));
+        TestFalse(TEXT("200"), RiftlineHttp::IsRetryable(true, 200));
+        TestFalse(TEXT("400"), RiftlineHttp::IsRetryable(true, 400));
+        TestFalse(TEXT("501"), RiftlineHttp::IsRetryable(true, 501));
+    });
+
+    It("keys hosts by authority", [this]()
+    {
+        TestEqual(TEXT("Port kept"), RiftlineHttp::GetHost(TEXT("http://LocalHost:8080/players/heartbeat")), FString(TEXT("localhost:8080")));
+        TestEqual(TEXT("Query"), RiftlineHttp::GetHost(TEXT("https://api.example.com?x=1")), FString(TEXT("api.example.com")));
+        TestEqual(TEXT("No scheme"), RiftlineHttp::GetHost(TEXT("api.example.com/v1")), FString(TEXT("api.example.com")));
+    });
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include "Misc/AutomationTest.h"
+#include "RiftlineJsonDecoder.h"
+#include "RiftlineTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineJsonDecoderSpec, "Riftline.Json", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FRiftlineJsonDecoderSpec)
+
+void FRiftlineJsonDecoderSpec::Define()
+{
+    It("decodes an auction page as the gateway serializes it", [this]()
+    {
+        // GET /auctions: Prisma DateTimes as ISO strings, Decimals as strings.
+        const FString Json = TEXT("[{\"id\":7,\"asset\":\"0xcar\",\"tokenId\":3,\"payToken\":\"RFT\",\"startTime\":\"2029-12-31T12:00:00.000Z\","
+            "\"endTime\":\"2030-01-01T12:00:00.000Z\",\"leaseSeconds\":86400,\"reserve\":\"10\",\"minIncrement\":\"1\",\"highestBidder\":null,"
+            "\"highestBid\":\"125.5\",\"settled\":false,\"leaseEnd\":null,\"updatedAt\":\"2029-12-31T12:05:00.000Z\"},"
+            "{\"id\":8,\"asset\":\"0xhouse\",\"tokenId\":4,\"payToken\":\"RFT\",\"startTime\":\"2029-12-31T13:00:00.000Z\","
+            "\"endTime\":\"2030-01-01T13:00:00.000Z\",\"leaseSeconds\":3600,\"reserve\":\"0\",\"minIncrement\":\"1\",\"highestBidder\":\"0xbidder\","
+            "\"highestBid\":\"0\",\"settled\":false,\"leaseEnd\":null,\"updatedAt\":\"2029-12-31T13:00:00.000Z\"}]");
+
+        TArray<FRiftlineAuctionRow> Rows;
+        TestTrue(TEXT("Decoded"), RiftlineJson::Decode(Json, Rows));
+        if (TestEqual(TEXT("Rows"), Rows.Num(), 2))
+        {
+            TestEqual(TEXT("Id"), Rows[0].AuctionId, 7);
+            TestEqual(TEXT("Asset"), Rows[0].AssetType, FString(TEXT("0xcar")));
+            TestEqual(TEXT("Title"), Rows[0].Title, FString(TEXT("0xcar")));
+            TestEqual(TEXT("Pay token"), Rows[0].PayToken, FString(TEXT("RFT")));
+            TestEqual(TEXT("Price"), Rows[0].Price, FString(TEXT("125.5")));
+            TestEqual(TEXT("Ends"), Rows[0].EndsAt.ToUnixTimestamp(), static_cast<int64>(1893499200));
+            TestEqual(TEXT("Second ends"), Rows[1].EndsAt.ToUnixTimestamp(), static_cast<int64>(1893502800));
+        }
+    });
+
+    It("accepts Unix millisecond end times and skips unknown objects", [this]()
+    {
+        TArray<FRiftlineAuctionRow> Rows;
+        TestTrue(TEXT("Decoded"), RiftlineJson::Decode(TEXT("[{\"id\":8,\"asset\":\"0xhouse\",\"endTime\":1893499200000,\"highestBid\":\"0\",\"meta\":{\"tags\":[1,2]}}]"), Rows));
+        if (TestEqual(TEXT("Rows"), Rows.Num(), 1))
+        {
+            TestEqual(TEXT("Ends from Unix ms"), Rows[0].EndsAt.ToUnixTimestamp(), static_cast<int64>(1893499200));
+        }
+    });
+
+    It("keeps free-form objects in string fields as compact JSON", [this]()
+    {
+        TArray<FRiftlineShardStatus> Shards;
+        TestTrue(TEXT("Decoded"), RiftlineJson::Decode(TEXT("[{\"id\":2,\"name\":\"Harbor\",\"ruleset\":{\"pvp\":true,\"zones\":[\"a\"]},\"population\":\"41\"}]"), Shards));
+        if (TestEqual(TEXT("Shards"), Shards.Num(), 1))
+        {
+            TestEqual(TEXT("Id"), Shards[0].ShardId, 2);
+            TestEqual(TEXT("Name"), Shards[0].Name, FString(TEXT("Harbor")));
+            TestEqual(TEXT("Population from string"), Shards[0].Population, 41);
+            TestEqual(TEXT("Ruleset"), Shards[0].Ruleset, FString(TEXT("{\"pvp\":true,\"zones\":[\"a\"]}")));
+        }
+    });
+
+    It("fills nested structs and leaves null or missing fields alone", [this]()
+    {
+        const FString Json = TEXT("{\"id\":\"p-1\",\"wallet\":\"0xabc\",\"username\":\"vex\",\"shardId\":2,"
+            "\"shard\":{\"id\":2,\"name\":\"Harbor\",\"population\":9},\"softBalance\":\"99999999999\",\"wantedUntil\":null}");
+
+        FRiftlineSessionProfile Profile;
+        Profile.Compliance.RiskScore = 12;
+        TestTrue(TEXT("Profile"), RiftlineJson::Decode(Json, Profile));
+        TestEqual(TEXT("Player"), Profile.PlayerId, FString(TEXT("p-1")));
+        TestEqual(TEXT("Name"), Profile.DisplayName, FString(TEXT("vex")));
+        TestEqual(TEXT("Shard"), Profile.CurrentShard.ShardId, 2);
+        TestEqual(TEXT("Population"), Profile.CurrentShard.Population, 9);
+        TestEqual(TEXT("Untouched"), Profile.Compliance.RiskScore, 12);
+
+        FRiftlineWalletView Wallet;
+        TestTrue(TEXT("Wallet"), RiftlineJson::Decode(Json, Wallet));
+        TestEqual(TEXT("Address"), Wallet.Address, FString(TEXT("0xabc")));
+        TestEqual(TEXT("Balance saturates"), Wallet.SoftCurrency, MAX_int32);
+        TestEqual(TEXT("Shard id"), Wallet.ShardId, 2);
+    });
+
+    It("reads booleans without their prefix", [this]()
+    {
+        FRiftlineComplianceState Compliance;
+        TestTrue(TEXT("Decoded"), RiftlineJson::Decode(TEXT("{\"kycVerified\":true,\"amlClear\":false,\"riskScore\":35}"), Compliance));
+        TestTrue(TEXT("Kyc"), Compliance.bKycVerified);
+        TestFalse(TEXT("Aml"), Compliance.bAmlClear);
+        TestEqual(TEXT("Risk"), Compliance.RiskScore, 35);
+    });
+
+    It("rejects malformed and mismatched documents", [this]()
+    {
+        FRiftlineShardStatus Shard;
+        TestFalse(TEXT("Truncated"), RiftlineJson::Decode(TEXT("{\"id\":2,\"name\":"), Shard));
+        TestFalse(TEXT("Array for object"), RiftlineJson::Decode(TEXT("[]"), Shard));
+
+        TArray<FRiftlineShardStatus> Shards;
+        TestFalse(TEXT("Object for array"), RiftlineJson::Decode(TEXT("{\"id\":2}"), Shards));
+    });
+}
+
+#endif
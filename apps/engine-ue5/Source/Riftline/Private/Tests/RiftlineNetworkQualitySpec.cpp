@@ -0,0 +1,89 @@
+#include "Misc/AutomationTest.h"
+#include "RiftlineHttpScheduler.h"
+#include "RiftlineNetworkQuality.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineNetworkQualitySpec, "Riftline.Network", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    FRiftlineHttpResult MakeResult(float LatencyMs, int32 Code = 200) const
+    {
+        FRiftlineHttpResult Result;
+        Result.bConnected = Code != 0;
+        Result.Code = Code;
+        Result.LatencyMs = LatencyMs;
+        return Result;
+    }
+END_DEFINE_SPEC(FRiftlineNetworkQualitySpec)
+
+void FRiftlineNetworkQualitySpec::Define()
+{
+    It("estimates the offset from the lowest-delay clock sample", [this]()
+    {
+        FRiftlineNetworkQuality Quality;
+        TestFalse(TEXT("Unsynced"), Quality.HasClockSync());
+
+        // Server 500 ms ahead; a symmetric 40 ms round trip with 10 ms of handling.
+        TestTrue(TEXT("Accepted"), Quality.RecordClockSample(1000, 1520, 1530, 1050));
+        TestEqual(TEXT("Offset"), Quality.GetSnapshot().ClockOffsetMs, 500.f);
+        TestEqual(TEXT("Error"), Quality.GetSnapshot().ClockErrorMs, 20.f);
+
+        // Queued on the way out: 400 ms of extra delay skews the sample, but the earlier one still wins.
+        TestTrue(TEXT("Queued"), Quality.RecordClockSample(2000, 2920, 2930, 2450));
+        TestEqual(TEXT("Offset kept"), Quality.GetSnapshot().ClockOffsetMs, 500.f);
+
+        TestFalse(TEXT("Inconsistent"), Quality.RecordClockSample(3000, 3500, 3600, 3050));
+    });
+
+    It("reports round-trip percentiles and the failure rate", [this]()
+    {
+        FRiftlineNetworkQuality Quality;
+        for (int32 Index = 1; Index <= 20; ++Index)
+        {
+            Quality.RecordAttempt(TEXT("api"), MakeResult(Index * 10.f));
+        }
+        Quality.RecordAttempt(TEXT("api"), MakeResult(0.f, 0));
+        Quality.RecordAttempt(TEXT("api"), MakeResult(30.f, 503));
+        Quality.RecordAttempt(TEXT("api"), MakeResult(30.f, 404));
+
+        const FRiftlineNetworkQualitySnapshot Snapshot = Quality.GetSnapshot();
+        TestEqual(TEXT("Samples"), Snapshot.Samples, 22);
+        TestEqual(TEXT("P50"), Snapshot.RttP50Ms, 90.f);
+        TestEqual(TEXT("P95"), Snapshot.RttP95Ms, 190.f);
+        TestEqual(TEXT("Failure rate"), Snapshot.FailureRate, 2.f / 23.f);
+
+        TMap<FString, FRiftlineNetworkHostWindow> Windows;
+        Quality.ConsumeWindow(Windows);
+        if (TestTrue(TEXT("Host"), Windows.Contains(TEXT("api"))))
+        {
+            TestEqual(TEXT("Requests"), Windows[TEXT("api")].Requests, 23);
+            TestEqual(TEXT("Failures"), Windows[TEXT("api")].Failures, 2);
+        }
+    });
+
+    It("removes server handling time from stamped responses", [this]()
+    {
+        FRiftlineNetworkQuality Quality;
+        FRiftlineHttpResult Result = MakeResult(80.f);
+        Result.SentAtMs = 10000;
+        Result.ServerReceivedAtMs = 10230;
+        Result.ServerDurationMs = 40.f;
+        Quality.RecordAttempt(TEXT("api"), Result);
+
+        const FRiftlineNetworkQualitySnapshot Snapshot = Quality.GetSnapshot();
+        TestTrue(TEXT("Synced"), Snapshot.bClockSynced);
+        TestEqual(TEXT("Round trip"), Snapshot.RttP50Ms, 40.f);
+        TestEqual(TEXT("Offset"), Snapshot.ClockOffsetMs, 210.f);
+    });
+
+    It("reads Server-Timing durations", [this]()
+    {
+        float Ms = 0.f;
+        TestTrue(TEXT("Single"), RiftlineNetwork::ParseServerTiming(TEXT("app;dur=12.5"), Ms));
+        TestEqual(TEXT("Value"), Ms, 12.5f);
+        TestTrue(TEXT("First of several"), RiftlineNetwork::ParseServerTiming(TEXT("db;dur=3, app;dur=9"), Ms));
+        TestEqual(TEXT("First value"), Ms, 3.f);
+        TestFalse(TEXT("No duration"), RiftlineNetwork::ParseServerTiming(TEXT("cache;desc=hit"), Ms));
+    });
+}
+
+#endif
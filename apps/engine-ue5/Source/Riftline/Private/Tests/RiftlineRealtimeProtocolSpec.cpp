@@ -0,0 +1,102 @@
+#include "Misc/AutomationTest.h"
+#include "Misc/Base64.h"
+#include "RiftlineRealtimeProtocol.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineRealtimeProtocolSpec, "Riftline.Realtime", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    FString Encode(const FString& Json) const
+    {
+        return FBase64::Encode(Json);
+    }
+END_DEFINE_SPEC(FRiftlineRealtimeProtocolSpec)
+
+void FRiftlineRealtimeProtocolSpec::Define()
+{
+    Describe("DecodeEnvelope", [this]()
+    {
+        It("decodes a wanted broadcast from the shard match", [this]()
+        {
+            const FString Data = Encode(TEXT("{\"userId\":\"u-1\",\"wanted\":{\"level\":2,\"heat\":140,\"expiresAt\":1900000000500}}"));
+            FRiftlineRealtimeEnvelope Envelope;
+            TestTrue(TEXT("Decoded"), RiftlineRealtime::DecodeEnvelope(FString::Printf(TEXT("{\"match_data\":{\"match_id\":\"m.1\",\"op_code\":\"2\",\"data\":\"%s\"}}"), *Data), Envelope));
+            TestTrue(TEXT("Type"), Envelope.Type == FRiftlineRealtimeEnvelope::EType::MatchData);
+            if (TestEqual(TEXT("Updates"), Envelope.Updates.Num(), 1))
+            {
+                const FRiftlineRealtimeUpdate& Update = Envelope.Updates[0];
+                TestEqual(TEXT("User"), Update.UserId, FString(TEXT("u-1")));
+                TestTrue(TEXT("Level"), Update.Wanted.Level == ERiftlineWantedLevel::Medium);
+                TestEqual(TEXT("Heat"), Update.Wanted.Heat, 1.f);
+                TestEqual(TEXT("Expires"), Update.Wanted.ExpiresAt.ToUnixTimestamp(), static_cast<int64>(1900000000));
+            }
+        });
+
+        It("decodes state notifications by subject", [this]()
+        {
+            const FString Message = TEXT("{\"notifications\":{\"notifications\":["
+                "{\"id\":\"n1\",\"subject\":\"compliance\",\"content\":\"{\\\"kycStatus\\\":\\\"verified\\\",\\\"amlStatus\\\":\\\"flagged\\\",\\\"riskScore\\\":35}\",\"create_time\":\"2030-01-01T00:00:00Z\"},"
+                "{\"id\":\"n2\",\"subject\":\"chat\",\"content\":\"{}\"}]}}");
+            FRiftlineRealtimeEnvelope Envelope;
+            TestTrue(TEXT("Decoded"), RiftlineRealtime::DecodeEnvelope(Message, Envelope));
+            if (TestEqual(TEXT("Updates"), Envelope.Updates.Num(), 1))
+            {
+                const FRiftlineRealtimeUpdate& Update = Envelope.Updates[0];
+                TestTrue(TEXT("Kind"), Update.Kind == ERiftlineRealtimeUpdate::Compliance);
+                TestTrue(TEXT("Kyc"), Update.Compliance.bKycVerified);
+                TestFalse(TEXT("Aml"), Update.Compliance.bAmlClear);
+                TestEqual(TEXT("Risk"), Update.Compliance.RiskScore, 35);
+                TestEqual(TEXT("Created"), Update.CreatedAt.GetYear(), 2030);
+            }
+        });
+
+        It("recognises pongs and errors", [this]()
+        {
+            FRiftlineRealtimeEnvelope Pong;
+            RiftlineRealtime::DecodeEnvelope(TEXT("{\"cid\":\"7\",\"pong\":{}}"), Pong);
+            TestTrue(TEXT("Pong"), Pong.Type == FRiftlineRealtimeEnvelope::EType::Pong);
+            TestEqual(TEXT("Cid"), Pong.Cid, FString(TEXT("7")));
+
+            FRiftlineRealtimeEnvelope Error;
+            RiftlineRealtime::DecodeEnvelope(TEXT("{\"error\":{\"code\":3,\"message\":\"bad\"}}"), Error);
+            TestTrue(TEXT("Error"), Error.Type == FRiftlineRealtimeEnvelope::EType::Error);
+            TestEqual(TEXT("Message"), Error.Error, FString(TEXT("bad")));
+        });
+    });
+
+    It("counts every listed notification and reads the cursor", [this]()
+    {
+        const FString Body = TEXT("{\"notifications\":["
+            "{\"id\":\"n1\",\"subject\":\"compliance\",\"content\":\"{\\\"kycStatus\\\":\\\"verified\\\"}\"},"
+            "{\"id\":\"n2\",\"subject\":\"chat\",\"content\":\"{}\"}],\"cacheable_cursor\":\"c-2\"}");
+        FRiftlineRealtimeEnvelope Envelope;
+        FString Cursor;
+        int32 Listed = 0;
+        TestTrue(TEXT("Decoded"), RiftlineRealtime::DecodeNotificationList(Body, Envelope, Cursor, Listed));
+        TestEqual(TEXT("Listed"), Listed, 2);
+        TestEqual(TEXT("Updates"), Envelope.Updates.Num(), 1);
+        TestEqual(TEXT("Cursor"), Cursor, FString(TEXT("c-2")));
+    });
+
+    It("reads the shard match id", [this]()
+    {
+        FString MatchId;
+        TestTrue(TEXT("Decoded"), RiftlineRealtime::DecodeShardMatch(TEXT("{\"matchId\":\"m-1.nakama\"}"), MatchId));
+        TestEqual(TEXT("Match"), MatchId, FString(TEXT("m-1.nakama")));
+        TestFalse(TEXT("Missing"), RiftlineRealtime::DecodeShardMatch(TEXT("{}"), MatchId));
+    });
+
+    It("reads the user and expiry from a session token", [this]()
+    {
+        FString Claims = FBase64::Encode(FString(TEXT("{\"uid\":\"u-9\",\"exp\":1900000000}")), EBase64Mode::UrlSafe);
+        Claims.RemoveFromEnd(TEXT("="));
+        Claims.RemoveFromEnd(TEXT("="));
+
+        FString UserId;
+        FDateTime ExpiresAt;
+        TestTrue(TEXT("Parsed"), RiftlineRealtime::ParseToken(TEXT("header.") + Claims + TEXT(".signature"), UserId, ExpiresAt));
+        TestEqual(TEXT("User"), UserId, FString(TEXT("u-9")));
+        TestEqual(TEXT("Expires"), ExpiresAt.ToUnixTimestamp(), static_cast<int64>(1900000000));
+    });
+}
+
+#endif
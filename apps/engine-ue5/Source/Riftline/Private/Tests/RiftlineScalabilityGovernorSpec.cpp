@@ -0,0 +1,193 @@
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "RiftlineDeviceState.h"
+#include "RiftlinePerformanceMonitor.h"
+#include "RiftlineScalabilityGovernor.h"
+#include "Scalability.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineScalabilityGovernorSpec, "Riftline.Governor", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    static constexpr int32 DownWindows = 2;
+    static constexpr int32 UpWindows = 3;
+
+    TArray<FRiftlineGovernorStep> Ladder;
+
+    /** Seconds since the script started; each Evaluate below is one window and advances it by one. */
+    double ScriptSeconds = 0.0;
+    TUniquePtr<FRiftlineScriptedDeviceStateProvider> Device;
+    TUniquePtr<FRiftlineScalabilityGovernor> Governor;
+
+    /** Applying a rung changes engine-wide settings, which are put back after each case. */
+    Scalability::FQualityLevels SavedLevels;
+    float SavedMaxFps = 0.f;
+    float SavedScreenPercentage = 100.f;
+
+    struct FKeyframe
+    {
+        double Seconds;
+        ERiftlineThermalState Thermal;
+    };
+
+    void Script(const TArray<FKeyframe>& Keyframes)
+    {
+        for (const FKeyframe& Keyframe : Keyframes)
+        {
+            FRiftlineDeviceState State;
+            State.Thermal = Keyframe.Thermal;
+            Device->AddKeyframe(Keyframe.Seconds, State);
+        }
+    }
+
+    /** A 60 fps window: FrameP90 is wall time including the cap, WorkloadP90 the busiest thread's own cost. */
+    static FRiftlineFrameTimeSummary MakeWindow(float FrameP90Ms, float WorkloadP90Ms)
+    {
+        FRiftlineFrameTimeSummary Summary;
+        Summary.Frames = 300;
+        Summary.Timers[static_cast<int32>(ERiftlineFrameTimer::Frame)].P90Ms = FrameP90Ms;
+        Summary.Timers[static_cast<int32>(ERiftlineFrameTimer::GameThread)].P90Ms = WorkloadP90Ms;
+        return Summary;
+    }
+
+    static FRiftlineFrameTimeSummary Pressure() { return MakeWindow(25.f, 24.f); }
+    static FRiftlineFrameTimeSummary Headroom() { return MakeWindow(16.7f, 8.f); }
+
+    ERiftlineGovernorReason Evaluate(const FRiftlineFrameTimeSummary& Frames)
+    {
+        const ERiftlineGovernorReason Reason = Governor->Evaluate(Device->Sample(), Frames);
+        ScriptSeconds += 1.0;
+        return Reason;
+    }
+END_DEFINE_SPEC(FRiftlineScalabilityGovernorSpec)
+
+void FRiftlineScalabilityGovernorSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Ladder.Reset();
+        for (const int32 Level : { 3, 2, 2, 1, 0 })
+        {
+            Ladder.AddDefaulted_GetRef().ScalabilityLevel = Level;
+        }
+    });
+
+    It("starts at the first rung the device profile's quality allows", [this]()
+    {
+        TestEqual(TEXT("Epic"), FRiftlineScalabilityGovernor::FindStartStep(Ladder, 3), 0);
+        TestEqual(TEXT("High"), FRiftlineScalabilityGovernor::FindStartStep(Ladder, 2), 1);
+        TestEqual(TEXT("Medium"), FRiftlineScalabilityGovernor::FindStartStep(Ladder, 1), 3);
+        TestEqual(TEXT("Low"), FRiftlineScalabilityGovernor::FindStartStep(Ladder, 0), 4);
+    });
+
+    It("falls back to the lowest rung when no rung is low enough", [this]()
+    {
+        TestEqual(TEXT("Below low"), FRiftlineScalabilityGovernor::FindStartStep(Ladder, -1), 4);
+        TestEqual(TEXT("Empty ladder"), FRiftlineScalabilityGovernor::FindStartStep(TArray<FRiftlineGovernorStep>(), 2), 0);
+    });
+
+    Describe("Evaluate", [this]()
+    {
+        BeforeEach([this]()
+        {
+            SavedLevels = Scalability::GetQualityLevels();
+            SavedMaxFps = GEngine ? GEngine->GetMaxFPS() : 0.f;
+            if (const IConsoleVariable* ScreenPercentage = IConsoleManager::Get().FindConsoleVariable(TEXT("r.ScreenPercentage")))
+            {
+                SavedScreenPercentage = ScreenPercentage->GetFloat();
+            }
+
+            ScriptSeconds = 0.0;
+            Device = MakeUnique<FRiftlineScriptedDeviceStateProvider>();
+            Device->SetClock([this]() { return ScriptSeconds; });
+            Governor = MakeUnique<FRiftlineScalabilityGovernor>(Ladder, DownWindows, UpWindows);
+        });
+
+        AfterEach([this]()
+        {
+            Governor.Reset();
+            Device.Reset();
+
+            Scalability::SetQualityLevels(SavedLevels);
+            if (GEngine)
+            {
+                GEngine->SetMaxFPS(SavedMaxFps);
+            }
+            if (IConsoleVariable* ScreenPercentage = IConsoleManager::Get().FindConsoleVariable(TEXT("r.ScreenPercentage")))
+            {
+                ScreenPercentage->Set(SavedScreenPercentage, ECVF_SetByCode);
+            }
+        });
+
+        It("steps down after DownWindows windows under pressure", [this]()
+        {
+            Script({ { 0.0, ERiftlineThermalState::Nominal } });
+
+            TestTrue(TEXT("First window holds"), Evaluate(Pressure()) == ERiftlineGovernorReason::None);
+            TestEqual(TEXT("Step after one window"), Governor->GetCurrentStep(), 0);
+            TestTrue(TEXT("Second window steps"), Evaluate(Pressure()) == ERiftlineGovernorReason::FrameTime);
+            TestEqual(TEXT("Step after two windows"), Governor->GetCurrentStep(), 1);
+        });
+
+        It("steps up after UpWindows windows with headroom", [this]()
+        {
+            Script({ { 0.0, ERiftlineThermalState::Nominal } });
+            Evaluate(Pressure());
+            Evaluate(Pressure());
+
+            for (int32 Window = 1; Window < UpWindows; ++Window)
+            {
+                TestTrue(TEXT("Holds while the streak builds"), Evaluate(Headroom()) == ERiftlineGovernorReason::None);
+            }
+            TestEqual(TEXT("Step before the streak completes"), Governor->GetCurrentStep(), 1);
+            TestTrue(TEXT("Steps up"), Evaluate(Headroom()) == ERiftlineGovernorReason::Headroom);
+            TestEqual(TEXT("Step"), Governor->GetCurrentStep(), 0);
+        });
+
+        It("does not oscillate on alternating windows", [this]()
+        {
+            Script({ { 0.0, ERiftlineThermalState::Nominal } });
+            Evaluate(Pressure());
+            Evaluate(Pressure());
+
+            for (int32 Window = 0; Window < 12; ++Window)
+            {
+                Evaluate(Window % 2 == 0 ? Headroom() : Pressure());
+                TestEqual(TEXT("Step"), Governor->GetCurrentStep(), 1);
+            }
+
+            // A window within budget but without enough headroom for the rung above also breaks the streak.
+            Evaluate(Headroom());
+            Evaluate(Headroom());
+            Evaluate(MakeWindow(16.7f, 15.f));
+            Evaluate(Headroom());
+            TestEqual(TEXT("Step after a broken streak"), Governor->GetCurrentStep(), 1);
+        });
+
+        It("drops to the last rung at once on critical thermal state", [this]()
+        {
+            Script({ { 0.0, ERiftlineThermalState::Nominal }, { 1.0, ERiftlineThermalState::Critical } });
+
+            TestTrue(TEXT("Nominal"), Evaluate(Headroom()) == ERiftlineGovernorReason::None);
+            TestTrue(TEXT("Critical"), Evaluate(Headroom()) == ERiftlineGovernorReason::Thermal);
+            TestEqual(TEXT("Step"), Governor->GetCurrentStep(), Ladder.Num() - 1);
+        });
+
+        It("steps down under serious thermal state and holds while the device is warm", [this]()
+        {
+            Script({ { 0.0, ERiftlineThermalState::Serious }, { 2.0, ERiftlineThermalState::Fair } });
+
+            Evaluate(Headroom());
+            TestTrue(TEXT("Thermal pressure"), Evaluate(Headroom()) == ERiftlineGovernorReason::Thermal);
+            TestEqual(TEXT("Step"), Governor->GetCurrentStep(), 1);
+
+            for (int32 Window = 0; Window < UpWindows * 2; ++Window)
+            {
+                TestTrue(TEXT("Warm device holds"), Evaluate(Headroom()) == ERiftlineGovernorReason::None);
+            }
+            TestEqual(TEXT("Step while warm"), Governor->GetCurrentStep(), 1);
+        });
+    });
+}
+
+#endif
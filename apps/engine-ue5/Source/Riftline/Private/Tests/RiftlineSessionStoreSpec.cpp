@@ -0,0 +1,116 @@
+#include "Misc/AutomationTest.h"
+#include "RiftlineSessionStore.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineSessionStoreSpec, "Riftline.SessionStore", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    TUniquePtr<FRiftlineSessionStore> Store;
+    int32 Calls = 0;
+    ERiftlineSessionField Seen = ERiftlineSessionField::None;
+
+    void Watch(ERiftlineSessionField Fields)
+    {
+        Store->Subscribe(Fields, FRiftlineSessionChangeDelegate::CreateLambda([this](const FRiftlineSessionStore&, ERiftlineSessionField Changed)
+        {
+            ++Calls;
+            Seen |= Changed;
+        }));
+    }
+
+    FRiftlineShardStatus MakeShard(int32 Population) const
+    {
+        FRiftlineShardStatus Shard;
+        Shard.ShardId = 3;
+        Shard.Name = TEXT("shard-3");
+        Shard.Population = Population;
+        return Shard;
+    }
+END_DEFINE_SPEC(FRiftlineSessionStoreSpec)
+
+void FRiftlineSessionStoreSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Store = MakeUnique<FRiftlineSessionStore>();
+        Calls = 0;
+        Seen = ERiftlineSessionField::None;
+    });
+
+    AfterEach([this]()
+    {
+        Store.Reset();
+    });
+
+    It("coalesces a frame of changes into one dispatch per subscriber", [this]()
+    {
+        Store->Start();
+        Watch(ERiftlineSessionField::All);
+
+        Store->SetShard(MakeShard(10));
+        Store->SetShard(MakeShard(11));
+        FRiftlineWantedState Wanted;
+        Wanted.Heat = 0.5f;
+        Store->SetWanted(Wanted);
+        TestEqual(TEXT("Calls before flush"), Calls, 0);
+
+        Store->Flush();
+        TestEqual(TEXT("Calls"), Calls, 1);
+        TestTrue(TEXT("Fields"), Seen == (ERiftlineSessionField::Shard | ERiftlineSessionField::Wanted));
+        TestEqual(TEXT("Shard version"), Store->GetVersion(ERiftlineSessionField::Shard), 2u);
+        TestEqual(TEXT("Population"), Store->GetProfile().CurrentShard.Population, 11);
+    });
+
+    It("only wakes subscribers for the fields they asked for", [this]()
+    {
+        Watch(ERiftlineSessionField::Compliance);
+
+        Store->SetShard(MakeShard(10));
+        TestEqual(TEXT("Calls after shard"), Calls, 0);
+
+        FRiftlineComplianceState Compliance;
+        Compliance.RiskScore = 40;
+        Store->SetCompliance(Compliance);
+        TestEqual(TEXT("Calls after compliance"), Calls, 1);
+        TestTrue(TEXT("Fields"), Seen == ERiftlineSessionField::Compliance);
+    });
+
+    It("ignores writes that do not change a value", [this]()
+    {
+        Watch(ERiftlineSessionField::All);
+
+        FRiftlineSessionProfile Profile;
+        Profile.PlayerId = TEXT("p-1");
+        Profile.CurrentShard = MakeShard(10);
+        Store->SetProfile(Profile);
+        TestTrue(TEXT("Fields"), Seen == (ERiftlineSessionField::Identity | ERiftlineSessionField::Shard));
+
+        Store->SetProfile(Profile);
+        Store->SetShard(MakeShard(10));
+        TestEqual(TEXT("Calls"), Calls, 1);
+        TestEqual(TEXT("Identity version"), Store->GetVersion(ERiftlineSessionField::Identity), 1u);
+    });
+
+    It("holds subscriptions made during dispatch until the next change", [this]()
+    {
+        Store->Start();
+        Store->Subscribe(ERiftlineSessionField::Shard, FRiftlineSessionChangeDelegate::CreateLambda([this](const FRiftlineSessionStore&, ERiftlineSessionField)
+        {
+            // Enough to grow the subscriber list while this delegate is still executing.
+            for (int32 Index = 0; Index < 32; ++Index)
+            {
+                Watch(ERiftlineSessionField::Shard);
+            }
+        }));
+
+        Store->SetShard(MakeShard(10));
+        Store->Flush();
+        TestEqual(TEXT("Calls during dispatch"), Calls, 0);
+        TestEqual(TEXT("Subscribers"), Store->GetNumSubscribers(), 33);
+
+        Store->SetShard(MakeShard(11));
+        Store->Flush();
+        TestEqual(TEXT("Calls on next change"), Calls, 32);
+    });
+}
+
+#endif
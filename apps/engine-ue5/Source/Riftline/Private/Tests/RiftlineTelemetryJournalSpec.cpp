@@ -0,0 +1,171 @@
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "RiftlineTelemetryJournal.h"
+#include "RiftlineTelemetryPipeline.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineTelemetryJournalSpec, "Riftline.TelemetryJournal", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    FString Directory;
+
+    // Large enough that three records fit the 64KB minimum budget and a fourth does not.
+    static constexpr int32 PayloadChars = 20000;
+
+    FRiftlineTelemetryRecord MakeRecord(int64 TimestampMs, int32 PayloadLength = 0) const
+    {
+        FRiftlineTelemetryRecord Record;
+        Record.Event = FRiftlineTelemetryEvent(TEXT("spec.journal"));
+        Record.Event.Add(TEXT("index"), TimestampMs);
+        if (PayloadLength > 0)
+        {
+            Record.Event.AddString(TEXT("payload"), FString::ChrN(PayloadLength, TEXT('x')));
+        }
+        Record.TimestampMs = TimestampMs;
+        Record.ShardId = 4;
+        return Record;
+    }
+
+    FString OnlyChunkFile() const
+    {
+        TArray<FString> Files;
+        IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, TEXT("*.rlj")), true, false);
+        return Files.Num() == 1 ? FPaths::Combine(Directory, Files[0]) : FString();
+    }
+END_DEFINE_SPEC(FRiftlineTelemetryJournalSpec)
+
+void FRiftlineTelemetryJournalSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Directory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("TelemetryJournal"), FGuid::NewGuid().ToString());
+    });
+
+    AfterEach([this]()
+    {
+        IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    });
+
+    It("recovers the intact records in front of a torn tail", [this]()
+    {
+        {
+            FRiftlineTelemetryJournal Journal(Directory, 0, 0, 8);
+            Journal.Open();
+            for (int64 Index = 1; Index <= 3; ++Index)
+            {
+                Journal.Append(MakeRecord(Index));
+            }
+            Journal.Close();
+        }
+
+        // An app kill part way through a write leaves a length prefix promising more bytes than follow it.
+        const FString Path = OnlyChunkFile();
+        TArray<uint8> Bytes;
+        if (!TestTrue(TEXT("Chunk written"), FFileHelper::LoadFileToArray(Bytes, *Path)))
+        {
+            return;
+        }
+        const uint32 TornLength = 200;
+        Bytes.Append(reinterpret_cast<const uint8*>(&TornLength), sizeof(uint32));
+        Bytes.Append({ 1, 2, 3, 4, 5 });
+        FFileHelper::SaveArrayToFile(Bytes, *Path);
+
+        FRiftlineTelemetryJournal Recovered(Directory, 0, 0, 8);
+        Recovered.Open();
+        TArray<FRiftlineTelemetryRecord> Records;
+        uint64 Sequence = 0;
+        TestTrue(TEXT("Read"), Recovered.ReadOldest(Records, Sequence));
+        TestEqual(TEXT("Sequence"), Sequence, static_cast<uint64>(1));
+        if (TestEqual(TEXT("Records"), Records.Num(), 3))
+        {
+            TestEqual(TEXT("Name"), Records[2].Event.GetName(), FName(TEXT("spec.journal")));
+            TestEqual(TEXT("Timestamp"), Records[2].TimestampMs, static_cast<int64>(3));
+            TestEqual(TEXT("Shard"), Records[2].ShardId, 4);
+            TestEqual(TEXT("Fields"), Records[2].Event.GetFields().Num(), 1);
+        }
+    });
+
+    It("files records under the player they were recorded for, across a restart", [this]()
+    {
+        {
+            FRiftlineTelemetryJournal Journal(Directory, 0, 0, 8);
+            Journal.Open();
+            Journal.SetPlayerId(TEXT("p-1"));
+            Journal.Append(MakeRecord(1));
+            Journal.Append(MakeRecord(2));
+            Journal.SetPlayerId(TEXT("p-2"));
+            Journal.Append(MakeRecord(3));
+            Journal.Close();
+        }
+
+        FRiftlineTelemetryJournal Recovered(Directory, 0, 0, 8);
+        Recovered.Open();
+        TArray<FRiftlineTelemetryRecord> Records;
+        uint64 Sequence = 0;
+        FString PlayerId;
+        TestTrue(TEXT("First read"), Recovered.ReadOldest(Records, Sequence, &PlayerId));
+        TestEqual(TEXT("First player"), PlayerId, FString(TEXT("p-1")));
+        TestEqual(TEXT("First records"), Records.Num(), 2);
+
+        Recovered.Pop(Sequence);
+        TestTrue(TEXT("Second read"), Recovered.ReadOldest(Records, Sequence, &PlayerId));
+        TestEqual(TEXT("Second player"), PlayerId, FString(TEXT("p-2")));
+        if (TestEqual(TEXT("Second records"), Records.Num(), 1))
+        {
+            TestEqual(TEXT("Timestamp"), Records[0].TimestampMs, static_cast<int64>(3));
+        }
+    });
+
+    It("skips the in-flight chunk when evicting over budget", [this]()
+    {
+        FRiftlineTelemetryJournal Journal(Directory, 0, 0, 1);
+        Journal.Open();
+        Journal.Append(MakeRecord(1, PayloadChars));
+        Journal.SetInFlight(1);
+        for (int64 Index = 2; Index <= 4; ++Index)
+        {
+            Journal.Append(MakeRecord(Index, PayloadChars));
+        }
+
+        TestEqual(TEXT("Evicted"), Journal.GetEvictedRecordCount(), static_cast<int64>(1));
+        TestTrue(TEXT("Within budget"), Journal.GetTotalBytes() <= 64 * 1024);
+
+        TArray<FRiftlineTelemetryRecord> Records;
+        uint64 Sequence = 0;
+        Journal.ReadOldest(Records, Sequence);
+        TestEqual(TEXT("In-flight chunk kept"), Sequence, static_cast<uint64>(1));
+
+        Journal.Pop(1);
+        Journal.ReadOldest(Records, Sequence);
+        TestEqual(TEXT("Next survivor"), Sequence, static_cast<uint64>(3));
+    });
+
+    It("ignores an acknowledgement for a chunk already evicted", [this]()
+    {
+        FRiftlineTelemetryJournal Journal(Directory, 0, 0, 1);
+        Journal.Open();
+        for (int64 Index = 1; Index <= 3; ++Index)
+        {
+            Journal.Append(MakeRecord(Index, PayloadChars));
+        }
+
+        TArray<FRiftlineTelemetryRecord> Records;
+        uint64 Uploading = 0;
+        Journal.ReadOldest(Records, Uploading);
+        TestEqual(TEXT("Uploading"), Uploading, static_cast<uint64>(1));
+
+        // Not marked in flight, so the next record pushes the front out while its upload is outstanding.
+        Journal.Append(MakeRecord(4, PayloadChars));
+        TestEqual(TEXT("Evicted"), Journal.GetEvictedRecordCount(), static_cast<int64>(1));
+
+        Journal.Pop(Uploading);
+        uint64 Sequence = 0;
+        TestTrue(TEXT("Still journalled"), Journal.ReadOldest(Records, Sequence));
+        TestEqual(TEXT("New front kept"), Sequence, static_cast<uint64>(2));
+        TestEqual(TEXT("Records"), Records.Num(), 1);
+    });
+}
+
+#endif
@@ -0,0 +1,92 @@
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+#include "RiftlineTelemetryPipeline.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineTelemetryPipelineSpec, "Riftline.TelemetryPipeline", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FRiftlineTelemetryPipelineSpec)
+
+void FRiftlineTelemetryPipelineSpec::Define()
+{
+    Describe("TRiftlineMpscRing", [this]()
+    {
+        It("rounds capacity up to a power of two and refuses writes when full", [this]()
+        {
+            TRiftlineMpscRing<int32> Ring(5);
+            TestEqual(TEXT("Capacity"), Ring.Capacity(), 8u);
+            TestEqual(TEXT("Minimum"), TRiftlineMpscRing<int32>(0).Capacity(), 2u);
+
+            for (int32 Index = 0; Index < 8; ++Index)
+            {
+                TestTrue(TEXT("Enqueued"), Ring.TryEnqueueWith([Index](int32& Slot) { Slot = Index; }));
+            }
+            TestFalse(TEXT("Full"), Ring.TryEnqueueWith([](int32& Slot) { Slot = -1; }));
+
+            int32 Value = -1;
+            TestTrue(TEXT("Dequeued"), Ring.TryDequeue(Value));
+            TestEqual(TEXT("Oldest first"), Value, 0);
+            TestTrue(TEXT("Slot freed"), Ring.TryEnqueueWith([](int32& Slot) { Slot = 8; }));
+            TestFalse(TEXT("Full again"), Ring.TryEnqueueWith([](int32& Slot) { Slot = -1; }));
+        });
+
+        It("keeps FIFO order across many wraps", [this]()
+        {
+            TRiftlineMpscRing<int32> Ring(4);
+            int32 Next = 0;
+            int32 Expected = 0;
+            bool bInOrder = true;
+            for (int32 Round = 0; Round < 100; ++Round)
+            {
+                // Alternate partial fills so head and tail cross the wrap point at different offsets.
+                const int32 Burst = 1 + Round % static_cast<int32>(Ring.Capacity());
+                for (int32 Index = 0; Index < Burst; ++Index)
+                {
+                    Ring.TryEnqueueWith([&Next](int32& Slot) { Slot = Next++; });
+                }
+
+                int32 Value = -1;
+                while (Ring.TryDequeue(Value))
+                {
+                    bInOrder &= Value == Expected++;
+                }
+            }
+            TestTrue(TEXT("In order"), bInOrder);
+            TestEqual(TEXT("All delivered"), Expected, Next);
+
+            int32 Value = -1;
+            TestFalse(TEXT("Empty"), Ring.TryDequeue(Value));
+        });
+
+        It("delivers every value from concurrent producers exactly once", [this]()
+        {
+            constexpr int32 Producers = 4;
+            constexpr int32 PerProducer = 2000;
+            TRiftlineMpscRing<int32> Ring(Producers * PerProducer);
+
+            ParallelFor(Producers, [&Ring](int32 Producer)
+            {
+                for (int32 Index = 0; Index < PerProducer; ++Index)
+                {
+                    const int32 Value = Producer * PerProducer + Index;
+                    Ring.TryEnqueueWith([Value](int32& Slot) { Slot = Value; });
+                }
+            });
+
+            TBitArray<> Seen(false, Producers * PerProducer);
+            int32 Count = 0;
+            int32 Value = -1;
+            while (Ring.TryDequeue(Value))
+            {
+                if (Seen.IsValidIndex(Value) && !Seen[Value])
+                {
+                    Seen[Value] = true;
+                    ++Count;
+                }
+            }
+            TestEqual(TEXT("Delivered"), Count, Producers * PerProducer);
+        });
+    });
+}
+
+#endif
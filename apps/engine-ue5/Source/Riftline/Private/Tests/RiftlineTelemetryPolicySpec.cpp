@@ -0,0 +1,174 @@
+#include "Misc/AutomationTest.h"
+#include "RiftlineTelemetry.h"
+#include "RiftlineTelemetryPolicy.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineTelemetryPolicySpec, "Riftline.TelemetryPolicy", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    TUniquePtr<FRiftlineTelemetryPolicyEngine> Engine;
+    const FName Kind = TEXT("spec.policy");
+
+    FRiftlineTelemetryEvent MakeEvent(FName Tab = NAME_None, double Ms = 0.0) const
+    {
+        FRiftlineTelemetryEvent Event(Kind);
+        if (!Tab.IsNone())
+        {
+            Event.Add(RiftlineTelemetry::Keys::Tab, Tab);
+        }
+        Event.Add(RiftlineTelemetry::Keys::Avg, Ms);
+        return Event;
+    }
+
+    const FRiftlineTelemetryField* FindField(const FRiftlineTelemetryEvent& Event, FName Key) const
+    {
+        return Event.GetFields().FindByPredicate([Key](const FRiftlineTelemetryField& Field) { return Field.Key == Key; });
+    }
+
+    int64 ReadInt(const FRiftlineTelemetryEvent& Event, FName Key) const
+    {
+        const FRiftlineTelemetryField* Field = FindField(Event, Key);
+        return Field && Field->Type == ERiftlineTelemetryValueType::Int ? Field->IntValue : -1;
+    }
+
+    double ReadFloat(const FRiftlineTelemetryEvent& Event, FName Key) const
+    {
+        const FRiftlineTelemetryField* Field = FindField(Event, Key);
+        return Field && Field->Type == ERiftlineTelemetryValueType::Float ? Field->FloatValue : -1.0;
+    }
+
+    FName ReadName(const FRiftlineTelemetryEvent& Event, FName Key) const
+    {
+        const FRiftlineTelemetryField* Field = FindField(Event, Key);
+        return Field && Field->Type == ERiftlineTelemetryValueType::Name ? Field->NameValue : NAME_None;
+    }
+END_DEFINE_SPEC(FRiftlineTelemetryPolicySpec)
+
+void FRiftlineTelemetryPolicySpec::Define()
+{
+    using namespace RiftlineTelemetry;
+
+    BeforeEach([this]()
+    {
+        Engine = MakeUnique<FRiftlineTelemetryPolicyEngine>();
+    });
+
+    AfterEach([this]()
+    {
+        Engine.Reset();
+    });
+
+    It("admits kinds without a policy and reports nothing for them", [this]()
+    {
+        TestTrue(TEXT("Admitted"), Engine->Admit(MakeEvent(), 0.0));
+
+        TArray<FRiftlineTelemetryEvent> Rollups;
+        Engine->CollectRollups(Rollups);
+        TestEqual(TEXT("Rollups"), Rollups.Num(), 0);
+    });
+
+    It("counts aggregate-only kinds into one rollup", [this]()
+    {
+        FRiftlineTelemetryPolicy Policy;
+        Policy.Event = Kind;
+        Policy.bAggregateOnly = true;
+        Engine->SetPolicy(Policy);
+
+        for (int32 Index = 0; Index < 3; ++Index)
+        {
+            TestFalse(TEXT("Suppressed"), Engine->Admit(MakeEvent(), Index));
+        }
+
+        TArray<FRiftlineTelemetryEvent> Rollups;
+        Engine->CollectRollups(Rollups);
+        if (TestEqual(TEXT("Rollups"), Rollups.Num(), 1))
+        {
+            TestEqual(TEXT("Name"), Rollups[0].GetName(), Events::Rollup);
+            TestEqual(TEXT("Event"), ReadName(Rollups[0], Keys::Event), Kind);
+            TestEqual(TEXT("Count"), ReadInt(Rollups[0], Keys::Count), static_cast<int64>(3));
+            TestEqual(TEXT("Suppressed"), ReadInt(Rollups[0], Keys::Suppressed), static_cast<int64>(3));
+        }
+
+        Rollups.Reset();
+        Engine->CollectRollups(Rollups);
+        TestEqual(TEXT("Counters reset"), Rollups.Num(), 0);
+    });
+
+    It("lets a burst through and refills at the sustained rate", [this]()
+    {
+        FRiftlineTelemetryPolicy Policy;
+        Policy.Event = Kind;
+        Policy.RateLimitPerSecond = 2.f;
+        Policy.RateLimitBurst = 2;
+        Engine->SetPolicy(Policy);
+
+        TestTrue(TEXT("First"), Engine->Admit(MakeEvent(), 10.0));
+        TestTrue(TEXT("Second"), Engine->Admit(MakeEvent(), 10.0));
+        TestFalse(TEXT("Over burst"), Engine->Admit(MakeEvent(), 10.1));
+        TestTrue(TEXT("Refilled"), Engine->Admit(MakeEvent(), 10.6));
+        TestFalse(TEXT("Empty again"), Engine->Admit(MakeEvent(), 10.6));
+
+        TArray<FRiftlineTelemetryEvent> Rollups;
+        Engine->CollectRollups(Rollups);
+        if (TestEqual(TEXT("Rollups"), Rollups.Num(), 1))
+        {
+            TestEqual(TEXT("Count"), ReadInt(Rollups[0], Keys::Count), static_cast<int64>(5));
+            TestEqual(TEXT("Suppressed"), ReadInt(Rollups[0], Keys::Suppressed), static_cast<int64>(2));
+        }
+    });
+
+    It("splits the rollup by group and summarises the value field", [this]()
+    {
+        FRiftlineTelemetryPolicy Policy;
+        Policy.Event = Kind;
+        Policy.bAggregateOnly = true;
+        Policy.GroupByKey = Keys::Tab;
+        Policy.ValueKey = Keys::Avg;
+        Engine->SetPolicy(Policy);
+
+        Engine->Admit(MakeEvent(TEXT("map"), 4.0), 0.0);
+        Engine->Admit(MakeEvent(TEXT("map"), 10.0), 0.0);
+        Engine->Admit(MakeEvent(TEXT("wallet"), 7.0), 0.0);
+
+        TArray<FRiftlineTelemetryEvent> Rollups;
+        Engine->CollectRollups(Rollups);
+        if (!TestEqual(TEXT("Rollups"), Rollups.Num(), 2))
+        {
+            return;
+        }
+
+        const FRiftlineTelemetryEvent* Map = Rollups.FindByPredicate([this](const FRiftlineTelemetryEvent& Rollup) { return ReadName(Rollup, Keys::Value) == TEXT("map"); });
+        if (TestNotNull(TEXT("Map group"), Map))
+        {
+            TestEqual(TEXT("Count"), ReadInt(*Map, Keys::Count), static_cast<int64>(2));
+            TestEqual(TEXT("Sum"), ReadFloat(*Map, Keys::Sum), 14.0);
+            TestEqual(TEXT("Min"), ReadFloat(*Map, Keys::Min), 4.0);
+            TestEqual(TEXT("Max"), ReadFloat(*Map, Keys::Max), 10.0);
+        }
+    });
+
+    It("reports counters gathered before a policy was cleared, then forgets the kind", [this]()
+    {
+        FRiftlineTelemetryPolicy Policy;
+        Policy.Event = Kind;
+        Policy.bAggregateOnly = true;
+        Engine->SetPolicy(Policy);
+
+        Engine->Admit(MakeEvent(), 0.0);
+        Engine->ClearPolicy(Kind);
+        TestTrue(TEXT("Admitted once cleared"), Engine->Admit(MakeEvent(), 1.0));
+
+        TArray<FRiftlineTelemetryEvent> Rollups;
+        Engine->CollectRollups(Rollups);
+        if (TestEqual(TEXT("Rollups"), Rollups.Num(), 1))
+        {
+            TestEqual(TEXT("Count"), ReadInt(Rollups[0], Keys::Count), static_cast<int64>(1));
+        }
+
+        Rollups.Reset();
+        Engine->Admit(MakeEvent(), 2.0);
+        Engine->CollectRollups(Rollups);
+        TestEqual(TEXT("Forgotten"), Rollups.Num(), 0);
+    });
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RiftlineTelemetryPipeline.h"
+#include "RiftlineTelemetryWire.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineTelemetryWireSpec, "Riftline.TelemetryWire", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    /** Shared with backend/api-gateway/tests/api.spec.ts, which decodes the same bytes. */
+    FString LoadGoldenHex()
+    {
+        const FString Path = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectDir(), TEXT("../../tests/fixtures/telemetry-wire-batch.json")));
+        FString Text;
+        TSharedPtr<FJsonObject> Fixture;
+        if (!TestTrue(TEXT("Fixture loaded"), FFileHelper::LoadFileToString(Text, *Path))
+            || !TestTrue(TEXT("Fixture parsed"), FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Fixture) && Fixture.IsValid()))
+        {
+            return FString();
+        }
+        return Fixture->GetStringField(TEXT("hex"));
+    }
+END_DEFINE_SPEC(FRiftlineTelemetryWireSpec)
+
+void FRiftlineTelemetryWireSpec::Define()
+{
+    It("encodes the shared golden batch byte for byte", [this]()
+    {
+        TArray<FRiftlineTelemetryRecord> Records;
+
+        FRiftlineTelemetryRecord& Tab = Records.AddDefaulted_GetRef();
+        Tab.Event = FRiftlineTelemetryEvent(TEXT("ui.phone.tab"));
+        Tab.Event.Add(TEXT("tab"), FName(TEXT("Map")))
+            .Add(TEXT("items"), 3)
+            .Add(TEXT("ok"), true);
+        Tab.TimestampMs = 1900000000123;
+        Tab.ShardId = 2;
+
+        // Covers a negative delta, a ten-byte varint and multi-byte UTF-8 on a record with no shard.
+        FRiftlineTelemetryRecord& Hitch = Records.AddDefaulted_GetRef();
+        Hitch.Event = FRiftlineTelemetryEvent(TEXT("client.hitch"));
+        Hitch.Event.Add(TEXT("thread"), FName(TEXT("Game")))
+            .Add(TEXT("ms"), 48.5f)
+            .Add(TEXT("delta"), -5)
+            .Add(TEXT("big"), MIN_int64)
+            .AddString(TEXT("address"), TEXT("0x\u00E9\u2713"));
+        Hitch.TimestampMs = 1900000000456;
+        Hitch.ShardId = INDEX_NONE;
+
+        TArray<uint8> Bytes;
+        RiftlineTelemetryWire::EncodeBinaryBatch(Bytes, TEXT("p-1"), 3, Records);
+
+        const FString Expected = LoadGoldenHex();
+        if (!Expected.IsEmpty())
+        {
+            TestEqual(TEXT("Bytes"), BytesToHex(Bytes.GetData(), Bytes.Num()).ToLower(), Expected.ToLower());
+        }
+    });
+}
+
+#endif
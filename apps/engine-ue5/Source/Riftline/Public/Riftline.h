@@ -1,5 +1,40 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogRiftline, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("Riftline"), STATGROUP_Riftline, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("HTTP Requests In Flight"), STAT_RiftlineHttpInFlight, STATGROUP_Riftline, RIFTLINE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("HTTP Requests Queued"), STAT_RiftlineHttpQueued, STATGROUP_Riftline, RIFTLINE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Telemetry Queue Depth"), STAT_RiftlineTelemetryQueueDepth, STATGROUP_Riftline, RIFTLINE_API);
+/** Broadcasts this frame; both the stat and the Insights counter restart from zero every frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Delegate Broadcasts"), STAT_RiftlineDelegateBroadcasts, STATGROUP_Riftline, RIFTLINE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Interaction Queries"), STAT_RiftlineInteractionQueries, STATGROUP_Riftline, RIFTLINE_API);
+
+UE_TRACE_CHANNEL_EXTERN(RiftlineChannel, RIFTLINE_API);
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(RiftlineHttpInFlight);
+TRACE_DECLARE_INT_COUNTER_EXTERN(RiftlineHttpQueued);
+TRACE_DECLARE_INT_COUNTER_EXTERN(RiftlineTelemetryQueueDepth);
+TRACE_DECLARE_INT_COUNTER_EXTERN(RiftlineDelegateBroadcasts);
+TRACE_DECLARE_INT_COUNTER_EXTERN(RiftlineInteractionQueries);
+
+LLM_DECLARE_TAG_API(Riftline_UI, RIFTLINE_API);
+LLM_DECLARE_TAG_API(Riftline_Network, RIFTLINE_API);
+
+/** Cycle stat under STATGROUP_Riftline plus a CPU event on RiftlineChannel, so the scope is named in stat and Insights captures. */
+#define RIFTLINE_SCOPE(Name) \
+    DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_Riftline_##Name, STATGROUP_Riftline); \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(#Name, RiftlineChannel)
+
+/** Counter helpers keep the stat and the Insights counter of the same name in step. */
+#define RIFTLINE_COUNTER_INC(Counter) do { INC_DWORD_STAT(STAT_##Counter); TRACE_COUNTER_INCREMENT(Counter); } while (0)
+#define RIFTLINE_COUNTER_DEC(Counter) do { DEC_DWORD_STAT(STAT_##Counter); TRACE_COUNTER_DECREMENT(Counter); } while (0)
+#define RIFTLINE_COUNTER_SET(Counter, Value) do { SET_DWORD_STAT(STAT_##Counter, Value); TRACE_COUNTER_SET(Counter, Value); } while (0)
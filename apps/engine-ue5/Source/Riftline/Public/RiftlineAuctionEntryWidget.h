@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "Blueprint/UserWidget.h"
+#include "RiftlineTypes.h"
+#include "RiftlineAuctionEntryWidget.generated.h"
+
+class UTextBlock;
+class URiftlineAuctionItem;
+
+/**
+ * Row of the phone's auction list. UListView pools these and only creates enough for the visible rows; an entry
+ * follows its current item's changes and has its countdown refreshed by the phone's shared timer.
+ */
+UCLASS(Abstract, Blueprintable, meta = (DisableNativeTick))
+class RIFTLINE_API URiftlineAuctionEntryWidget : public UUserWidget, public IUserObjectListEntry
+{
+    GENERATED_BODY()
+
+public:
+    void RefreshCountdown(const FDateTime& Now);
+
+    UFUNCTION(BlueprintPure, Category = "Riftline|Auctions")
+    URiftlineAuctionItem* GetAuctionItem() const { return Item.Get(); }
+
+protected:
+    virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+    virtual void NativeOnEntryReleased() override;
+
+    UFUNCTION(BlueprintImplementableEvent, Category = "Riftline|Auctions")
+    void OnAuctionRowChanged(const FRiftlineAuctionRow& Row);
+
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+    UTextBlock* TitleText;
+
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+    UTextBlock* AssetTypeText;
+
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+    UTextBlock* PriceText;
+
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+    UTextBlock* CountdownText;
+
+private:
+    TWeakObjectPtr<URiftlineAuctionItem> Item;
+    FDelegateHandle ItemChangedHandle;
+    int32 ShownSeconds = INDEX_NONE;
+
+    void Unbind();
+    void HandleItemChanged(const URiftlineAuctionItem& Changed);
+};
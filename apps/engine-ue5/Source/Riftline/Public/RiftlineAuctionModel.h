@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RiftlineNetworkQuality.h"
+#include "RiftlineTypes.h"
+#include "UObject/Object.h"
+#include "RiftlineAuctionModel.generated.h"
+
+class URiftlineAuctionItem;
+
+USTRUCT(BlueprintType)
+struct FRiftlineAuctionChangeSet
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Riftline|Auctions")
+    TArray<int32> Added;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Riftline|Auctions")
+    TArray<int32> Updated;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Riftline|Auctions")
+    TArray<int32> Removed;
+
+    /** Items were added, removed or moved, so views must re-read GetItems(); plain updates reach entries directly. */
+    UPROPERTY(BlueprintReadOnly, Category = "Riftline|Auctions")
+    bool bOrderChanged = false;
+
+    bool IsEmpty() const { return Added.Num() == 0 && Updated.Num() == 0 && Removed.Num() == 0; }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRiftlineAuctionChangesDelegate, const FRiftlineAuctionChangeSet&, Changes);
+DECLARE_MULTICAST_DELEGATE_OneParam(FRiftlineAuctionItemChanged, const URiftlineAuctionItem&);
+
+/** One listing. The object lives as long as the listing, so list views and entry widgets can hold on to it. */
+UCLASS(BlueprintType)
+class RIFTLINE_API URiftlineAuctionItem : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UFUNCTION(BlueprintPure, Category = "Riftline|Auctions")
+    const FRiftlineAuctionRow& GetRow() const { return Row; }
+
+    UFUNCTION(BlueprintPure, Category = "Riftline|Auctions")
+    int32 GetSecondsRemaining() const { return GetSecondsRemainingAt(RiftlineNetwork::GetServerNow()); }
+
+    int32 GetSecondsRemainingAt(const FDateTime& Now) const;
+
+    /** Fired when an upsert changes this listing. */
+    FRiftlineAuctionItemChanged OnChanged;
+
+private:
+    friend class URiftlineAuctionModel;
+
+    UPROPERTY()
+    FRiftlineAuctionRow Row;
+};
+
+/**
+ * Auction listings keyed by AuctionId and ordered by end time, soonest first. Feeds apply incremental upserts and
+ * removals; every call reports what changed, so views touch only the affected rows instead of re-rendering the list.
+ */
+UCLASS(BlueprintType)
+class RIFTLINE_API URiftlineAuctionModel : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(BlueprintAssignable, Category = "Riftline|Auctions")
+    FRiftlineAuctionChangesDelegate OnChanged;
+
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Auctions")
+    FRiftlineAuctionChangeSet Upsert(const TArray<FRiftlineAuctionRow>& Rows);
+
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Auctions")
+    FRiftlineAuctionChangeSet Remove(const TArray<int32>& AuctionIds);
+
+    /** Applies a full snapshot as the upserts and removals that turn the current listings into it. */
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Auctions")
+    FRiftlineAuctionChangeSet ReplaceAll(const TArray<FRiftlineAuctionRow>& Rows);
+
+    UFUNCTION(BlueprintPure, Category = "Riftline|Auctions")
+    URiftlineAuctionItem* FindItem(int32 AuctionId) const;
+
+    UFUNCTION(BlueprintPure, Category = "Riftline|Auctions")
+    int32 Num() const { return Ordered.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "Riftline|Auctions")
+    const TArray<URiftlineAuctionItem*>& GetItems() const { return Ordered; }
+
+private:
+    UPROPERTY()
+    TMap<int32, URiftlineAuctionItem*> Items;
+
+    UPROPERTY()
+    TArray<URiftlineAuctionItem*> Ordered;
+
+    bool bNeedsSort = false;
+
+    void ApplyRow(const FRiftlineAuctionRow& Row, const FDateTime& Now, FRiftlineAuctionChangeSet& Changes);
+    void RemoveItems(const TSet<int32>& AuctionIds, FRiftlineAuctionChangeSet& Changes);
+    void Publish(const FRiftlineAuctionChangeSet& Changes);
+};
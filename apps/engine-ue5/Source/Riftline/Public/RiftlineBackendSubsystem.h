@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RiftlineTypes.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "RiftlineBackendSubsystem.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRiftlineShardsLoadedDelegate, const TArray<FRiftlineShardStatus>&, Shards);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRiftlineAuctionsLoadedDelegate, const TArray<FRiftlineAuctionRow>&, Rows);
+
+/**
+ * Fetches the player, shard list and auction listings from the API gateway. Responses are decoded into Riftline
+ * structs on a worker and only the finished structs reach the game thread, so opening the market tab over a full page
+ * of listings no longer parses JSON mid-frame.
+ *
+ * Each refresh supersedes the one before it; a response that lands after a newer request was sent is dropped.
+ */
+UCLASS()
+class RIFTLINE_API URiftlineBackendSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+    /** Bearer token for the gateway's authenticated routes, telemetry heartbeats included; setting one loads the player. Empty sends requests without one. */
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Backend")
+    void SetAuthToken(const FString& Token);
+
+    /** Applies the signed-in player's identity, shard and wallet through the game instance. Needs an auth token. */
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Backend")
+    void RefreshProfile();
+
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Backend")
+    void RefreshShards();
+
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Backend")
+    void RefreshAuctions();
+
+    UPROPERTY(BlueprintAssignable)
+    FRiftlineShardsLoadedDelegate OnShardsLoaded;
+
+    /** Full snapshot of the open listings. */
+    UPROPERTY(BlueprintAssignable)
+    FRiftlineAuctionsLoadedDelegate OnAuctionsLoaded;
+
+private:
+    enum class EEndpoint : uint8
+    {
+        Profile,
+        Shards,
+        Auctions,
+        Count
+    };
+
+    FString AuthToken;
+
+    /** Latest request per endpoint; responses carrying an older number are stale. */
+    uint32 Generations[static_cast<int32>(EEndpoint::Count)] = {};
+
+    /** Submits a GET and hands the 2xx body to OnBody on the game thread; failures are logged and dropped. */
+    template <typename FuncType>
+    void Fetch(EEndpoint Endpoint, const TCHAR* Path, FuncType&& OnBody);
+
+    bool IsCurrent(EEndpoint Endpoint, uint32 Generation) const { return Generations[static_cast<int32>(Endpoint)] == Generation; }
+
+    void ApplyProfile(FRiftlineSessionProfile&& Decoded, FRiftlineWalletView&& DecodedWallet);
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RiftlineDeviceState.generated.h"
+
+UENUM(BlueprintType)
+enum class ERiftlineThermalState : uint8
+{
+    Unknown  UMETA(DisplayName = "Unknown"),
+    Nominal  UMETA(DisplayName = "Nominal"),
+    Fair     UMETA(DisplayName = "Fair"),
+    Serious  UMETA(DisplayName = "Serious"),
+    Critical UMETA(DisplayName = "Critical")
+};
+
+USTRUCT(BlueprintType)
+struct FRiftlineDeviceState
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    ERiftlineThermalState Thermal = ERiftlineThermalState::Unknown;
+
+    /** 0..1, or negative when the platform does not report it. */
+    UPROPERTY(BlueprintReadOnly)
+    float BatteryLevel = -1.f;
+
+    UPROPERTY(BlueprintReadOnly)
+    bool bOnBattery = false;
+};
+
+/** Source of thermal and battery readings for telemetry and the scalability governor. Game thread only. */
+class RIFTLINE_API IRiftlineDeviceStateProvider
+{
+public:
+    virtual ~IRiftlineDeviceStateProvider() = default;
+
+    virtual FRiftlineDeviceState Sample() = 0;
+    virtual FName GetSourceName() const = 0;
+
+    /** Picks the scripted provider when -RiftlineDeviceScript=<file> is on the command line, else the platform one. */
+    static TUniquePtr<IRiftlineDeviceStateProvider> Create();
+};
+
+/** Reads the OS thermal notifications and battery level through FCoreDelegates and FPlatformMisc. */
+class RIFTLINE_API FRiftlinePlatformDeviceStateProvider : public IRiftlineDeviceStateProvider
+{
+public:
+    FRiftlinePlatformDeviceStateProvider();
+    virtual ~FRiftlinePlatformDeviceStateProvider() override;
+
+    virtual FRiftlineDeviceState Sample() override;
+    virtual FName GetSourceName() const override;
+
+private:
+    ERiftlineThermalState LastThermal = ERiftlineThermalState::Unknown;
+    FDelegateHandle TemperatureHandle;
+};
+
+/**
+ * Replays a JSON timeline of device states so the governor can be exercised headless on Linux:
+ * { "loop": false, "keyframes": [ { "t": 0, "thermal": "Nominal", "battery": 0.9 }, { "t": 600, "thermal": "Serious" } ] }
+ * Fields omitted from a keyframe keep the previous keyframe's value.
+ */
+class RIFTLINE_API FRiftlineScriptedDeviceStateProvider : public IRiftlineDeviceStateProvider
+{
+public:
+    bool LoadFromFile(const FString& Path);
+    void AddKeyframe(double TimeSeconds, const FRiftlineDeviceState& State);
+
+    /** Replaces the wall clock the timeline plays against, so specs can step it window by window. */
+    void SetClock(TFunction<double()> InClock) { Clock = MoveTemp(InClock); }
+
+    virtual FRiftlineDeviceState Sample() override;
+    virtual FName GetSourceName() const override;
+
+private:
+    TArray<TPair<double, FRiftlineDeviceState>> Keyframes;
+    TFunction<double()> Clock;
+    double StartSeconds = -1.0;
+    bool bLoop = false;
+};
@@ -2,9 +2,18 @@
 
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
+#include "RiftlineDeviceState.h"
+#include "RiftlineHttpScheduler.h"
+#include "RiftlineNetworkQuality.h"
+#include "RiftlinePerformanceMonitor.h"
+#include "RiftlineScalabilityGovernor.h"
+#include "RiftlineSessionStore.h"
+#include "RiftlineTelemetryPipeline.h"
+#include "RiftlineTelemetryPolicy.h"
 #include "RiftlineTypes.h"
 #include "RiftlineGameInstance.generated.h"
 
+class FRiftlineBenchmarkSession;
 class URiftlinePhoneWidget;
 
 UCLASS()
@@ -22,7 +31,13 @@ public:
     void SetSessionProfile(const FRiftlineSessionProfile& NewProfile);
 
     UFUNCTION(BlueprintCallable, Category = "Riftline|Session")
-    const FRiftlineSessionProfile& GetSessionProfile() const { return Session; }
+    const FRiftlineSessionProfile& GetSessionProfile() const { return SessionStore.GetProfile(); }
+
+    /** Gateway bearer token for the telemetry pipeline; URiftlineBackendSubsystem forwards the one it is given. */
+    void SetAuthToken(const FString& Token);
+
+    /** Native access for field-masked subscriptions; changes are dispatched once at the end of the frame. */
+    FRiftlineSessionStore& GetSessionStore() { return SessionStore; }
 
     UFUNCTION(BlueprintCallable, Category = "Riftline|Wanted")
     void ApplyWantedState(const FRiftlineWantedState& Wanted);
@@ -45,40 +60,189 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Riftline|Network")
     void PushTelemetryEvent(const FString& Event, const TMap<FString, FString>& Properties);
 
+    void PushTelemetry(const FRiftlineTelemetryEvent& Event);
+
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Network")
+    void FlushTelemetry();
+
+    UFUNCTION(BlueprintPure, Category = "Riftline|Network")
+    int64 GetTelemetryDroppedCount() const;
+
+    /** Adds or replaces the sampling, rate limit and rollup policy for one event kind. */
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Network")
+    void SetTelemetryPolicy(const FRiftlineTelemetryPolicy& Policy);
+
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Network")
+    void ClearTelemetryPolicy(FName Event);
+
+    /** Round-trip, failure-rate and clock estimates from recent HTTP traffic, heartbeats included. */
+    UFUNCTION(BlueprintPure, Category = "Riftline|Network")
+    FRiftlineNetworkQualitySnapshot GetNetworkQuality() const { return NetworkQuality.GetSnapshot(); }
+
+    /** Local UTC corrected by the measured clock offset; use it for countdowns against server timestamps. */
+    UFUNCTION(BlueprintPure, Category = "Riftline|Network")
+    FDateTime GetServerTimeUtc() const { return RiftlineNetwork::GetServerNow(); }
+
+    /** The session events below fire at the end of the frame, at most once per frame and only for changed values. */
     UPROPERTY(BlueprintAssignable)
     FRiftlineWantedDelegate OnWantedStateChanged;
 
     UPROPERTY(BlueprintAssignable)
     FRiftlineComplianceDelegate OnComplianceChanged;
 
+    /** Identity or wallet changes; shard, wanted and compliance updates have their own events. */
     UPROPERTY(BlueprintAssignable)
     FRiftlineSessionDelegate OnSessionChanged;
 
+    UPROPERTY(BlueprintAssignable)
+    FRiftlineShardDelegate OnShardChanged;
+
     UFUNCTION(BlueprintCallable, Category = "Riftline|UI")
     void RegisterPhoneWidget(URiftlinePhoneWidget* Widget);
 
     FString GetApiBaseUrl() const { return ApiBaseUrl; }
     FString GetNakamaUrl() const { return NakamaUrl; }
+    FString GetNakamaServerKey() const { return NakamaServerKey; }
+
+    /** Shared by every client HTTP call; valid between Init and Shutdown. */
+    TSharedPtr<FRiftlineHttpScheduler, ESPMode::ThreadSafe> GetHttpScheduler() const { return HttpScheduler; }
+
+protected:
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Network", meta = (ClampMin = "1"))
+    int32 HttpMaxConnectionsPerHost;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Network", meta = (ClampMin = "1"))
+    int32 HttpMaxConnections;
+
+    /** Default seconds between heartbeats; the gateway may replace it through nextHeartbeatSec in each response. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Network", meta = (ClampMin = "5"))
+    float HeartbeatInterval;
+
+    /** Each interval is scaled by a random factor within this fraction so clients never beat in lockstep. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Network", meta = (ClampMin = "0", ClampMax = "0.5"))
+    float HeartbeatJitter;
+
+    /** Cap on any interval, whether stretched by the server, by backoff or while backgrounded. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Network", meta = (ClampMin = "5"))
+    float HeartbeatMaxInterval;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Network", meta = (ClampMin = "1"))
+    float HeartbeatBackgroundMultiplier;
+
+    /** Applied once the player has not touched any input for HeartbeatIdleSeconds. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Network", meta = (ClampMin = "1"))
+    float HeartbeatIdleMultiplier;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Network", meta = (ClampMin = "10"))
+    float HeartbeatIdleSeconds;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Telemetry", meta = (ClampMin = "1"))
+    int32 TelemetryBatchSize;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Telemetry", meta = (ClampMin = "0.5"))
+    float TelemetryFlushInterval;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Telemetry", meta = (ClampMin = "16"))
+    int32 TelemetryQueueCapacity;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Telemetry", meta = (ClampMin = "1"))
+    int32 TelemetryJournalMaxMegabytes;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Telemetry")
+    ERiftlineTelemetryWireFormat TelemetryWireFormat;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Telemetry")
+    TArray<FRiftlineTelemetryPolicy> TelemetryPolicies;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Telemetry", meta = (ClampMin = "5"))
+    float TelemetryRollupInterval;
+
+    /** How long shutdown may block uploading journalled telemetry; what is left goes out next session. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Telemetry", meta = (ClampMin = "0"))
+    float TelemetryShutdownFlushSeconds;
+
+    /** Frames at or above this duration count as hitches in client.frametime. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Telemetry", meta = (ClampMin = "1"))
+    float TelemetryHitchThresholdMs;
+
+    /** Upper bound on client.hitch events per heartbeat window; further hitches are only counted. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Telemetry", meta = (ClampMin = "0"))
+    int32 TelemetryMaxHitchReports;
+
+    /** Off by default on desktop so player-chosen settings are left alone; -RiftlineGovernor forces it on. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Performance")
+    bool bEnableScalabilityGovernor;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Performance")
+    TArray<FRiftlineGovernorStep> GovernorSteps;
+
+    /** Consecutive heartbeat windows under pressure before stepping down. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Performance", meta = (ClampMin = "1"))
+    int32 GovernorDownWindows;
+
+    /** Consecutive heartbeat windows with headroom before stepping back up. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Performance", meta = (ClampMin = "1"))
+    int32 GovernorUpWindows;
 
 private:
+    friend class FRiftlineBenchmarkSession;
+
     FString ApiBaseUrl;
     FString NakamaUrl;
+    FString NakamaServerKey;
+    FString TelemetryJournalDirectory;
+    FString AuthToken;
 
-    FRiftlineSessionProfile Session;
+    FRiftlineSessionStore SessionStore;
+    FDelegateHandle SessionSubscription;
     TWeakObjectPtr<URiftlinePhoneWidget> PhoneWidget;
-    FRiftlineWalletView WalletView;
-    TArray<FText> ActiveMissions;
-    TArray<float> FpsSamples;
+    FDelegateHandle PhoneSubscription;
+
+    TSharedPtr<FRiftlineHttpScheduler, ESPMode::ThreadSafe> HttpScheduler;
+    FDelegateHandle HttpAttemptHandle;
+    FRiftlineNetworkQuality NetworkQuality;
+    TUniquePtr<FRiftlineTelemetryPipeline> TelemetryPipeline;
+    FRiftlineTelemetryPolicyEngine TelemetryPolicy;
+    TUniquePtr<FRiftlinePerformanceMonitor> PerformanceMonitor;
+    TUniquePtr<IRiftlineDeviceStateProvider> DeviceStateProvider;
+    TUniquePtr<FRiftlineScalabilityGovernor> Governor;
+    FRiftlineDeviceState DeviceState;
 
     FTimerHandle HeartbeatTimerHandle;
+    FTimerHandle PerformanceWindowTimerHandle;
+    bool bHeartbeatActive = false;
+    bool bHeartbeatInFlight = false;
+    double HeartbeatSentAt = 0.0;
+    float ServerHeartbeatInterval = 0.f;
+    int32 HeartbeatFailures = 0;
+    bool bInBackground = false;
+    FDelegateHandle BackgroundHandle;
+    FDelegateHandle ForegroundHandle;
+    FTimerHandle TelemetryRollupTimerHandle;
 
     void InitialiseFromEnvironment();
+    void StartTelemetry();
+    void StopTelemetry();
+    void EmitTelemetryRollups();
     void StartHeartbeat();
     void StopHeartbeat();
     void HeartbeatTick();
-
+    void ScheduleHeartbeat(float Delay);
+    float NextHeartbeatDelay() const;
+    void HandleHeartbeatResponse(const FRiftlineHttpResult& Result);
+    void HandleEnterBackground();
+    void HandleEnterForeground();
+    void EmitHttpTelemetry();
+    void HandleHttpAttempt(const FString& Host, const FRiftlineHttpResult& Result);
+    void EmitNetworkTelemetry();
+
+    void HandleSessionChanges(const FRiftlineSessionStore& Store, ERiftlineSessionField Changed);
     void SubmitWantedTelemetry(const FRiftlineWantedState& WantedState);
-    void EmitClientPerformanceTelemetry();
+    void StartPerformanceMonitoring();
+    void StopPerformanceMonitoring();
+    void SamplePerformanceWindow();
+    void EmitGovernorTelemetry(ERiftlineGovernorReason Reason);
+    void HandleHitch(const FRiftlineHitchSample& Sample);
+    FName DescribeInteractionState() const;
     void EmitThermalTelemetry();
-    FString DescribeThermalState() const;
 };
@@ -2,18 +2,24 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "RiftlineInteractionComponent.h"
 #include "RiftlineTypes.h"
 #include "RiftlineHUDWidget.generated.h"
 
 class UHorizontalBox;
 class UImage;
+class UMaterialInstanceDynamic;
 class UProgressBar;
 class UTextBlock;
 class UWidget;
 class URiftlineRadialMenuWidget;
-struct FRiftlineInteractionOption;
 
-UCLASS(Abstract, Blueprintable)
+/**
+ * Always-on HUD. Setters compare against what is already shown and return early when nothing changed, so under
+ * Slate global invalidation (or inside an invalidation box) an idle HUD neither ticks, lays out nor repaints. Keep
+ * the Blueprint layout free of property bindings, which mark their widgets volatile and defeat the cache.
+ */
+UCLASS(Abstract, Blueprintable, meta = (DisableNativeTick))
 class RIFTLINE_API URiftlineHUDWidget : public UUserWidget
 {
     GENERATED_BODY()
@@ -33,6 +39,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Riftline|HUD")
     void SetRadialEntries(const TArray<FRiftlineInteractionOption>& Entries);
 
+    /** Hands the shared option list through to the radial menu without copying it. */
+    void SetRadialOptions(const FRiftlineInteractionOptionsPtr& Options);
+
     UFUNCTION(BlueprintCallable, Category = "Riftline|HUD")
     void ClearRadialEntries();
 
@@ -58,12 +67,23 @@ public:
     void HandleComplianceChanged(const FRiftlineComplianceState& State);
 
 protected:
+    virtual void NativeOnInitialized() override;
+
     UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
     UImage* Minimap;
 
     UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
     UHorizontalBox* WantedStars;
 
+    /**
+     * Stars and heat drawn by one image whose brush material reads the scalar parameters Stars, Heat and Pulse.
+     * StarsFrom/StarsChangedAt and HeatFrom/HeatChangedAt let the material animate from the previous value against
+     * its Time node, so a change is one parameter write with no layout or extra widgets. Replaces WantedStars and
+     * HeatBar when bound.
+     */
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+    UImage* WantedMeter;
+
     UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
     UProgressBar* HeatBar;
 
@@ -89,6 +109,17 @@ protected:
     int32 VisibleWantedLevel = 0;
 
 private:
-    void UpdateWantedVisuals(int32 Stars) const;
-    void UpdateRadialVisibility(bool bVisible) const;
+    UPROPERTY(Transient)
+    UMaterialInstanceDynamic* WantedMeterMaterial;
+
+    /** Last values pushed to the bound widgets; unset until the first update. */
+    int32 ShownStars = INDEX_NONE;
+    float ShownHeat = -1.f;
+    int32 ShownHeatPercent = INDEX_NONE;
+    bool bComplianceShown = false;
+    TOptional<bool> bRadialShown;
+
+    void UpdateWantedVisuals(int32 Stars);
+    void UpdateMeter(FName Value, FName From, FName ChangedAt, float NewValue, float OldValue) const;
+    void UpdateRadialVisibility(bool bVisible);
 };
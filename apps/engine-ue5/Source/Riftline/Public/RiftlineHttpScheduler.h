@@ -0,0 +1,184 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HttpFwd.h"
+#include "RiftlinePerformanceMonitor.h"
+#include <atomic>
+
+/** Dispatch order when slots are scarce; lower values go first. */
+enum class ERiftlineHttpPriority : uint8
+{
+    Interactive,
+    Gameplay,
+    Heartbeat,
+    Telemetry,
+    Count
+};
+
+struct FRiftlineHttpRequest
+{
+    FString Url;
+    FString Verb = TEXT("GET");
+    TArray<TPair<FString, FString>> Headers;
+    TArray<uint8> Content;
+    ERiftlineHttpPriority Priority = ERiftlineHttpPriority::Gameplay;
+
+    /**
+     * Attempts including the first. Connection failures, 408, 429 and transient 5xx are retried; only raise this for requests
+     * the server can safely see twice, since a connection failure does not prove the first attempt went unseen.
+     */
+    int32 MaxAttempts = 1;
+
+    FRiftlineHttpRequest& SetHeader(const FString& Name, const FString& Value);
+    FRiftlineHttpRequest& SetContentAsString(const FString& Body);
+};
+
+struct FRiftlineHttpResult
+{
+    /** False when no response arrived (connection failure, timeout, or dropped at shutdown or on overflow). */
+    bool bConnected = false;
+    int32 Code = 0;
+    TArray<uint8> Content;
+    int32 Attempts = 0;
+
+    /** Wire time of the last attempt, and time from submission to completion including queueing and backoff. */
+    float LatencyMs = 0.f;
+    float TotalMs = 0.f;
+
+    /** Unix milliseconds when the last attempt was sent, and the server's receive time and handling duration when it reports them. */
+    int64 SentAtMs = 0;
+    int64 ServerReceivedAtMs = 0;
+    float ServerDurationMs = -1.f;
+
+    bool IsOk() const { return bConnected && Code >= 200 && Code < 300; }
+    FString GetContentAsString() const;
+};
+
+DECLARE_DELEGATE_OneParam(FRiftlineHttpCompleteDelegate, const FRiftlineHttpResult&);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FRiftlineHttpAttemptDelegate, const FString& /*Host*/, const FRiftlineHttpResult&);
+
+struct FRiftlineHttpSchedulerSettings
+{
+    int32 MaxConnectionsPerHost = 6;
+    int32 MaxConnections = 12;
+
+    /** Per-host slots heartbeat and telemetry may never take, so interactive and gameplay calls are not starved. */
+    int32 ForegroundReservedPerHost = 1;
+
+    float BaseRetryDelay = 0.5f;
+    float MaxRetryDelay = 30.f;
+
+    /** Upper bound on a server-supplied Retry-After, so a bad header cannot park a host for the session. */
+    float MaxRetryAfter = 120.f;
+
+    float RequestTimeout = 20.f;
+    int32 MaxQueued = 256;
+};
+
+struct FRiftlineHttpPriorityStats
+{
+    int32 Requests = 0;
+    int32 Retries = 0;
+    int32 Failures = 0;
+    int32 Coalesced = 0;
+    FRiftlineHistogram TotalTimes;
+};
+
+struct FRiftlineHttpSummary
+{
+    FRiftlineHttpPriorityStats Priorities[static_cast<int32>(ERiftlineHttpPriority::Count)];
+
+    const FRiftlineHttpPriorityStats& operator[](ERiftlineHttpPriority Priority) const { return Priorities[static_cast<int32>(Priority)]; }
+};
+
+/**
+ * Every HTTP call the client makes goes through here. Requests queue by priority and are dispatched under
+ * per-host and global connection caps. Retryable failures back the whole host off with jittered exponential
+ * delays, stretched to any Retry-After the server sends with 429 or 503, so a degraded gateway sees the fleet
+ * slow down instead of retry storms. Identical GETs in flight share one request.
+ *
+ * Submit may be called from any thread; dispatch and completion delegates run on the game thread.
+ */
+class RIFTLINE_API FRiftlineHttpScheduler : public TSharedFromThis<FRiftlineHttpScheduler, ESPMode::ThreadSafe>
+{
+public:
+    explicit FRiftlineHttpScheduler(const FRiftlineHttpSchedulerSettings& InSettings);
+    ~FRiftlineHttpScheduler();
+
+    void Start();
+
+    /** Fails queued requests and cancels those on the wire; later submissions are dropped without a callback. */
+    void Stop();
+
+    void Submit(FRiftlineHttpRequest&& Request, FRiftlineHttpCompleteDelegate&& OnComplete);
+
+    /** Dispatches whatever is ready; the ticker calls this every frame while started. */
+    void Pump();
+
+    /**
+     * Game thread only. Pumps the scheduler and ticks the HTTP manager until nothing is on the wire or the timeout
+     * passes; used at shutdown, when the ticker that normally drives completions no longer runs.
+     */
+    void Flush(double TimeoutSeconds);
+
+    int32 GetNumQueued() const { return NumQueued; }
+    int32 GetNumInFlight() const { return NumInFlight; }
+
+    /** Copies the counters and latency histograms gathered since the last call, then resets them. */
+    void ConsumeWindow(FRiftlineHttpSummary& Out);
+
+    /** Broadcast on the game thread after every attempt that got a response or failed to connect, retries included. */
+    FRiftlineHttpAttemptDelegate& OnAttempt() { return AttemptDelegate; }
+
+private:
+    struct FEntry;
+    struct FHostState
+    {
+        int32 InFlight = 0;
+        int32 ConsecutiveFailures = 0;
+        double BlockedUntil = 0.0;
+    };
+
+    FRiftlineHttpSchedulerSettings Settings;
+    TQueue<TSharedPtr<FEntry, ESPMode::ThreadSafe>, EQueueMode::Mpsc> Submissions;
+    std::atomic<bool> bStopped{false};
+
+    // Game-thread state.
+    TArray<TSharedPtr<FEntry, ESPMode::ThreadSafe>> Queued[static_cast<int32>(ERiftlineHttpPriority::Count)];
+    TArray<TSharedPtr<FEntry, ESPMode::ThreadSafe>> InFlight;
+    TMap<FString, TSharedPtr<FEntry, ESPMode::ThreadSafe>> Coalescing;
+    TMap<FString, FHostState> Hosts;
+    FRiftlineHttpSummary Window;
+    FRiftlineHttpAttemptDelegate AttemptDelegate;
+    int32 NumQueued = 0;
+    int32 NumInFlight = 0;
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    bool Tick(float DeltaTime);
+    void Accept(const TSharedPtr<FEntry, ESPMode::ThreadSafe>& Entry);
+    bool CanDispatch(const FEntry& Entry, double Now) const;
+    void Dispatch(const TSharedPtr<FEntry, ESPMode::ThreadSafe>& Entry, double Now);
+    void HandleResponse(const TSharedPtr<FEntry, ESPMode::ThreadSafe>& Entry, const FHttpResponsePtr& Response, bool bConnected);
+    void Complete(const TSharedPtr<FEntry, ESPMode::ThreadSafe>& Entry);
+};
+
+namespace RiftlineHttp
+{
+    /**
+     * Exponential backoff with equal jitter: half of the capped delay for the attempt (0-based) plus Random01 of the
+     * other half, so clients failed by the same outage spread their retries without ever retrying instantly.
+     */
+    RIFTLINE_API float ComputeBackoff(int32 Attempt, float BaseSeconds, float MaxSeconds, float Random01);
+
+    /** Reads a Retry-After value given either as delta seconds or as an HTTP date. */
+    RIFTLINE_API bool ParseRetryAfter(const FString& Value, const FDateTime& Now, float& OutSeconds);
+
+    RIFTLINE_API bool IsRetryable(bool bConnected, int32 Code);
+
+    /** Scheme-less authority of a URL, e.g. "api.example.com:8080"; caps and backoff are tracked per value. */
+    RIFTLINE_API FString GetHost(const FString& Url);
+
+    RIFTLINE_API const TCHAR* LexPriority(ERiftlineHttpPriority Priority);
+}
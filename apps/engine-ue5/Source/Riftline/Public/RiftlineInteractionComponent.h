@@ -3,9 +3,14 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Engine/EngineTypes.h"
+#include "UObject/ObjectKey.h"
 #include "RiftlineInteractionComponent.generated.h"
 
 class APawn;
+class URiftlineInteractableComponent;
+class URiftlineInteractionSubsystem;
+struct FRiftlineInteractionCandidate;
+struct FRiftlineInteractionQuery;
 
 USTRUCT(BlueprintType)
 struct FRiftlineInteractionOption
@@ -19,6 +24,9 @@ struct FRiftlineInteractionOption
     FText Label;
 };
 
+/** Immutable option list shared by the interaction option cache, hits and the HUD radial. */
+using FRiftlineInteractionOptionsPtr = TSharedPtr<const TArray<FRiftlineInteractionOption>>;
+
 USTRUCT(BlueprintType)
 struct FRiftlineInteractionHit
 {
@@ -30,17 +38,21 @@ struct FRiftlineInteractionHit
     UPROPERTY(BlueprintReadOnly, Category = "Riftline|Interaction")
     FVector ImpactPoint = FVector::ZeroVector;
 
+    /** Filled for Blueprint consumers: OnInteractionOptions broadcasts and FindInteraction. */
     UPROPERTY(BlueprintReadOnly, Category = "Riftline|Interaction")
     TArray<FRiftlineInteractionOption> Options;
+
+    /** The same options without a copy, for native consumers; never modified once published. */
+    FRiftlineInteractionOptionsPtr SharedOptions;
 };
 
 UINTERFACE(BlueprintType)
-class URiftlineInteractable : public UInterface
+class RIFTLINE_API URiftlineInteractable : public UInterface
 {
     GENERATED_BODY()
 };
 
-class IRiftlineInteractable
+class RIFTLINE_API IRiftlineInteractable
 {
     GENERATED_BODY()
 
@@ -71,22 +83,112 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Riftline|Interaction")
     bool bAutoInvokeSingleOption;
 
+    /** Registered interactables within TraceDistance and this many degrees of the view direction are candidates. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Riftline|Interaction", meta = (ClampMin = "1", ClampMax = "90"))
+    float CandidateHalfAngle;
+
+    /** 0 picks the closest candidate, 1 the one nearest the crosshair. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Riftline|Interaction", meta = (ClampMin = "0", ClampMax = "1"))
+    float CandidateAngleWeight;
+
+    /** Best-scoring candidates confirmed with an occlusion trace before giving up. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Riftline|Interaction", meta = (ClampMin = "1"))
+    int32 MaxOcclusionChecks;
+
+    /** Falls back to a crosshair trace for interactables without a URiftlineInteractableComponent. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Riftline|Interaction")
+    bool bTraceUnregisteredInteractables;
+
+    /**
+     * Tracks the best interactable at FocusUpdateHz and broadcasts OnInteractionOptions only when the focused actor
+     * or its options change; a broadcast with no actor means focus was lost. Updates are scheduled and traced in
+     * batches by URiftlineInteractionSubsystem, so the component itself never ticks.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Riftline|Interaction")
+    bool bTrackFocus;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Riftline|Interaction", meta = (ClampMin = "1", ClampMax = "60"))
+    float FocusUpdateHz;
+
+    /** Score lead another candidate needs over the current focus before focus moves to it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Riftline|Interaction", meta = (ClampMin = "0", ClampMax = "1"))
+    float FocusSwitchMargin;
+
+    /** How long focus survives being occluded or leaving the cone before it is dropped. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Riftline|Interaction", meta = (ClampMin = "0"))
+    float FocusLossGraceSeconds;
+
     UPROPERTY(BlueprintAssignable, Category = "Riftline|Interaction")
     FRiftlineInteractionOptionsDelegate OnInteractionOptions;
 
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Interaction")
+    void SetFocusTracking(bool bEnabled);
+
+    UFUNCTION(BlueprintPure, Category = "Riftline|Interaction")
+    AActor* GetFocusedActor() const { return FocusActor.Get(); }
+
+    const FRiftlineInteractionOptionsPtr& GetFocusedOptions() const { return FocusOptions; }
+
+    /**
+     * With bTrackFocus this returns the batched focus and costs no physics query. Otherwise it sweeps synchronously
+     * (grid lookup plus up to MaxOcclusionChecks traces), which suits one-off queries such as an input press; callers
+     * that poll every frame should enable bTrackFocus instead.
+     */
     UFUNCTION(BlueprintCallable, Category = "Riftline|Interaction")
     bool FindInteraction(FRiftlineInteractionHit& OutHit) const;
 
     UFUNCTION(BlueprintCallable, Category = "Riftline|Interaction")
     bool InvokeInteraction(FName OptionId);
 
+    /** Acts on FindInteraction's result, so it is only synchronous for components that do not track focus. */
     UFUNCTION(BlueprintCallable, Category = "Riftline|Interaction")
     bool TryInteract();
 
+    /** True while the last trace found an interactable that is still alive. */
+    bool HasInteractionTarget() const { return LastActor.IsValid(); }
+
 private:
-    TWeakObjectPtr<AActor> LastActor;
-    TArray<FRiftlineInteractionOption> LastOptions;
+    friend class URiftlineInteractionSubsystem;
+
+    mutable TWeakObjectPtr<AActor> LastActor;
+    mutable FRiftlineInteractionOptionsPtr LastOptions;
+
+    struct FCachedOptions
+    {
+        uint32 Version = 0;
+        FRiftlineInteractionOptionsPtr Options;
+    };
+    mutable TMap<TObjectKey<URiftlineInteractableComponent>, FCachedOptions> OptionCache;
+
+    TWeakObjectPtr<AActor> FocusActor;
+    FRiftlineInteractionOptionsPtr FocusOptions;
+    FVector FocusPoint = FVector::ZeroVector;
+    double FocusLostAt = -1.0;
+
+    bool bFocusQueryInFlight = false;
 
     APawn* ResolvePawnOwner() const;
-    bool GatherOptions(AActor* TargetActor, APawn* InstigatorPawn, TArray<FRiftlineInteractionOption>& OutOptions) const;
+    FRiftlineInteractionOptionsPtr GatherOptions(AActor* TargetActor, URiftlineInteractableComponent* Interactable, APawn* InstigatorPawn) const;
+    /** FindInteraction without the Blueprint copy of the options; only SharedOptions is set. */
+    bool FindSharedInteraction(FRiftlineInteractionHit& OutHit) const;
+    bool FindRegisteredInteraction(APawn* PawnOwner, const FVector& ViewLocation, const FVector& ViewDirection, FRiftlineInteractionHit& OutHit) const;
+    bool TraceInteraction(APawn* PawnOwner, const FVector& ViewLocation, const FVector& ViewDirection, FRiftlineInteractionHit& OutHit) const;
+
+    float GetFocusInterval() const { return 1.f / FMath::Max(FocusUpdateHz, 1.f); }
+
+    /**
+     * Fills occlusion traces for up to MaxOcclusionChecks candidates, best first, then the crosshair trace when
+     * unregistered interactables are traced; false when there is nothing to trace.
+     */
+    bool PrepareFocusQuery(const URiftlineInteractionSubsystem& Registry, TArray<FRiftlineInteractionCandidate>& Candidates, FRiftlineInteractionQuery& OutQuery);
+
+    /** Focuses the first clear trace's actor; no actor means every trace was blocked. */
+    void HandleFocusResult(AActor* Target, URiftlineInteractableComponent* Interactable, const FVector& Point);
+    void SetFocus(AActor* Actor, const FRiftlineInteractionOptionsPtr& Options, const FVector& Point);
+    void LoseFocus(bool bImmediate);
+    void BroadcastFocus();
+    void BroadcastHit(FRiftlineInteractionHit& Hit);
 };
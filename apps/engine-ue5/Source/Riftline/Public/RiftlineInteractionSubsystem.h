@@ -0,0 +1,189 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "RiftlineInteractionComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "RiftlineInteractionSubsystem.generated.h"
+
+class URiftlineInteractableComponent;
+
+struct FRiftlineInteractionCandidate
+{
+    AActor* Actor = nullptr;
+    URiftlineInteractableComponent* Component = nullptr;
+    FVector Location = FVector::ZeroVector;
+    float Distance = 0.f;
+
+    /** 0..1, higher is a better match for the viewer. */
+    float Score = 0.f;
+};
+
+/** One focus trace: confirms a registered candidate, or without a Target takes whatever the crosshair hits. */
+struct FRiftlineInteractionTrace
+{
+    FVector End = FVector::ZeroVector;
+    TWeakObjectPtr<AActor> Target;
+    TWeakObjectPtr<URiftlineInteractableComponent> Interactable;
+};
+
+/** Focus traces prepared by an interactor and issued by URiftlineInteractionSubsystem as part of the frame's batch. */
+struct FRiftlineInteractionQuery
+{
+    /** Traces one query may issue; the trace index rides in the low bits of the async trace's user data. */
+    static constexpr int32 MaxTraces = 8;
+
+    FVector Start = FVector::ZeroVector;
+    TEnumAsByte<ECollisionChannel> Channel = ECC_Visibility;
+
+    /** Best candidate first; the first trace with a clear line of sight takes focus. */
+    TArray<FRiftlineInteractionTrace, TInlineAllocator<MaxTraces>> Traces;
+};
+
+/**
+ * Registry of interactables bucketed into a uniform grid on the XY plane, so interaction queries only visit the
+ * cells around the viewer instead of issuing physics queries. Entries are registered by URiftlineInteractableComponent.
+ *
+ * Also the world's interaction manager: focus-tracking URiftlineInteractionComponents (players, bots, NPCs) do not
+ * tick; once per frame the subsystem picks the interactors that are due, prepares their queries in grid order and
+ * issues the focus traces as one async batch, then hands each result back to its interactor.
+ */
+UCLASS()
+class RIFTLINE_API URiftlineInteractionSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Cap on focus traces issued per frame; the most overdue interactors go first and the rest wait a frame. */
+    int32 MaxFocusQueriesPerFrame = 256;
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    int32 Register(URiftlineInteractableComponent* Component);
+    void Unregister(int32 Handle);
+    void UpdateLocation(int32 Handle, const FVector& Location);
+
+    /**
+     * Collects interactables within Radius of Origin and HalfAngleDegrees of Direction, best first. AngleWeight
+     * (0..1) trades alignment with the view against closeness when scoring.
+     */
+    void QueryCandidates(
+        const FVector& Origin,
+        const FVector& Direction,
+        float Radius,
+        float HalfAngleDegrees,
+        float AngleWeight,
+        TArray<FRiftlineInteractionCandidate>& OutCandidates) const;
+
+    int32 GetNumRegistered() const { return Entries.Num(); }
+
+    void AddInteractor(URiftlineInteractionComponent* Interactor);
+    void RemoveInteractor(URiftlineInteractionComponent* Interactor);
+    int32 GetNumInteractors() const { return Interactors.Num(); }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<URiftlineInteractableComponent> Component;
+        FVector Location = FVector::ZeroVector;
+        FIntPoint Cell = FIntPoint::ZeroValue;
+    };
+
+    struct FInteractor
+    {
+        TWeakObjectPtr<URiftlineInteractionComponent> Component;
+        double NextUpdateAt = 0.0;
+    };
+
+    struct FBatchEntry
+    {
+        int32 Interactor = INDEX_NONE;
+        double Overdue = 0.0;
+        FIntPoint Cell = FIntPoint::ZeroValue;
+    };
+
+    struct FTraceResult
+    {
+        bool bLanded = false;
+        bool bClear = false;
+        TWeakObjectPtr<AActor> Actor;
+        FVector Point = FVector::ZeroVector;
+    };
+
+    struct FInFlightQuery
+    {
+        TWeakObjectPtr<URiftlineInteractionComponent> Component;
+        FRiftlineInteractionQuery Query;
+        TArray<FTraceResult, TInlineAllocator<FRiftlineInteractionQuery::MaxTraces>> Results;
+        uint64 IssuedFrame = 0;
+    };
+
+    TSparseArray<FEntry> Entries;
+    TMap<FIntPoint, TArray<int32>> Cells;
+
+    TArray<FInteractor> Interactors;
+    TMap<uint32, FInFlightQuery> InFlight;
+    uint32 NextQueryId = 1;
+    FTraceDelegate TraceDelegate;
+
+    /** Scratch reused by every frame's batch so preparing hundreds of queries does not allocate. */
+    TArray<FBatchEntry> Batch;
+    TArray<FRiftlineInteractionCandidate> CandidateScratch;
+
+    static FIntPoint CellOf(const FVector& Location);
+    void RemoveFromCell(int32 Handle, const FIntPoint& Cell);
+    void ExpireInFlight();
+    void HandleTrace(const FTraceHandle& Handle, FTraceDatum& Datum);
+};
+
+/**
+ * Marks its owner as interactable and registers it with URiftlineInteractionSubsystem. Place it where the prompt
+ * should anchor (a shop counter, a car door); its location is the aim and occlusion target.
+ */
+UCLASS(ClassGroup = (Riftline), meta = (BlueprintSpawnableComponent))
+class RIFTLINE_API URiftlineInteractableComponent : public USceneComponent
+{
+    GENERATED_BODY()
+
+public:
+    URiftlineInteractableComponent();
+
+    /**
+     * Lets interactors cache gathered options per version. Off by default: GetInteractionOptions receives the
+     * requesting pawn, so only enable it when the options do not depend on who asks. Published options are always cached.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Riftline|Interaction")
+    bool bCacheOptions;
+
+    /** Publishes a fixed option list so interactors never call GetInteractionOptions on this actor. */
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Interaction")
+    void PublishOptions(const TArray<FRiftlineInteractionOption>& Options);
+
+    /** Bumps the version so interactors gather options again, e.g. when a shop closes. */
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Interaction")
+    void InvalidateOptions();
+
+    uint32 GetOptionsVersion() const { return OptionsVersion; }
+    bool HasPublishedOptions() const { return bOptionsPublished; }
+    const FRiftlineInteractionOptionsPtr& GetPublishedOptions() const { return PublishedOptions; }
+
+protected:
+    virtual void OnRegister() override;
+    virtual void OnUnregister() override;
+    virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport) override;
+
+private:
+    TWeakObjectPtr<URiftlineInteractionSubsystem> Registry;
+    int32 RegistryHandle = INDEX_NONE;
+
+    FRiftlineInteractionOptionsPtr PublishedOptions;
+    uint32 OptionsVersion = 1;
+    bool bOptionsPublished = false;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "Templates/Function.h"
+#include "UObject/Class.h"
+
+/**
+ * Decodes backend JSON straight into reflected structs without building a DOM. The text is pulled token by token and
+ * each value is written into the property it maps to, so a page of 200 auctions costs one pass and the final structs
+ * rather than a tree of shared JSON values plus a second walk over it.
+ *
+ * Keys map to the lower-camel property name (bools drop their "b" prefix), plus a fixed table of gateway names that
+ * differ, such as an auction's "highestBid" into Price. The mapping is resolved once per struct and cached, so decoding
+ * is safe from any thread. Unknown keys and nulls are skipped; numbers and strings convert both ways; FDateTime reads
+ * ISO-8601 or Unix milliseconds; objects landing in a string field are kept as compact JSON.
+ */
+namespace RiftlineJson
+{
+    /** Decodes one JSON object into Out, leaving fields the text does not mention untouched. */
+    RIFTLINE_API bool DecodeStruct(const UScriptStruct* Struct, void* Out, const FString& Json);
+
+    /** Decodes a JSON array of objects; AddElement returns storage for the next one, used only until it is called again. */
+    RIFTLINE_API bool DecodeStructArray(const UScriptStruct* Struct, TFunctionRef<void*()> AddElement, const FString& Json);
+
+    /** Response bodies are UTF-8; converted once, on whichever thread decodes them. */
+    RIFTLINE_API FString Utf8ToString(const TArray<uint8>& Utf8);
+
+    template <typename T>
+    bool Decode(const FString& Json, T& Out)
+    {
+        return DecodeStruct(T::StaticStruct(), &Out, Json);
+    }
+
+    template <typename T>
+    bool Decode(const FString& Json, TArray<T>& Out)
+    {
+        Out.Reset();
+        return DecodeStructArray(T::StaticStruct(), [&Out]() { return static_cast<void*>(&Out.AddDefaulted_GetRef()); }, Json);
+    }
+
+    /**
+     * Decodes Utf8 on a background worker and moves the result to OnDecoded(bool bSucceeded, T&& Value) on the game
+     * thread. T is a struct or a TArray of structs. The caller guards against its owner having gone away meanwhile.
+     */
+    template <typename T, typename FuncType>
+    void DecodeAsync(TArray<uint8>&& Utf8, FuncType&& OnDecoded)
+    {
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Utf8 = MoveTemp(Utf8), OnDecoded = Forward<FuncType>(OnDecoded)]() mutable
+        {
+            T Value;
+            const bool bSucceeded = Decode(Utf8ToString(Utf8), Value);
+            AsyncTask(ENamedThreads::GameThread, [bSucceeded, Value = MoveTemp(Value), OnDecoded = MoveTemp(OnDecoded)]() mutable
+            {
+                OnDecoded(bSucceeded, MoveTemp(Value));
+            });
+        });
+    }
+}
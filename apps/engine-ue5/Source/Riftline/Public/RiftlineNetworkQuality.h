@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RiftlinePerformanceMonitor.h"
+#include "RiftlineNetworkQuality.generated.h"
+
+struct FRiftlineHttpResult;
+
+/** Link quality over the most recent round trips, for gameplay and UI. */
+USTRUCT(BlueprintType)
+struct FRiftlineNetworkQualitySnapshot
+{
+    GENERATED_BODY()
+
+    /** Network round-trip time with server handling time removed where the server reports it. */
+    UPROPERTY(BlueprintReadOnly)
+    float RttP50Ms = 0.f;
+
+    UPROPERTY(BlueprintReadOnly)
+    float RttP95Ms = 0.f;
+
+    /** Share of recent attempts that got no response or a 5xx. */
+    UPROPERTY(BlueprintReadOnly)
+    float FailureRate = 0.f;
+
+    /** Server clock minus local clock. */
+    UPROPERTY(BlueprintReadOnly)
+    float ClockOffsetMs = 0.f;
+
+    /** Bound on the offset error: half the round trip of the sample it came from. */
+    UPROPERTY(BlueprintReadOnly)
+    float ClockErrorMs = 0.f;
+
+    UPROPERTY(BlueprintReadOnly)
+    bool bClockSynced = false;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 Samples = 0;
+};
+
+struct FRiftlineNetworkHostWindow
+{
+    int32 Requests = 0;
+    int32 Failures = 0;
+    FRiftlineHistogram RoundTrips;
+};
+
+/**
+ * Estimates round-trip time, failure rate and clock offset from the HTTP attempts the client already makes, heartbeats
+ * included. Responses stamped with the server's receive time and handling duration give NTP-style samples; the offset
+ * is taken from the lowest-delay sample of the last few, since queueing only ever adds delay and skews the estimate.
+ *
+ * Game thread only.
+ */
+class RIFTLINE_API FRiftlineNetworkQuality
+{
+public:
+    static constexpr int32 RecentCount = 64;
+    static constexpr int32 ClockFilterCount = 8;
+
+    /** Feeds one attempt to Host; attempts that got no response count only towards the failure rate. */
+    void RecordAttempt(const FString& Host, const FRiftlineHttpResult& Result);
+
+    /** Feeds one clock sample; all four times are Unix milliseconds. Returns false for inconsistent samples. */
+    bool RecordClockSample(int64 ClientSendMs, int64 ServerReceiveMs, int64 ServerSendMs, int64 ClientReceiveMs);
+
+    FRiftlineNetworkQualitySnapshot GetSnapshot() const;
+    bool HasClockSync() const { return ClockSampleCount > 0; }
+    FTimespan GetClockOffset() const { return FTimespan::FromMilliseconds(static_cast<double>(ClockOffsetMs)); }
+
+    /** Moves the per-host counters and round-trip histograms gathered since the last call into Out. */
+    void ConsumeWindow(TMap<FString, FRiftlineNetworkHostWindow>& Out);
+
+private:
+    struct FClockSample
+    {
+        int64 OffsetMs = 0;
+        int64 DelayMs = 0;
+    };
+
+    float RecentRoundTrips[RecentCount] = {};
+    int32 RecentRoundTripCount = 0;
+    int32 NextRoundTrip = 0;
+
+    /** One bit per recent attempt, set for failures. */
+    uint64 RecentFailures = 0;
+    int32 RecentAttemptCount = 0;
+
+    FClockSample ClockSamples[ClockFilterCount];
+    int32 ClockSampleCount = 0;
+    int32 NextClockSample = 0;
+    int64 ClockOffsetMs = 0;
+    int64 ClockErrorMs = 0;
+
+    TMap<FString, FRiftlineNetworkHostWindow> Window;
+
+    void AddRoundTrip(const FString& Host, float RoundTripMs);
+};
+
+namespace RiftlineNetwork
+{
+    /** The server's current time as best known; plain UTC until a clock sample has been taken. */
+    RIFTLINE_API FDateTime GetServerNow();
+
+    RIFTLINE_API void SetServerClockOffset(const FTimespan& Offset);
+
+    /** Reads the duration in milliseconds from a Server-Timing header such as "app;dur=12.5". */
+    RIFTLINE_API bool ParseServerTiming(const FString& Value, float& OutMs);
+}
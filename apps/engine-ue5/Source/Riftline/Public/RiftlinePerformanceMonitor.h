@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Log-linear histogram of microsecond values: exact below 16us, then 16 linear sub-buckets per power of two
+ * (about 6% relative error) up to ~67s. Storage is fixed, so Add is O(1) and never allocates.
+ */
+class RIFTLINE_API FRiftlineHistogram
+{
+public:
+    static constexpr int32 SubBucketBits = 4;
+    static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+    static constexpr int32 MaxValueBits = 26;
+    static constexpr int32 BucketCount = (MaxValueBits - SubBucketBits + 1) * SubBucketCount;
+
+    FRiftlineHistogram() { Reset(); }
+
+    void Add(uint32 ValueUs);
+    void Reset();
+
+    uint64 GetCount() const { return Count; }
+    uint32 GetMax() const { return Max; }
+    double GetMean() const { return Count > 0 ? static_cast<double>(Sum) / Count : 0.0; }
+
+    /** Returns the midpoint of the bucket holding the given quantile, clamped to the largest recorded value. */
+    uint32 ValueAtQuantile(double Quantile) const;
+
+private:
+    uint32 Counts[BucketCount];
+    uint64 Count;
+    uint64 Sum;
+    uint32 Max;
+
+    static int32 BucketIndex(uint32 ValueUs);
+    static uint32 BucketMidpoint(int32 Index);
+};
+
+enum class ERiftlineFrameTimer : uint8
+{
+    Frame,
+    GameThread,
+    RenderThread,
+    RHIThread,
+    GPU,
+    Count
+};
+
+struct FRiftlineFrameTimeStats
+{
+    float AvgMs = 0.f;
+    float P50Ms = 0.f;
+    float P90Ms = 0.f;
+    float P99Ms = 0.f;
+    float MaxMs = 0.f;
+};
+
+struct FRiftlineFrameTimeSummary
+{
+    int64 Frames = 0;
+    int32 Hitches = 0;
+    FRiftlineFrameTimeStats Timers[static_cast<int32>(ERiftlineFrameTimer::Count)];
+
+    const FRiftlineFrameTimeStats& operator[](ERiftlineFrameTimer Timer) const { return Timers[static_cast<int32>(Timer)]; }
+};
+
+/** Timings of a single frame that crossed the hitch threshold. */
+struct FRiftlineHitchSample
+{
+    float TimesMs[static_cast<int32>(ERiftlineFrameTimer::Count)] = {};
+
+    float operator[](ERiftlineFrameTimer Timer) const { return TimesMs[static_cast<int32>(Timer)]; }
+};
+
+DECLARE_DELEGATE_OneParam(FRiftlineHitchDelegate, const FRiftlineHitchSample&);
+
+/**
+ * Records every frame's wall time plus the engine's game, render, RHI and GPU timings into histograms; summaries
+ * are taken and reset once per reporting window. Thread timings lag the frame they describe by up to a frame,
+ * which is fine for distributions but means a hitch sample reports the most recent completed measurement.
+ */
+class RIFTLINE_API FRiftlinePerformanceMonitor
+{
+public:
+    FRiftlinePerformanceMonitor(float InHitchThresholdMs, int32 InMaxHitchReportsPerWindow);
+    ~FRiftlinePerformanceMonitor();
+
+    void Start();
+    void Stop();
+
+    /** Fills Out with the window since the last call and starts a new one; returns false if no frames were seen. */
+    bool ConsumeWindow(FRiftlineFrameTimeSummary& Out);
+
+    /** Fired on the game thread for each hitch, up to the per-window report cap. */
+    FRiftlineHitchDelegate OnHitch;
+
+private:
+    FRiftlineHistogram Histograms[static_cast<int32>(ERiftlineFrameTimer::Count)];
+    uint32 HitchThresholdUs;
+    int32 MaxHitchReportsPerWindow;
+    int32 Hitches = 0;
+    double LastFrameSeconds = 0.0;
+
+    FDelegateHandle EndFrameHandle;
+    FDelegateHandle ForegroundHandle;
+
+    void HandleEndFrame();
+    void HandleEnteredForeground();
+};
@@ -2,14 +2,22 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Engine/EngineTypes.h"
+#include "RiftlineAuctionModel.h"
+#include "RiftlineSessionStore.h"
 #include "RiftlineTypes.h"
+#include "UObject/SoftObjectPtr.h"
 #include "RiftlinePhoneWidget.generated.h"
 
 class UButton;
+class UListView;
 class UTextBlock;
 class UWidget;
 class UWidgetSwitcher;
+class FRiftlineTelemetryEvent;
+class URiftlineBackendSubsystem;
 class URiftlineGameInstance;
+struct FStreamableHandle;
 
 UCLASS(Abstract, Blueprintable)
 class RIFTLINE_API URiftlinePhoneWidget : public UUserWidget
@@ -20,6 +28,10 @@ public:
     URiftlinePhoneWidget(const FObjectInitializer& ObjectInitializer);
 
     virtual void NativeOnInitialized() override;
+    virtual void BeginDestroy() override;
+
+    /** Session store subscription; runs only the handlers for the fields in Changed. */
+    void HandleSessionChanges(const FRiftlineSessionStore& Store, ERiftlineSessionField Changed);
 
     void HandleSessionUpdated(const FRiftlineSessionProfile& Profile);
     void HandleWantedUpdated(const FRiftlineWantedState& State);
@@ -34,9 +46,23 @@ public:
     UFUNCTION()
     void OnComplianceChanged(const FRiftlineComplianceState& Compliance);
 
+    /** Full snapshot of the listings; applied as a diff against the auction model. */
     UFUNCTION()
     void OnAuctionsUpdated(const TArray<FRiftlineAuctionRow>& Rows);
 
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Phone")
+    void ApplyAuctionUpserts(const TArray<FRiftlineAuctionRow>& Rows);
+
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Phone")
+    void ApplyAuctionRemovals(const TArray<int32>& AuctionIds);
+
+    UFUNCTION(BlueprintPure, Category = "Riftline|Phone")
+    URiftlineAuctionModel* GetAuctionModel();
+
+    /** Points the phone at the list showing the auctions, e.g. from OnTabContentCreated when the tab is lazy. */
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Phone")
+    void SetAuctionListView(UListView* ListView);
+
     UFUNCTION(BlueprintCallable, Category = "Riftline|Phone")
     void SetActiveTab(ERiftlinePhoneTab Tab, bool bEmitTelemetry = true);
 
@@ -62,7 +88,7 @@ public:
     void OnMissionsUpdated(const TArray<FText>& Missions);
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Riftline|Phone")
-    void OnAuctionsChanged(const TArray<FRiftlineAuctionRow>& Rows);
+    void OnAuctionsChanged(const FRiftlineAuctionChangeSet& Changes);
 
     UFUNCTION(BlueprintImplementableEvent, Category = "Riftline|Phone")
     void OnPhoneVisibilityChanged(bool bVisible);
@@ -70,10 +96,41 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Riftline|Phone")
     void NotifyPhoneVisible(bool bVisible);
 
+    /** Content of a lazily created tab, or null until it has loaded (and after it is released). */
+    UFUNCTION(BlueprintPure, Category = "Riftline|Phone")
+    UUserWidget* GetTabContent(ERiftlinePhoneTab Tab) const;
+
+    /** Releases lazily created tabs, other than the active one, that have been inactive for at least MinIdleSeconds. */
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Phone")
+    void ReleaseInactiveTabs(float MinIdleSeconds = 0.f);
+
+    /** Fill a freshly created tab from the cached session, wallet and auction state. */
+    UFUNCTION(BlueprintImplementableEvent, Category = "Riftline|Phone")
+    void OnTabContentCreated(ERiftlinePhoneTab Tab, UUserWidget* Content);
+
+    UFUNCTION(BlueprintImplementableEvent, Category = "Riftline|Phone")
+    void OnTabContentReleased(ERiftlinePhoneTab Tab);
+
 protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Riftline|Phone")
     ERiftlinePhoneTab DefaultTab = ERiftlinePhoneTab::Shards;
 
+    /**
+     * Tabs whose content is created on first activation: the class is loaded asynchronously and the widget added to
+     * the tab's panel in Tabs (an empty Border or SizeBox in the layout). Tabs without an entry keep their designer
+     * content resident.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Phone")
+    TMap<ERiftlinePhoneTab, TSoftClassPtr<UUserWidget>> TabContentClasses;
+
+    /** Lazily created tabs left inactive this long are released; they are also released when the OS reports low memory. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Phone", meta = (ClampMin = "0"))
+    float TabIdleReleaseSeconds;
+
+    /** Reopening the auctions tab within this long of the last fetch reuses the listings; realtime upserts keep them current. */
+    UPROPERTY(EditDefaultsOnly, Category = "Riftline|Phone", meta = (ClampMin = "0"))
+    float AuctionRefreshMinSeconds;
+
     UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
     UWidgetSwitcher* Tabs;
 
@@ -113,6 +170,10 @@ protected:
     UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
     UWidget* AuctionsEmptyState;
 
+    /** Virtualized list of URiftlineAuctionItem; its entry class should derive from URiftlineAuctionEntryWidget. */
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+    UListView* AuctionList;
+
     UPROPERTY(BlueprintReadOnly, Category = "Riftline|Phone")
     FRiftlineSessionProfile CachedSession;
 
@@ -128,8 +189,8 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "Riftline|Phone")
     FRiftlineComplianceState CachedCompliance;
 
-    UPROPERTY(BlueprintReadOnly, Category = "Riftline|Phone")
-    TArray<FRiftlineAuctionRow> CachedAuctions;
+    UPROPERTY(Transient)
+    URiftlineAuctionModel* Auctions;
 
     UPROPERTY(BlueprintReadOnly, Category = "Riftline|Phone")
     ERiftlinePhoneTab ActiveTab;
@@ -150,14 +211,49 @@ private:
     UFUNCTION()
     void HandleMessagesTabClicked();
 
-    void EmitTelemetry(const FString& Event) const;
-    void EmitTelemetry(const FString& Event, const TMap<FString, FString>& Properties) const;
+    void EmitTelemetry(const FRiftlineTelemetryEvent& Event) const;
     URiftlineGameInstance* ResolveGameInstance() const;
+    URiftlineBackendSubsystem* ResolveBackend() const;
 
     void UpdateShardDetails(const FRiftlineShardStatus& Status);
     void UpdateComplianceDetails(const FRiftlineComplianceState& Compliance);
     void UpdateWalletDetails(const FRiftlineWalletView& Wallet);
     void RefreshAuctionsUI();
+    void UpdateAuctionCountdown();
+    void UpdateAuctionCountdownTimer();
+    bool IsAuctionTabShown() const { return bPhoneShown && ActiveTab == ERiftlinePhoneTab::Auctions; }
+
+    UFUNCTION()
+    void HandleAuctionChanges(const FRiftlineAuctionChangeSet& Changes);
+
+    static constexpr int32 NumTabs = static_cast<int32>(ERiftlinePhoneTab::Messages) + 1;
+
+    struct FLazyTab
+    {
+        TSharedPtr<FStreamableHandle> Handle;
+        /** Platform seconds when the tab was last left, or negative while it is active. */
+        double InactiveSince = -1.0;
+    };
+
+    /** Indexed by ERiftlinePhoneTab; only lazily created tabs have entries. */
+    UPROPERTY(Transient)
+    TArray<UUserWidget*> TabContent;
+
+    FLazyTab LazyTabs[NumTabs];
+    FTimerHandle IdleReleaseTimer;
+    FTimerHandle AuctionCountdownTimer;
+    FDelegateHandle MemoryTrimHandle;
+
+    /** Platform seconds when /auctions was last requested, or negative before the first fetch. */
+    double AuctionsRequestedAt = -1.0;
+
+    void EnsureTabContent(ERiftlinePhoneTab Tab);
+    void CreateTabContent(ERiftlinePhoneTab Tab);
+    void ReleaseTab(int32 Index);
+    void ReleaseIdleTabs();
+    void HandleMemoryTrim();
 
     bool bWalletLoginTelemetrySent = false;
+    bool bPhoneShown = false;
+    bool bAuctionListStale = true;
 };
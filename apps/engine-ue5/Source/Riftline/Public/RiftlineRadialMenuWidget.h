@@ -22,6 +22,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Riftline|Radial")
     void SetEntries(const TArray<FRiftlineInteractionOption>& InEntries);
 
+    /** Takes the interaction component's shared option list; handing over the same list again is a no-op. */
+    void SetSharedEntries(const FRiftlineInteractionOptionsPtr& InEntries);
+
     UFUNCTION(BlueprintCallable, Category = "Riftline|Radial")
     void ClearEntries();
 
@@ -31,4 +34,8 @@ public:
 protected:
     UFUNCTION(BlueprintImplementableEvent, Category = "Riftline|Radial")
     void HandleEntriesChanged();
+
+private:
+    /** List Entries was last copied from, so repeated focus broadcasts of the same options skip the copy. */
+    FRiftlineInteractionOptionsPtr SharedEntries;
 };
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RiftlineTypes.h"
+
+enum class ERiftlineRealtimeUpdate : uint8
+{
+    Wanted,
+    Compliance,
+    ShardPopulation,
+    WalletView,
+    Count
+};
+
+/** Live state pushed by Nakama, decoded into the types the game instance already applies. */
+struct FRiftlineRealtimeUpdate
+{
+    ERiftlineRealtimeUpdate Kind = ERiftlineRealtimeUpdate::Wanted;
+
+    /** Player the update is about; empty when it is addressed to the receiving player. */
+    FString UserId;
+
+    /** Server time of a notification; unset for match data, which is always current. */
+    FDateTime CreatedAt = FDateTime(0);
+
+    FRiftlineWantedState Wanted;
+    FRiftlineComplianceState Compliance;
+    FRiftlineWalletView WalletView;
+    int32 Population = 0;
+};
+
+/** One server message on the Nakama socket, reduced to what the client acts on. */
+struct FRiftlineRealtimeEnvelope
+{
+    enum class EType : uint8
+    {
+        Unknown,
+        Pong,
+        Match,
+        MatchData,
+        Notifications,
+        Error
+    };
+
+    EType Type = EType::Unknown;
+    FString Cid;
+    FString MatchId;
+    FString Error;
+    TArray<FRiftlineRealtimeUpdate> Updates;
+};
+
+/** Nakama realtime wire format (JSON socket and REST), shared by URiftlineRealtimeSubsystem and its specs. */
+namespace RiftlineRealtime
+{
+    /** Match data op codes of the shard match handler in backend/nakama/modules/ts/src/match/shard.ts. */
+    namespace OpCodes
+    {
+        constexpr int64 HeatDelta = 1;
+        constexpr int64 WantedUpdate = 2;
+        constexpr int64 PresenceIdle = 3;
+        constexpr int64 ShardStatus = 4;
+    }
+
+    /** Subjects of persistent notifications that carry state; the content is the record as stored by the modules. */
+    namespace Subjects
+    {
+        inline const TCHAR* const Wanted = TEXT("wanted");
+        inline const TCHAR* const Compliance = TEXT("compliance");
+        inline const TCHAR* const Wallet = TEXT("wallet");
+    }
+
+    /** RPCs of backend/nakama/modules/ts/src/rpc, under the default module name. */
+    namespace Rpcs
+    {
+        inline const TCHAR* const ShardMatch = TEXT("riftline_shardMatch");
+    }
+
+    RIFTLINE_API bool DecodeEnvelope(const FString& Message, FRiftlineRealtimeEnvelope& Out);
+
+    /**
+     * Decodes GET /v2/notification; OutCursor resumes the listing after the last notification returned, and OutListed
+     * counts every notification on the page so a full page can be told from the end of the listing.
+     */
+    RIFTLINE_API bool DecodeNotificationList(const FString& Body, FRiftlineRealtimeEnvelope& Out, FString& OutCursor, int32& OutListed);
+
+    /** Reads the match id returned by the shard match RPC. */
+    RIFTLINE_API bool DecodeShardMatch(const FString& Body, FString& OutMatchId);
+
+    /** Reads the token and refresh token from an authenticate or refresh response. */
+    RIFTLINE_API bool DecodeSession(const FString& Body, FString& OutToken, FString& OutRefreshToken);
+
+    /** Reads the user id and expiry claims of a Nakama session token without verifying it. */
+    RIFTLINE_API bool ParseToken(const FString& Token, FString& OutUserId, FDateTime& OutExpiresAt);
+
+    RIFTLINE_API FString EncodePing(const FString& Cid);
+    RIFTLINE_API FString EncodeMatchJoin(const FString& Cid, const FString& MatchId);
+    RIFTLINE_API FString EncodeMatchLeave(const FString& Cid, const FString& MatchId);
+}
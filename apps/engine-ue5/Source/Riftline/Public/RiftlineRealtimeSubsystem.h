@@ -0,0 +1,133 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "RiftlineRealtimeProtocol.h"
+#include "RiftlineSessionStore.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "RiftlineRealtimeSubsystem.generated.h"
+
+class IWebSocket;
+
+UENUM(BlueprintType)
+enum class ERiftlineRealtimeState : uint8
+{
+    Disconnected,
+    Authenticating,
+    Connecting,
+    Connected,
+    WaitingToReconnect
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRiftlineRealtimeStateDelegate, ERiftlineRealtimeState, State);
+
+/**
+ * Holds one WebSocket to Nakama for the session and applies what it pushes (wanted, compliance, shard population,
+ * wallet) through the game instance, so live state no longer depends on polling.
+ *
+ * Connects once the session profile has a player id and the game instance has a Nakama URL, and starts over when the
+ * player changes. The device session is authenticated once and reused across reconnects until it nears expiry. The
+ * match of the profile's shard is looked up through the shard match RPC and joined, and switched when the shard
+ * changes. Dropped sockets reconnect with jittered exponential backoff; on reconnect the shard match is rejoined and
+ * notifications sent while offline are listed from where the last listing stopped, to the end, before any is applied.
+ * The socket is closed in the background and reopened on return.
+ */
+UCLASS()
+class RIFTLINE_API URiftlineRealtimeSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Backoff starts here and doubles per failed attempt up to MaxReconnectDelay. */
+    float BaseReconnectDelay = 1.f;
+    float MaxReconnectDelay = 30.f;
+
+    /** Keeps NAT mappings open; a ping still unanswered at the next one marks the socket dead. */
+    float PingInterval = 15.f;
+
+    /** Sessions closer than this to expiry are refreshed before the socket is opened. */
+    float TokenRefreshMargin = 60.f;
+
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Realtime")
+    void Connect();
+
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Realtime")
+    void Disconnect();
+
+    /** Joins the shard's authoritative match now if connected, and again after every reconnect. */
+    UFUNCTION(BlueprintCallable, Category = "Riftline|Realtime")
+    void JoinShardMatch(const FString& MatchId);
+
+    UFUNCTION(BlueprintPure, Category = "Riftline|Realtime")
+    ERiftlineRealtimeState GetState() const { return State; }
+
+    UPROPERTY(BlueprintAssignable)
+    FRiftlineRealtimeStateDelegate OnStateChanged;
+
+private:
+    ERiftlineRealtimeState State = ERiftlineRealtimeState::Disconnected;
+    bool bWantConnection = false;
+    bool bSuspended = false;
+    bool bAwaitingPong = false;
+    int32 Attempt = 0;
+
+    /** Bumped whenever the connection is torn down, so late callbacks from an older attempt are ignored. */
+    uint32 Generation = 0;
+
+    FString Token;
+    FString RefreshToken;
+    FString UserId;
+    FDateTime TokenExpiresAt = FDateTime(0);
+
+    /** Player and shard the connection was set up for, so a session change can tell what has to be redone. */
+    FString SessionPlayerId;
+    int32 SessionShardId = INDEX_NONE;
+
+    FString ShardMatchId;
+    FString NotificationCursor;
+
+    /** Updates from the pages of the listing in progress, applied together once it is exhausted. */
+    FRiftlineRealtimeEnvelope PendingNotifications;
+
+    /** Newest notification applied per update kind, so a resume listing never rolls back state the socket delivered. */
+    FDateTime LastApplied[static_cast<int32>(ERiftlineRealtimeUpdate::Count)];
+    int32 NextCid = 1;
+
+    TSharedPtr<IWebSocket> Socket;
+    FTimerHandle ReconnectTimer;
+    FTimerHandle PingTimer;
+    FDelegateHandle SessionSubscription;
+    FDelegateHandle BackgroundHandle;
+    FDelegateHandle ForegroundHandle;
+
+    void BeginAttempt();
+    void Authenticate();
+    void RefreshSession();
+    void HandleSessionResponse(bool bSucceeded, const FString& Body, uint32 RequestGeneration);
+    void OpenSocket();
+    void CloseSocket();
+    void ScheduleReconnect();
+    void SendPing();
+    void FetchMissedNotifications();
+    void FetchNotificationPage(const FString& Cursor);
+    void ResolveShardMatch();
+    void LeaveShardMatch();
+
+    void HandleConnected(uint32 SocketGeneration);
+    void HandleConnectionError(const FString& Error, uint32 SocketGeneration);
+    void HandleClosed(int32 StatusCode, const FString& Reason, bool bWasClean, uint32 SocketGeneration);
+    void HandleMessage(const FString& Message, uint32 SocketGeneration);
+    void ApplyEnvelope(const FRiftlineRealtimeEnvelope& Envelope);
+
+    void HandleSessionChanges(const FRiftlineSessionStore& Store, ERiftlineSessionField Changed);
+    void HandleEnterBackground();
+    void HandleEnterForeground();
+
+    void SetState(ERiftlineRealtimeState NewState);
+    FString NextCidString() { return FString::FromInt(NextCid++); }
+    bool HasUsableToken() const;
+};
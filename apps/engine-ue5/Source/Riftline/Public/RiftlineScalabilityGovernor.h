@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RiftlineDeviceState.h"
+#include "RiftlineScalabilityGovernor.generated.h"
+
+struct FRiftlineFrameTimeSummary;
+
+/** One rung of the governor ladder; rung 0 is the highest quality. */
+USTRUCT(BlueprintType)
+struct FRiftlineGovernorStep
+{
+    GENERATED_BODY()
+
+    /** Applied to every scalability group (0 = low .. 3 = epic). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0", ClampMax = "3"))
+    int32 ScalabilityLevel = 3;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "15"))
+    float MaxFps = 60.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "25", ClampMax = "100"))
+    float ScreenPercentage = 100.f;
+};
+
+enum class ERiftlineGovernorReason : uint8
+{
+    None,
+    Thermal,
+    FrameTime,
+    Headroom
+};
+
+/**
+ * Steps scalability, the frame-rate cap and screen percentage along a ladder of FRiftlineGovernorStep. It steps
+ * down after DownWindows consecutive windows under pressure (immediately on critical thermal state) and up only
+ * after UpWindows consecutive windows with headroom against the next rung's budget, so it does not oscillate.
+ */
+class RIFTLINE_API FRiftlineScalabilityGovernor
+{
+public:
+    FRiftlineScalabilityGovernor(const TArray<FRiftlineGovernorStep>& InSteps, int32 InDownWindows, int32 InUpWindows);
+
+    /** Applies the rung matching the quality the device profile already picked, so weak devices do not start at the top. */
+    void Start();
+
+    /** The highest-quality rung whose scalability level does not exceed QualityLevel, or the lowest rung if none. */
+    static int32 FindStartStep(const TArray<FRiftlineGovernorStep>& Steps, int32 QualityLevel);
+
+    /** Feeds one reporting window; returns the reason if the governor changed rung. */
+    ERiftlineGovernorReason Evaluate(const FRiftlineDeviceState& Device, const FRiftlineFrameTimeSummary& Frames);
+
+    int32 GetCurrentStep() const { return CurrentStep; }
+
+private:
+    TArray<FRiftlineGovernorStep> Steps;
+    int32 DownWindows;
+    int32 UpWindows;
+    int32 CurrentStep = 0;
+    int32 PressureStreak = 0;
+    int32 HeadroomStreak = 0;
+
+    void ApplyStep(int32 Step);
+};
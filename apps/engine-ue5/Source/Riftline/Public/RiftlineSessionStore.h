@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RiftlineTypes.h"
+
+/** Slices of session state that change independently; subscribers register interest per slice. */
+enum class ERiftlineSessionField : uint16
+{
+    None = 0,
+    Identity = 1 << 0,
+    Wallet = 1 << 1,
+    Shard = 1 << 2,
+    Wanted = 1 << 3,
+    Compliance = 1 << 4,
+    WalletView = 1 << 5,
+    Missions = 1 << 6,
+    All = (1 << 7) - 1
+};
+ENUM_CLASS_FLAGS(ERiftlineSessionField);
+
+class FRiftlineSessionStore;
+
+/** Receives the store and the fields that changed since the subscriber was last told, limited to its mask. */
+DECLARE_DELEGATE_TwoParams(FRiftlineSessionChangeDelegate, const FRiftlineSessionStore&, ERiftlineSessionField);
+
+/**
+ * Session state with a version per field. Setters compare against the current value, so a repeated write neither
+ * bumps a version nor wakes anyone; real changes accumulate in a dirty mask and are dispatched once at the end of the
+ * frame, so a burst of shard population ticks or heat updates costs each subscriber one call with the union of
+ * fields. Without Start (tools, specs) changes are dispatched as they happen.
+ */
+class RIFTLINE_API FRiftlineSessionStore
+{
+public:
+    static constexpr int32 NumFields = 7;
+
+    FRiftlineSessionStore() = default;
+    ~FRiftlineSessionStore();
+
+    FRiftlineSessionStore(const FRiftlineSessionStore&) = delete;
+    FRiftlineSessionStore& operator=(const FRiftlineSessionStore&) = delete;
+
+    /** Coalesces dispatch to FCoreDelegates::OnEndFrame. */
+    void Start();
+    void Stop();
+
+    /** Replaces the whole profile; only the fields that differ are marked. */
+    void SetProfile(const FRiftlineSessionProfile& Profile);
+    void SetShard(const FRiftlineShardStatus& Shard);
+    void SetWanted(const FRiftlineWantedState& Wanted);
+    void SetCompliance(const FRiftlineComplianceState& Compliance);
+    void SetWalletView(const FRiftlineWalletView& WalletView);
+    void SetMissions(const TArray<FText>& Missions);
+
+    const FRiftlineSessionProfile& GetProfile() const { return Profile; }
+    const FRiftlineWalletView& GetWalletView() const { return WalletView; }
+    const TArray<FText>& GetMissions() const { return Missions; }
+
+    /** Bumped on every change to a single field; lets a consumer that polls skip work it has already done. */
+    uint32 GetVersion(ERiftlineSessionField Field) const;
+    ERiftlineSessionField GetPendingFields() const { return Pending; }
+
+    FDelegateHandle Subscribe(ERiftlineSessionField Fields, FRiftlineSessionChangeDelegate Delegate);
+    void Unsubscribe(FDelegateHandle Handle);
+    int32 GetNumSubscribers() const { return Subscribers.Num() + AddedDuringDispatch.Num(); }
+
+    /** Dispatches pending changes now instead of at the end of the frame. */
+    void Flush();
+
+private:
+    struct FSubscriber
+    {
+        FDelegateHandle Handle;
+        ERiftlineSessionField Fields = ERiftlineSessionField::None;
+        FRiftlineSessionChangeDelegate Delegate;
+    };
+
+    FRiftlineSessionProfile Profile;
+    FRiftlineWalletView WalletView;
+    TArray<FText> Missions;
+
+    uint32 Versions[NumFields] = {};
+    ERiftlineSessionField Pending = ERiftlineSessionField::None;
+
+    TArray<FSubscriber> Subscribers;
+
+    /** Subscriptions made by a callback; appending them to Subscribers mid-dispatch could move the delegate running. */
+    TArray<FSubscriber> AddedDuringDispatch;
+    FDelegateHandle EndFrameHandle;
+    bool bDispatching = false;
+
+    void MarkChanged(ERiftlineSessionField Fields);
+    void HandleEndFrame();
+};
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ReflectedTypeAccessors.h"
+
+enum class ERiftlineTelemetryValueType : uint8
+{
+    Int,
+    Float,
+    Bool,
+    Name,
+    Enum,
+    String
+};
+
+struct RIFTLINE_API FRiftlineTelemetryField
+{
+    FName Key;
+    ERiftlineTelemetryValueType Type = ERiftlineTelemetryValueType::Int;
+
+    union
+    {
+        int64 IntValue;
+        double FloatValue;
+        bool bBoolValue;
+    };
+
+    FName NameValue;
+    const UEnum* EnumType = nullptr;
+
+    /** Only populated for String fields, which are reserved for free-form values such as wallet addresses. */
+    FString StringValue;
+
+    FRiftlineTelemetryField()
+        : IntValue(0)
+    {
+    }
+};
+
+/**
+ * Typed telemetry event with inline field storage. Keys and name values are interned FNames so building an
+ * event on the game thread does not touch the heap; serialisation happens once when the event is batched.
+ */
+class RIFTLINE_API FRiftlineTelemetryEvent
+{
+public:
+    /** Enough for the widest built-in event (client.hitch, client.http); Register ensures no schema outgrows it. */
+    static constexpr int32 InlineFieldCount = 10;
+
+    FRiftlineTelemetryEvent() = default;
+
+    explicit FRiftlineTelemetryEvent(FName InName)
+        : Name(InName)
+    {
+    }
+
+    FName GetName() const { return Name; }
+    const TArray<FRiftlineTelemetryField, TInlineAllocator<InlineFieldCount>>& GetFields() const { return Fields; }
+
+    FRiftlineTelemetryEvent& Add(FName Key, int32 Value) { return AddInt(Key, Value); }
+    FRiftlineTelemetryEvent& Add(FName Key, int64 Value) { return AddInt(Key, Value); }
+    FRiftlineTelemetryEvent& Add(FName Key, float Value) { return AddFloat(Key, Value); }
+    FRiftlineTelemetryEvent& Add(FName Key, double Value) { return AddFloat(Key, Value); }
+    FRiftlineTelemetryEvent& Add(FName Key, bool bValue);
+    FRiftlineTelemetryEvent& Add(FName Key, FName Value);
+    FRiftlineTelemetryEvent& AddString(FName Key, const FString& Value);
+    FRiftlineTelemetryEvent& AddEnum(FName Key, const UEnum* EnumType, int64 Value);
+
+    template <typename TEnum>
+    FRiftlineTelemetryEvent& Add(FName Key, TEnum Value, typename TEnableIf<TIsEnum<TEnum>::Value>::Type* = nullptr)
+    {
+        return AddEnum(Key, StaticEnum<TEnum>(), static_cast<int64>(Value));
+    }
+
+    /** Appends this event as a JSON object to Out without clearing it. */
+    void AppendJson(FString& Out, int64 TimestampMs, int32 ShardId) const;
+
+private:
+    FName Name;
+    TArray<FRiftlineTelemetryField, TInlineAllocator<InlineFieldCount>> Fields;
+
+    FRiftlineTelemetryEvent& AddInt(FName Key, int64 Value);
+    FRiftlineTelemetryEvent& AddFloat(FName Key, double Value);
+    FRiftlineTelemetryField& AddField(FName Key, ERiftlineTelemetryValueType Type);
+};
+
+struct FRiftlineTelemetrySchema
+{
+    FName Event;
+    TArray<TPair<FName, ERiftlineTelemetryValueType>> Fields;
+
+    /** Enum type of each Enum field, so values that arrive as entry names (from Blueprint) can be typed. */
+    TMap<FName, const UEnum*> EnumTypes;
+};
+
+/** Registry of known event shapes. Events are validated against it in non-shipping builds. */
+class RIFTLINE_API FRiftlineTelemetrySchemaRegistry
+{
+public:
+    static FRiftlineTelemetrySchemaRegistry& Get();
+
+    void Register(FRiftlineTelemetrySchema&& Schema);
+    const FRiftlineTelemetrySchema* Find(FName Event) const;
+    bool Validate(const FRiftlineTelemetryEvent& Event) const;
+
+    /** Appends the short entry name; names are resolved once per enum type and reused afterwards. */
+    void AppendEnumEntryName(FString& Out, const UEnum* EnumType, int64 Value);
+
+    void RegisterBuiltInSchemas();
+
+private:
+    TMap<FName, FRiftlineTelemetrySchema> Schemas;
+    TMap<const UEnum*, TMap<int64, FString>> EnumNames;
+    FCriticalSection EnumNamesLock;
+    bool bBuiltInsRegistered = false;
+};
+
+namespace RiftlineTelemetry
+{
+    /** Appends Value with JSON string escaping applied, without the surrounding quotes. */
+    RIFTLINE_API void AppendJsonEscaped(FString& Out, FStringView Value);
+
+    /** Adds Text to Event as the type Schema declares for Key; false if Key is not in the schema or Text does not parse. */
+    RIFTLINE_API bool AddParsed(FRiftlineTelemetryEvent& Event, const FRiftlineTelemetrySchema& Schema, FName Key, const FString& Text);
+
+    namespace Events
+    {
+        extern RIFTLINE_API const FName RadialSelect;
+        extern RIFTLINE_API const FName PhoneOpen;
+        extern RIFTLINE_API const FName PhoneClose;
+        extern RIFTLINE_API const FName PhoneTab;
+        extern RIFTLINE_API const FName MarketView;
+        extern RIFTLINE_API const FName MarketList;
+        extern RIFTLINE_API const FName WalletLogin;
+        extern RIFTLINE_API const FName WantedState;
+        extern RIFTLINE_API const FName ClientFrameTime;
+        extern RIFTLINE_API const FName ClientThreadTime;
+        extern RIFTLINE_API const FName ClientHitch;
+        extern RIFTLINE_API const FName ClientGovernor;
+        extern RIFTLINE_API const FName ClientThermal;
+        extern RIFTLINE_API const FName ClientHttp;
+        extern RIFTLINE_API const FName ClientNet;
+        extern RIFTLINE_API const FName Rollup;
+    }
+
+    namespace Keys
+    {
+        extern RIFTLINE_API const FName Option;
+        extern RIFTLINE_API const FName Source;
+        extern RIFTLINE_API const FName Tab;
+        extern RIFTLINE_API const FName Items;
+        extern RIFTLINE_API const FName Count;
+        extern RIFTLINE_API const FName Address;
+        extern RIFTLINE_API const FName Level;
+        extern RIFTLINE_API const FName Expires;
+        extern RIFTLINE_API const FName Heat;
+        extern RIFTLINE_API const FName Avg;
+        extern RIFTLINE_API const FName P50;
+        extern RIFTLINE_API const FName P90;
+        extern RIFTLINE_API const FName P99;
+        extern RIFTLINE_API const FName Frames;
+        extern RIFTLINE_API const FName Hitches;
+        extern RIFTLINE_API const FName Thread;
+        extern RIFTLINE_API const FName Frame;
+        extern RIFTLINE_API const FName Game;
+        extern RIFTLINE_API const FName Render;
+        extern RIFTLINE_API const FName Rhi;
+        extern RIFTLINE_API const FName Gpu;
+        extern RIFTLINE_API const FName Phone;
+        extern RIFTLINE_API const FName Shard;
+        extern RIFTLINE_API const FName Wanted;
+        extern RIFTLINE_API const FName Interaction;
+        extern RIFTLINE_API const FName Battery;
+        extern RIFTLINE_API const FName OnBattery;
+        extern RIFTLINE_API const FName Step;
+        extern RIFTLINE_API const FName Reason;
+        extern RIFTLINE_API const FName State;
+        extern RIFTLINE_API const FName Platform;
+        extern RIFTLINE_API const FName Event;
+        extern RIFTLINE_API const FName Value;
+        extern RIFTLINE_API const FName Suppressed;
+        extern RIFTLINE_API const FName Sum;
+        extern RIFTLINE_API const FName Min;
+        extern RIFTLINE_API const FName Max;
+        extern RIFTLINE_API const FName Priority;
+        extern RIFTLINE_API const FName Retries;
+        extern RIFTLINE_API const FName Failures;
+        extern RIFTLINE_API const FName Coalesced;
+        extern RIFTLINE_API const FName Host;
+        extern RIFTLINE_API const FName P95;
+        extern RIFTLINE_API const FName Offset;
+        extern RIFTLINE_API const FName OffsetError;
+    }
+
+    /** Name values shared by the emitters and the dashboards that filter on them. */
+    namespace Values
+    {
+        extern RIFTLINE_API const FName None;
+        extern RIFTLINE_API const FName Thermal;
+        extern RIFTLINE_API const FName FrameTime;
+        extern RIFTLINE_API const FName Headroom;
+        extern RIFTLINE_API const FName Idle;
+        extern RIFTLINE_API const FName Targeting;
+    }
+}
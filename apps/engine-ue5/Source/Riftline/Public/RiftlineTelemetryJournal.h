@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IFileHandle;
+class FRiftlineTelemetryEvent;
+struct FRiftlineTelemetryRecord;
+
+/**
+ * Append-only telemetry spool made of numbered chunk files. Each chunk starts with a header naming the player its
+ * records belong to, followed by length-prefixed serialised events, so a chunk torn by an app kill is read back up
+ * to its last complete record. Not thread-safe: owned by the telemetry worker.
+ */
+class RIFTLINE_API FRiftlineTelemetryJournal
+{
+public:
+    FRiftlineTelemetryJournal(const FString& InDirectory, int64 InMaxBytes, int64 InChunkBytes, int32 InMaxRecordsPerChunk);
+    ~FRiftlineTelemetryJournal();
+
+    void Open();
+    void Close();
+
+    /** Player written into the header of chunks opened from now on; a change seals the active chunk first. */
+    void SetPlayerId(const FString& InPlayerId);
+
+    bool Append(const FRiftlineTelemetryRecord& Record);
+    void Commit();
+    void Seal();
+
+    bool HasSealedChunks() const { return SealedChunks.Num() > 0; }
+    int32 GetActiveRecordCount() const { return ActiveRecords; }
+
+    /**
+     * Reads the oldest sealed chunk, its sequence and, if asked, the player it was recorded for (empty for chunks
+     * written before sign-in or by older builds). The chunk stays on disk until Pop is called with it.
+     */
+    bool ReadOldest(TArray<FRiftlineTelemetryRecord>& OutRecords, uint64& OutSequence, FString* OutPlayerId = nullptr) const;
+
+    /** Deletes the chunk with this sequence if it is still journalled. */
+    void Pop(uint64 Sequence);
+
+    /** Protects the chunk being uploaded from budget eviction; 0 clears. */
+    void SetInFlight(uint64 Sequence) { InFlightSequence = Sequence; }
+
+    int64 GetTotalBytes() const;
+    int64 GetEvictedRecordCount() const { return EvictedRecords; }
+
+    static void SerializeRecord(FArchive& Ar, FRiftlineTelemetryRecord& Record);
+
+private:
+    struct FChunk
+    {
+        uint64 Sequence = 0;
+        int64 Bytes = 0;
+        int32 Records = 0;
+        FString PlayerId;
+    };
+
+    FString Directory;
+    int64 MaxBytes;
+    int64 ChunkBytes;
+    int32 MaxRecordsPerChunk;
+
+    FString PlayerId;
+    TArray<FChunk> SealedChunks;
+    TUniquePtr<IFileHandle> ActiveHandle;
+    uint64 ActiveSequence = 0;
+    int64 ActiveBytes = 0;
+    int32 ActiveRecords = 0;
+    uint64 NextSequence = 1;
+    uint64 InFlightSequence = 0;
+    int64 EvictedRecords = 0;
+
+    TArray<uint8> Scratch;
+
+    FString ChunkPath(uint64 Sequence) const;
+    bool OpenActiveChunk();
+    int32 ScanChunk(uint64 Sequence, FString& OutPlayerId) const;
+    void EnforceBudget();
+};
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "RiftlineHttpScheduler.h"
+#include "RiftlineTelemetry.h"
+#include "RiftlineTelemetryWire.h"
+#include <atomic>
+
+class FEvent;
+class FRunnableThread;
+class FRiftlineTelemetryJournal;
+
+/**
+ * Bounded lock-free queue (Vyukov ring). Any number of producers may call TryEnqueueWith concurrently; only one
+ * consumer may call TryDequeue. Slots are preallocated so neither side allocates after construction.
+ */
+template <typename T>
+class TRiftlineMpscRing
+{
+public:
+    explicit TRiftlineMpscRing(uint32 InCapacity)
+    {
+        const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2));
+        Mask = Capacity - 1;
+        Cells = MakeUnique<FCell[]>(Capacity);
+        for (uint32 Index = 0; Index < Capacity; ++Index)
+        {
+            Cells[Index].Sequence.store(Index, std::memory_order_relaxed);
+        }
+    }
+
+    uint32 Capacity() const { return Mask + 1; }
+
+    /** Claims a slot and lets Fill write the value in place; returns false when the ring is full. */
+    template <typename FillFunc>
+    bool TryEnqueueWith(FillFunc&& Fill)
+    {
+        uint64 Position = EnqueuePosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            FCell& Cell = Cells[Position & Mask];
+            const uint64 Sequence = Cell.Sequence.load(std::memory_order_acquire);
+            const int64 Difference = static_cast<int64>(Sequence) - static_cast<int64>(Position);
+            if (Difference == 0)
+            {
+                if (EnqueuePosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+                {
+                    Fill(Cell.Value);
+                    Cell.Sequence.store(Position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (Difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                Position = EnqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool TryDequeue(T& OutValue)
+    {
+        FCell& Cell = Cells[DequeuePosition & Mask];
+        const uint64 Sequence = Cell.Sequence.load(std::memory_order_acquire);
+        if (static_cast<int64>(Sequence) - static_cast<int64>(DequeuePosition + 1) < 0)
+        {
+            return false;
+        }
+
+        OutValue = MoveTemp(Cell.Value);
+        Cell.Sequence.store(DequeuePosition + Mask + 1, std::memory_order_release);
+        ++DequeuePosition;
+        return true;
+    }
+
+private:
+    struct FCell
+    {
+        std::atomic<uint64> Sequence{0};
+        T Value;
+    };
+
+    TUniquePtr<FCell[]> Cells;
+    uint64 Mask = 0;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePosition{0};
+    alignas(PLATFORM_CACHE_LINE_SIZE) uint64 DequeuePosition = 0;
+};
+
+struct FRiftlineTelemetryRecord
+{
+    FRiftlineTelemetryEvent Event;
+    int64 TimestampMs = 0;
+    int32 ShardId = INDEX_NONE;
+
+    /** SetPlayerId generation the record was enqueued under; the worker files it in that player's journal chunks. */
+    uint32 PlayerEpoch = 0;
+};
+
+struct FRiftlineTelemetryPipelineSettings
+{
+    FString Url;
+    int32 BatchSize = 20;
+    float FlushInterval = 10.f;
+    int32 QueueCapacity = 1024;
+
+    FString JournalDirectory;
+    int64 MaxJournalBytes = 8 * 1024 * 1024;
+    int64 JournalChunkBytes = 256 * 1024;
+    int32 MaxRecordsPerUpload = 500;
+
+    ERiftlineTelemetryWireFormat WireFormat = ERiftlineTelemetryWireFormat::Json;
+
+    /** Uploads go out at telemetry priority; without a scheduler records stay in the journal. */
+    TSharedPtr<FRiftlineHttpScheduler, ESPMode::ThreadSafe> Scheduler;
+
+    /** Heartbeats are sent from the worker so sealed chunks can ride along instead of paying for their own request. */
+    FString HeartbeatUrl;
+
+    /** How long a partial batch may wait for the next heartbeat while heartbeats are flowing. */
+    float MaxPiggybackWait = 45.f;
+
+    /** Budget StopAndFlush spends uploading sealed chunks before leaving the rest to the next session; 0 skips it. */
+    float ShutdownFlushTimeout = 2.f;
+};
+
+/**
+ * Owns telemetry encoding, batching and HTTP submission on a background thread. Producers on any thread only
+ * copy a compact record into the ring; when it is full the record is dropped and counted. Records are spooled
+ * to an on-disk journal first and uploaded chunk by chunk, so nothing is lost while the gateway is unreachable.
+ */
+class RIFTLINE_API FRiftlineTelemetryPipeline : public FRunnable
+{
+public:
+    explicit FRiftlineTelemetryPipeline(const FRiftlineTelemetryPipelineSettings& InSettings);
+    virtual ~FRiftlineTelemetryPipeline() override;
+
+    void Start();
+
+    /** Stops the worker, then, on the game thread, uploads what it can within ShutdownFlushTimeout. */
+    void StopAndFlush();
+
+    bool Enqueue(const FRiftlineTelemetryEvent& Event, int64 TimestampMs, int32 ShardId);
+    void RequestFlush();
+    void SetPlayerId(const FString& PlayerId);
+
+    /** Bearer token sent with every upload and heartbeat; the heartbeat route rejects requests without one. */
+    void SetAuthToken(const FString& Token);
+
+    /**
+     * Queues a heartbeat for the worker, replacing one not yet sent. OnComplete runs on the game thread, with a
+     * not-connected result if the heartbeat is dropped before it is sent. Returns false, without calling OnComplete,
+     * when the pipeline is not running or has no heartbeat URL or player.
+     */
+    bool RequestHeartbeat(int32 ShardId, FRiftlineHttpCompleteDelegate&& OnComplete);
+
+    uint64 GetDroppedCount() const { return DroppedCount.load(std::memory_order_relaxed); }
+
+    /** Counts an event rejected before it reached the ring, so the gateway's drop figure includes it. */
+    void CountDropped() { DroppedCount.fetch_add(1, std::memory_order_relaxed); }
+    uint64 GetQueueDepth() const;
+
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    FRiftlineTelemetryPipelineSettings Settings;
+    TRiftlineMpscRing<FRiftlineTelemetryRecord> Queue;
+
+    FRunnableThread* Thread = nullptr;
+    FEvent* WakeEvent = nullptr;
+
+    std::atomic<bool> bStopRequested{false};
+    std::atomic<bool> bFlushRequested{false};
+    std::atomic<uint64> EnqueuedCount{0};
+    std::atomic<uint64> DequeuedCount{0};
+    std::atomic<uint64> DroppedCount{0};
+
+    FCriticalSection IdentityLock;
+    FString PlayerId;
+    FString AuthToken;
+    std::atomic<uint32> PlayerEpoch{0};
+    TMap<uint32, FString> PlayerIdsByEpoch;
+
+    struct FHeartbeatRequest
+    {
+        int32 ShardId = INDEX_NONE;
+        FRiftlineHttpCompleteDelegate OnComplete;
+    };
+
+    FCriticalSection HeartbeatLock;
+    TOptional<FHeartbeatRequest> PendingHeartbeat;
+    std::atomic<bool> bHeartbeatRequested{false};
+
+    struct FUploadState
+    {
+        std::atomic<int32> Result{0};
+        bool bHeartbeat = false;
+    };
+
+    // Worker-owned state.
+    TUniquePtr<FRiftlineTelemetryJournal> Journal;
+    TSharedPtr<FUploadState, ESPMode::ThreadSafe> InFlightUpload;
+    TArray<FRiftlineTelemetryRecord> UploadRecords;
+    /** Journal chunk UploadRecords came from; acknowledged by sequence since eviction may reorder the front. */
+    uint64 UploadSequence = 0;
+    FString RequestBuffer;
+    TArray<uint8> EncodedBuffer;
+    ERiftlineTelemetryWireFormat ActiveWireFormat = ERiftlineTelemetryWireFormat::Json;
+    double ChunkStartedAt = 0.0;
+    double RetryAt = 0.0;
+    double RetryDelay = 0.0;
+    uint64 ReportedDropped = 0;
+    uint64 UploadDroppedMark = 0;
+    double LastHeartbeatAt = 0.0;
+    bool bPiggybackRefused = false;
+    uint32 JournalPlayerEpoch = 0;
+
+    void DrainQueue();
+    void PumpUploads();
+    void SubmitOldestChunk();
+    void FlushOnShutdown();
+    void SubmitHeartbeat(FHeartbeatRequest&& Heartbeat, bool bAttachChunk);
+    void EncodeUpload(FRiftlineHttpRequest& Request, const FString& UploadPlayerId, bool bAuthenticate, const TArray<FRiftlineTelemetryRecord>& Records, const int32* HeartbeatShardId);
+    bool TakeHeartbeat(FHeartbeatRequest& Out);
+    FString GetPlayerId();
+    FString ResolvePlayerId(uint32 Epoch);
+    FString GetAuthToken();
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RiftlineTelemetryPolicy.generated.h"
+
+class FRiftlineTelemetryEvent;
+
+/** Per-event-kind volume controls applied on the game thread before an event reaches the telemetry queue. */
+USTRUCT(BlueprintType)
+struct FRiftlineTelemetryPolicy
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FName Event;
+
+    /** Fraction of events sent individually; the rest are only counted in the rollup. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0", ClampMax = "1"))
+    float SampleRate = 1.f;
+
+    /** Sustained events per second allowed through; 0 disables the limit. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+    float RateLimitPerSecond = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1"))
+    int32 RateLimitBurst = 5;
+
+    /** Never send this kind individually; report it only through the periodic rollup. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bAggregateOnly = false;
+
+    /** Field whose value splits the rollup into one counter per value (e.g. "tab"). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FName GroupByKey;
+
+    /** Numeric field summarised as sum/min/max in the rollup. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FName ValueKey;
+};
+
+/**
+ * Applies FRiftlineTelemetryPolicy rules and accumulates counters for events that were aggregated, sampled out or
+ * rate limited. Rollups are emitted as telemetry.rollup events so dashboards can re-weight what was suppressed.
+ * Game thread only.
+ */
+class RIFTLINE_API FRiftlineTelemetryPolicyEngine
+{
+public:
+    void SetPolicy(const FRiftlineTelemetryPolicy& Policy);
+    void ClearPolicy(FName Event);
+    void ResetPolicies(const TArray<FRiftlineTelemetryPolicy>& Policies);
+
+    /** Returns true if the event should be sent individually; it is counted towards the rollup either way. */
+    bool Admit(const FRiftlineTelemetryEvent& Event, double NowSeconds);
+
+    /** Moves accumulated counters into rollup events and resets them. */
+    void CollectRollups(TArray<FRiftlineTelemetryEvent>& OutEvents);
+
+private:
+    struct FBucket
+    {
+        int64 Count = 0;
+        int64 Suppressed = 0;
+        int64 Samples = 0;
+        double Sum = 0.0;
+        double Min = 0.0;
+        double Max = 0.0;
+    };
+
+    struct FKindState
+    {
+        FRiftlineTelemetryPolicy Policy;
+        double Tokens = 0.0;
+        double LastRefillSeconds = -1.0;
+        bool bActive = true;
+        TMap<FName, FBucket> Buckets;
+    };
+
+    TMap<FName, FKindState> Kinds;
+    FString Scratch;
+
+    static bool ConsumeToken(FKindState& State, double NowSeconds);
+    FName ResolveGroup(const FRiftlineTelemetryEvent& Event, FName Key);
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RiftlineTelemetryWire.generated.h"
+
+struct FRiftlineTelemetryRecord;
+
+UENUM(BlueprintType)
+enum class ERiftlineTelemetryWireFormat : uint8
+{
+    Json   UMETA(DisplayName = "JSON"),
+    Binary UMETA(DisplayName = "Binary")
+};
+
+/**
+ * Batch encoders for /telemetry/events and /players/heartbeat. The binary form is varint packed and sends the
+ * player id once per batch; event names, keys and name values go through a per-batch string dictionary.
+ */
+namespace RiftlineTelemetryWire
+{
+    extern RIFTLINE_API const TCHAR* JsonContentType;
+    extern RIFTLINE_API const TCHAR* BinaryContentType;
+    extern RIFTLINE_API const TCHAR* HeartbeatBinaryContentType;
+
+    RIFTLINE_API void EncodeJsonBatch(FString& Out, const FString& PlayerId, uint64 Dropped, const TArray<FRiftlineTelemetryRecord>& Records);
+    RIFTLINE_API void EncodeBinaryBatch(TArray<uint8>& Out, const FString& PlayerId, uint64 Dropped, const TArray<FRiftlineTelemetryRecord>& Records);
+
+    /** Heartbeat bodies; Records, when non-empty, ride along as a batch in the same request. */
+    RIFTLINE_API void EncodeJsonHeartbeat(FString& Out, int32 ShardId, const FString& PlayerId, uint64 Dropped, const TArray<FRiftlineTelemetryRecord>& Records);
+    RIFTLINE_API void EncodeBinaryHeartbeat(TArray<uint8>& Out, int32 ShardId, const FString& PlayerId, uint64 Dropped, const TArray<FRiftlineTelemetryRecord>& Records);
+
+    /** Gzip-compresses Source into Out; returns false (leaving Out empty) if compression is unavailable. */
+    RIFTLINE_API bool Compress(TArray<uint8>& Out, const uint8* Source, int32 SourceSize);
+}
@@ -36,6 +36,13 @@ struct FRiftlineWantedState
 
     UPROPERTY(BlueprintReadOnly)
     float Heat = 0.f;
+
+    bool operator==(const FRiftlineWantedState& Other) const
+    {
+        return Level == Other.Level
+            && ExpiresAt == Other.ExpiresAt
+            && Heat == Other.Heat;
+    }
 };
 
 USTRUCT(BlueprintType)
@@ -80,6 +87,14 @@ struct FRiftlineComplianceState
 
     UPROPERTY(BlueprintReadOnly)
     FString LastCaseId;
+
+    bool operator==(const FRiftlineComplianceState& Other) const
+    {
+        return bKycVerified == Other.bKycVerified
+            && bAmlClear == Other.bAmlClear
+            && RiskScore == Other.RiskScore
+            && LastCaseId.Equals(Other.LastCaseId, ESearchCase::CaseSensitive);
+    }
 };
 
 USTRUCT(BlueprintType)
@@ -98,6 +113,14 @@ struct FRiftlineWalletView
 
     UPROPERTY(BlueprintReadOnly)
     int32 ShardId = INDEX_NONE;
+
+    bool operator==(const FRiftlineWalletView& Other) const
+    {
+        return Address.Equals(Other.Address, ESearchCase::CaseSensitive)
+            && SoftCurrency == Other.SoftCurrency
+            && WantedMinutes == Other.WantedMinutes
+            && ShardId == Other.ShardId;
+    }
 };
 
 USTRUCT(BlueprintType)
@@ -141,11 +164,16 @@ struct FRiftlineAuctionRow
     UPROPERTY(BlueprintReadOnly)
     FString PayToken;
 
+    /** Legacy relative countdown; only used to derive EndsAt when a feed does not send it. */
     UPROPERTY(BlueprintReadOnly)
     int32 SecondsRemaining = 0;
 
     UPROPERTY(BlueprintReadOnly)
     FString Price;
+
+    /** UTC end of the auction; countdowns are computed from it locally. */
+    UPROPERTY(BlueprintReadOnly)
+    FDateTime EndsAt = FDateTime(0);
 };
 
 using FAuctionRow = FRiftlineAuctionRow;
@@ -153,3 +181,4 @@ using FAuctionRow = FRiftlineAuctionRow;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRiftlineWantedDelegate, const FRiftlineWantedState&, State);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRiftlineComplianceDelegate, const FRiftlineComplianceState&, State);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRiftlineSessionDelegate, const FRiftlineSessionProfile&, Profile);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRiftlineShardDelegate, const FRiftlineShardStatus&, Status);
@@ -24,7 +24,10 @@ public class Riftline : ModuleRules
         {
             "HTTP",
             "Json",
-            "JsonUtilities"
+            "JsonUtilities",
+            "RenderCore",
+            "RHI",
+            "WebSockets"
         });
     }
 }
@@ -0,0 +1,682 @@
+#include "RiftlineBenchmark.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+#include "RiftlineBenchmarkFixtures.h"
+#include "RiftlineGameInstance.h"
+#include "RiftlineInteractionComponent.h"
+#include "RiftlinePerformanceMonitor.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include <atomic>
+
+namespace
+{
+    constexpr int32 RouteTargets = 16;
+    constexpr float RouteRadius = 500.f;
+    constexpr float TargetRadius = 700.f;
+    constexpr int32 RouteStepsPerLap = 360;
+    constexpr int32 CrowdAgents = 256;
+    /** An event-sized marketplace. */
+    constexpr int32 AuctionRows = 2000;
+    constexpr int32 FramesPerHeartbeat = 60;
+    constexpr float FrameDeltaSeconds = 1.f / 60.f;
+
+    /** Forwards to the real allocator and counts calls, so a scenario's allocations can be read as a delta. */
+    class FRiftlineCountingMalloc final : public FMalloc
+    {
+    public:
+        explicit FRiftlineCountingMalloc(FMalloc* InInner)
+            : Inner(InInner)
+        {
+        }
+
+        FMalloc* GetInner() const { return Inner; }
+        uint64 GetAllocations() const { return Allocations.load(std::memory_order_relaxed); }
+        uint64 GetBytes() const { return Bytes.load(std::memory_order_relaxed); }
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            Record(Count);
+            return Inner->Malloc(Count, Alignment);
+        }
+
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            Record(Count);
+            return Inner->TryMalloc(Count, Alignment);
+        }
+
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            Record(Count);
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            Record(Count);
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual void UpdateStats() override { Inner->UpdateStats(); }
+        virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+        virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+        virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+    private:
+        FMalloc* Inner;
+        std::atomic<uint64> Allocations{0};
+        std::atomic<uint64> Bytes{0};
+
+        void Record(SIZE_T Size)
+        {
+            if (Size > 0)
+            {
+                Allocations.fetch_add(1, std::memory_order_relaxed);
+                Bytes.fetch_add(Size, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    /** Swaps the counting proxy in for the duration of a run. */
+    class FScopedAllocationCounter
+    {
+    public:
+        FScopedAllocationCounter()
+        {
+            // Never freed: another thread may still be inside the proxy after it is swapped back out.
+            static FRiftlineCountingMalloc* Proxy = new FRiftlineCountingMalloc(GMalloc);
+            Counter = Proxy;
+            GMalloc = Counter;
+        }
+
+        ~FScopedAllocationCounter()
+        {
+            if (GMalloc == Counter)
+            {
+                GMalloc = Counter->GetInner();
+            }
+        }
+
+        const FRiftlineCountingMalloc& Get() const { return *Counter; }
+
+    private:
+        FRiftlineCountingMalloc* Counter;
+    };
+}
+
+/** Owns the transient world and the objects each scenario drives. Friend of URiftlineGameInstance. */
+class FRiftlineBenchmarkSession
+{
+public:
+    bool Setup();
+    void Teardown();
+
+    void StepInteractionRoute(int32 Iteration);
+    void StepPhoneToggle(int32 Iteration);
+    void StepPhoneTabs(int32 Iteration);
+    void StepWantedStorm(int32 Iteration);
+    void StepComplianceStorm(int32 Iteration);
+    void StepShardTicks(int32 Iteration);
+    void StepAuctionStorm(int32 Iteration);
+    void StepAuctionSnapshot(int32 Iteration);
+    void StepFrame(int32 Iteration);
+    void StartCrowdTracking(int32 Iteration);
+    void StepCrowd(int32 Iteration);
+    void FillHeartbeatWindow(int32 Iteration);
+    void StepHeartbeat(int32 Iteration);
+
+    /** Puts back what a scenario may have left changed, so the next one measures only its own work. */
+    void EndScenario();
+
+private:
+    URiftlineGameInstance* GameInstance = nullptr;
+    UWorld* World = nullptr;
+    APawn* Pawn = nullptr;
+    URiftlineInteractionComponent* Interaction = nullptr;
+    TArray<URiftlineInteractionComponent*> Crowd;
+    URiftlineBenchmarkPhoneWidget* Phone = nullptr;
+    URiftlineBenchmarkHUDWidget* HUD = nullptr;
+    TArray<FRiftlineAuctionRow> Auctions;
+    TArray<FRiftlineAuctionRow> BidBatch;
+    FString JournalDirectory;
+    bool bRadialShown = false;
+    bool bCrowdTracking = false;
+
+    APawn* SpawnInteractor(const FTransform& Transform, const FActorSpawnParameters& SpawnParams, URiftlineInteractionComponent*& OutInteraction);
+};
+
+namespace
+{
+    using FScenarioStep = void (FRiftlineBenchmarkSession::*)(int32);
+
+    struct FScenario
+    {
+        const TCHAR* Name;
+        /** Untimed setup run before every iteration, or null. */
+        FScenarioStep Prepare;
+        FScenarioStep Step;
+    };
+
+    const FScenario Scenarios[] =
+    {
+        { TEXT("interaction.route"), nullptr, &FRiftlineBenchmarkSession::StepInteractionRoute },
+        { TEXT("phone.toggle"), nullptr, &FRiftlineBenchmarkSession::StepPhoneToggle },
+        { TEXT("phone.tabs"), nullptr, &FRiftlineBenchmarkSession::StepPhoneTabs },
+        { TEXT("wanted.storm"), nullptr, &FRiftlineBenchmarkSession::StepWantedStorm },
+        { TEXT("compliance.storm"), nullptr, &FRiftlineBenchmarkSession::StepComplianceStorm },
+        { TEXT("shard.ticks"), nullptr, &FRiftlineBenchmarkSession::StepShardTicks },
+        { TEXT("auction.storm"), nullptr, &FRiftlineBenchmarkSession::StepAuctionStorm },
+        { TEXT("auction.snapshot"), nullptr, &FRiftlineBenchmarkSession::StepAuctionSnapshot },
+        { TEXT("frame"), nullptr, &FRiftlineBenchmarkSession::StepFrame },
+        { TEXT("interaction.crowd"), &FRiftlineBenchmarkSession::StartCrowdTracking, &FRiftlineBenchmarkSession::StepCrowd },
+        { TEXT("heartbeat"), &FRiftlineBenchmarkSession::FillHeartbeatWindow, &FRiftlineBenchmarkSession::StepHeartbeat },
+    };
+
+    FRiftlineBenchmarkResult RunScenario(
+        FRiftlineBenchmarkSession& Session,
+        const FScenario& Scenario,
+        const FRiftlineBenchmarkSettings& Settings,
+        const FRiftlineCountingMalloc& Counter)
+    {
+        for (int32 Iteration = 0; Iteration < Settings.WarmupIterations; ++Iteration)
+        {
+            if (Scenario.Prepare)
+            {
+                (Session.*Scenario.Prepare)(Iteration);
+            }
+            (Session.*Scenario.Step)(Iteration);
+        }
+
+        // Recorded in nanoseconds; the histogram's range tops out near 67 ms, well past any single step.
+        FRiftlineHistogram Histogram;
+        uint64 TotalCycles = 0;
+        uint64 Allocations = 0;
+        uint64 Bytes = 0;
+
+        const int32 Iterations = FMath::Max(Settings.Iterations, 1);
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            if (Scenario.Prepare)
+            {
+                (Session.*Scenario.Prepare)(Settings.WarmupIterations + Iteration);
+            }
+
+            const uint64 AllocationsBefore = Counter.GetAllocations();
+            const uint64 BytesBefore = Counter.GetBytes();
+            const uint64 Start = FPlatformTime::Cycles64();
+
+            (Session.*Scenario.Step)(Settings.WarmupIterations + Iteration);
+
+            const uint64 Cycles = FPlatformTime::Cycles64() - Start;
+            Allocations += Counter.GetAllocations() - AllocationsBefore;
+            Bytes += Counter.GetBytes() - BytesBefore;
+
+            TotalCycles += Cycles;
+            Histogram.Add(static_cast<uint32>(FMath::Min(FPlatformTime::ToSeconds64(Cycles) * 1e9, static_cast<double>(MAX_uint32))));
+        }
+
+        FRiftlineBenchmarkResult Result;
+        Result.Name = Scenario.Name;
+        Result.Iterations = Iterations;
+        Result.MeanUs = FPlatformTime::ToSeconds64(TotalCycles) * 1e6 / Iterations;
+        Result.P50Us = Histogram.ValueAtQuantile(0.50) / 1000.0;
+        Result.P90Us = Histogram.ValueAtQuantile(0.90) / 1000.0;
+        Result.P99Us = Histogram.ValueAtQuantile(0.99) / 1000.0;
+        Result.MaxUs = Histogram.GetMax() / 1000.0;
+        Result.AllocsPerIteration = static_cast<double>(Allocations) / Iterations;
+        Result.BytesPerIteration = static_cast<double>(Bytes) / Iterations;
+        return Result;
+    }
+
+    TSharedRef<FJsonObject> ResultToJson(const FRiftlineBenchmarkResult& Result)
+    {
+        TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+        Object->SetStringField(TEXT("name"), Result.Name);
+        Object->SetNumberField(TEXT("iterations"), Result.Iterations);
+        Object->SetNumberField(TEXT("meanUs"), Result.MeanUs);
+        Object->SetNumberField(TEXT("p50Us"), Result.P50Us);
+        Object->SetNumberField(TEXT("p90Us"), Result.P90Us);
+        Object->SetNumberField(TEXT("p99Us"), Result.P99Us);
+        Object->SetNumberField(TEXT("maxUs"), Result.MaxUs);
+        Object->SetNumberField(TEXT("allocsPerIteration"), Result.AllocsPerIteration);
+        Object->SetNumberField(TEXT("bytesPerIteration"), Result.BytesPerIteration);
+        return Object;
+    }
+}
+
+bool FRiftlineBenchmarkSession::Setup()
+{
+    if (!GEngine)
+    {
+        UE_LOG(LogRiftlineBenchmark, Error, TEXT("Benchmark needs an engine instance"));
+        return false;
+    }
+
+    GameInstance = NewObject<URiftlineGameInstance>(GEngine);
+    GameInstance->AddToRoot();
+    GameInstance->InitializeStandalone(TEXT("RiftlineBenchmark"));
+    World = GameInstance->GetWorld();
+    if (!World)
+    {
+        UE_LOG(LogRiftlineBenchmark, Error, TEXT("Benchmark could not create a game world"));
+        return false;
+    }
+
+    // Keep benchmark telemetry and the realtime socket off the network and out of the player's journal; heartbeats are
+    // driven by the scenario.
+    JournalDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("Telemetry"));
+    GameInstance->StopHeartbeat();
+    GameInstance->StopTelemetry();
+    GameInstance->ApiBaseUrl.Reset();
+    GameInstance->NakamaUrl.Reset();
+    GameInstance->TelemetryJournalDirectory = JournalDirectory;
+    GameInstance->StartTelemetry();
+
+    FRiftlineSessionProfile Profile;
+    Profile.PlayerId = TEXT("benchmark");
+    Profile.DisplayName = TEXT("Benchmark");
+    Profile.CurrentShard.ShardId = 1;
+    Profile.CurrentShard.Name = TEXT("benchmark-1");
+    Profile.CurrentShard.Ruleset = TEXT("standard");
+    GameInstance->SetSessionProfile(Profile);
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    Pawn = SpawnInteractor(FTransform::Identity, SpawnParams, Interaction);
+
+    for (int32 Index = 0; Index < RouteTargets; ++Index)
+    {
+        const float Angle = 2.f * PI * Index / RouteTargets;
+        const FVector Location(FMath::Cos(Angle) * TargetRadius, FMath::Sin(Angle) * TargetRadius, 100.f);
+        World->SpawnActor<ARiftlineBenchmarkTarget>(ARiftlineBenchmarkTarget::StaticClass(), FTransform(Location), SpawnParams);
+    }
+
+    // Bots standing on the route ring facing outward, as a shard server would host them.
+    Crowd.Reset(CrowdAgents);
+    for (int32 Index = 0; Index < CrowdAgents; ++Index)
+    {
+        const float Angle = 2.f * PI * Index / CrowdAgents;
+        const FVector Location(FMath::Cos(Angle) * RouteRadius, FMath::Sin(Angle) * RouteRadius, 100.f);
+        URiftlineInteractionComponent* Agent = nullptr;
+        SpawnInteractor(FTransform(FRotator(0.f, FMath::RadiansToDegrees(Angle), 0.f), Location), SpawnParams, Agent);
+        Crowd.Add(Agent);
+    }
+
+    Phone = CreateWidget<URiftlineBenchmarkPhoneWidget>(GameInstance, URiftlineBenchmarkPhoneWidget::StaticClass());
+    Phone->AddToRoot();
+    GameInstance->RegisterPhoneWidget(Phone);
+
+    HUD = CreateWidget<URiftlineBenchmarkHUDWidget>(GameInstance, URiftlineBenchmarkHUDWidget::StaticClass());
+    HUD->AddToRoot();
+    HUD->Bind(GameInstance);
+    GameInstance->SessionStore.Flush();
+
+    const FDateTime Now = FDateTime::UtcNow();
+    Auctions.SetNum(AuctionRows);
+    for (int32 Index = 0; Index < AuctionRows; ++Index)
+    {
+        FRiftlineAuctionRow& Row = Auctions[Index];
+        Row.AuctionId = 1000 + Index;
+        Row.Title = FString::Printf(TEXT("Lot %d"), Index);
+        Row.AssetType = Index % 2 == 0 ? TEXT("vehicle") : TEXT("weapon");
+        Row.PayToken = TEXT("RFT");
+        Row.EndsAt = Now + FTimespan::FromSeconds(600 + Index * 7);
+        Row.Price = FString::Printf(TEXT("%d.00"), 100 + Index * 5);
+    }
+    Phone->OnAuctionsUpdated(Auctions);
+    return true;
+}
+
+APawn* FRiftlineBenchmarkSession::SpawnInteractor(
+    const FTransform& Transform,
+    const FActorSpawnParameters& SpawnParams,
+    URiftlineInteractionComponent*& OutInteraction)
+{
+    APawn* Spawned = World->SpawnActor<APawn>(APawn::StaticClass(), Transform, SpawnParams);
+    USceneComponent* Root = NewObject<USceneComponent>(Spawned, TEXT("Root"));
+    Root->SetMobility(EComponentMobility::Movable);
+    Spawned->SetRootComponent(Root);
+    Root->RegisterComponent();
+    Root->SetWorldTransform(Transform);
+
+    OutInteraction = NewObject<URiftlineInteractionComponent>(Spawned, TEXT("Interaction"));
+    OutInteraction->bAutoInvokeSingleOption = false;
+    OutInteraction->RegisterComponent();
+    return Spawned;
+}
+
+void FRiftlineBenchmarkSession::Teardown()
+{
+    if (HUD)
+    {
+        HUD->RemoveFromRoot();
+    }
+    if (Phone)
+    {
+        Phone->RemoveFromRoot();
+    }
+
+    if (GameInstance)
+    {
+        GameInstance->Shutdown();
+        if (World)
+        {
+            GEngine->DestroyWorldContext(World);
+            World->DestroyWorld(false);
+        }
+        GameInstance->RemoveFromRoot();
+    }
+
+    if (!JournalDirectory.IsEmpty())
+    {
+        IFileManager::Get().DeleteDirectory(*JournalDirectory, false, true);
+    }
+}
+
+void FRiftlineBenchmarkSession::StepInteractionRoute(int32 Iteration)
+{
+    // Walk a circle facing outward so the trace sweeps across a ring of targets, hitting roughly every other step.
+    const float Angle = 2.f * PI * (Iteration % RouteStepsPerLap) / RouteStepsPerLap;
+    const FVector Location(FMath::Cos(Angle) * RouteRadius, FMath::Sin(Angle) * RouteRadius, 100.f - Pawn->BaseEyeHeight);
+    Pawn->SetActorLocationAndRotation(Location, FRotator(0.f, FMath::RadiansToDegrees(Angle), 0.f));
+
+    FRiftlineInteractionHit Hit;
+    if (Interaction->FindInteraction(Hit))
+    {
+        HUD->SetRadialOptions(Hit.SharedOptions);
+        bRadialShown = true;
+    }
+    else if (bRadialShown)
+    {
+        HUD->ClearRadialEntries();
+        bRadialShown = false;
+    }
+}
+
+void FRiftlineBenchmarkSession::StepPhoneToggle(int32 Iteration)
+{
+    Phone->NotifyPhoneVisible(Iteration % 2 == 0);
+}
+
+void FRiftlineBenchmarkSession::StepPhoneTabs(int32 Iteration)
+{
+    Phone->SetActiveTab(static_cast<ERiftlinePhoneTab>(Iteration % 5));
+}
+
+void FRiftlineBenchmarkSession::StepWantedStorm(int32 Iteration)
+{
+    FRiftlineWantedState Wanted;
+    Wanted.Level = static_cast<ERiftlineWantedLevel>(Iteration % (static_cast<int32>(ERiftlineWantedLevel::Critical) + 1));
+    Wanted.Heat = (Iteration % 100) / 100.f;
+    Wanted.ExpiresAt = FDateTime::UtcNow() + FTimespan::FromMinutes(5);
+    GameInstance->ApplyWantedState(Wanted);
+    GameInstance->SessionStore.Flush();
+}
+
+void FRiftlineBenchmarkSession::StepComplianceStorm(int32 Iteration)
+{
+    FRiftlineComplianceState Compliance;
+    Compliance.bKycVerified = Iteration % 3 != 0;
+    Compliance.bAmlClear = Iteration % 7 != 0;
+    Compliance.RiskScore = Iteration % 100;
+    Compliance.LastCaseId = FString::Printf(TEXT("case-%d"), Iteration % 8);
+    GameInstance->UpdateCompliance(Compliance);
+    GameInstance->SessionStore.Flush();
+}
+
+void FRiftlineBenchmarkSession::StepShardTicks(int32 Iteration)
+{
+    // A frame's worth of population ticks and a heat update, dispatched together at the frame's end.
+    FRiftlineShardStatus Shard = GameInstance->GetSessionProfile().CurrentShard;
+    for (int32 Tick = 0; Tick < 4; ++Tick)
+    {
+        Shard.Population = (Iteration * 4 + Tick) % 500;
+        GameInstance->UpdateShardStatus(Shard);
+    }
+
+    FRiftlineWantedState Wanted = GameInstance->GetSessionProfile().Wanted;
+    Wanted.Heat = (Iteration % 100) / 100.f;
+    GameInstance->ApplyWantedState(Wanted);
+    GameInstance->SessionStore.Flush();
+}
+
+void FRiftlineBenchmarkSession::StepAuctionStorm(int32 Iteration)
+{
+    // One re-priced lot per message, as the live auction feed delivers bids.
+    FRiftlineAuctionRow& Bid = Auctions[Iteration % AuctionRows];
+    Bid.Price = FString::Printf(TEXT("%d.00"), 100 + Iteration % 500);
+    BidBatch.Reset();
+    BidBatch.Add(Bid);
+    Phone->ApplyAuctionUpserts(BidBatch);
+}
+
+void FRiftlineBenchmarkSession::StepAuctionSnapshot(int32 Iteration)
+{
+    // A full listing refresh with one changed lot; the model diffs it down to a single update.
+    FRiftlineAuctionRow& Bid = Auctions[(Iteration * 7) % AuctionRows];
+    Bid.Price = FString::Printf(TEXT("%d.00"), 100 + Iteration % 500);
+    Phone->OnAuctionsUpdated(Auctions);
+}
+
+void FRiftlineBenchmarkSession::StepFrame(int32 Iteration)
+{
+    World->Tick(LEVELTICK_All, FrameDeltaSeconds);
+    FCoreDelegates::OnEndFrame.Broadcast();
+}
+
+void FRiftlineBenchmarkSession::StartCrowdTracking(int32 Iteration)
+{
+    if (bCrowdTracking)
+    {
+        return;
+    }
+    for (URiftlineInteractionComponent* Agent : Crowd)
+    {
+        Agent->SetFocusTracking(true);
+    }
+    bCrowdTracking = true;
+}
+
+void FRiftlineBenchmarkSession::StepCrowd(int32 Iteration)
+{
+    // One world frame: last frame's focus traces land, then the interaction subsystem issues this frame's batch.
+    World->Tick(LEVELTICK_All, FrameDeltaSeconds);
+}
+
+void FRiftlineBenchmarkSession::EndScenario()
+{
+    if (bCrowdTracking)
+    {
+        for (URiftlineInteractionComponent* Agent : Crowd)
+        {
+            Agent->SetFocusTracking(false);
+        }
+        bCrowdTracking = false;
+    }
+    if (bRadialShown)
+    {
+        HUD->ClearRadialEntries();
+        bRadialShown = false;
+    }
+    Phone->NotifyPhoneVisible(false);
+    GameInstance->SessionStore.Flush();
+}
+
+void FRiftlineBenchmarkSession::FillHeartbeatWindow(int32 Iteration)
+{
+    for (int32 Frame = 0; Frame < FramesPerHeartbeat; ++Frame)
+    {
+        FCoreDelegates::OnEndFrame.Broadcast();
+    }
+}
+
+void FRiftlineBenchmarkSession::StepHeartbeat(int32 Iteration)
+{
+    GameInstance->SamplePerformanceWindow();
+    GameInstance->HeartbeatTick();
+}
+
+namespace RiftlineBenchmark
+{
+    TArray<FString> GetScenarioNames()
+    {
+        TArray<FString> Names;
+        for (const FScenario& Scenario : Scenarios)
+        {
+            Names.Add(Scenario.Name);
+        }
+        return Names;
+    }
+
+    bool Run(const FRiftlineBenchmarkSettings& Settings, TArray<FRiftlineBenchmarkResult>& OutResults)
+    {
+        OutResults.Reset();
+
+        FRiftlineBenchmarkSession Session;
+        if (!Session.Setup())
+        {
+            Session.Teardown();
+            return false;
+        }
+
+        {
+            const FScopedAllocationCounter Counter;
+            for (const FScenario& Scenario : Scenarios)
+            {
+                if (Settings.Scenarios.Num() > 0 && !Settings.Scenarios.Contains(Scenario.Name))
+                {
+                    continue;
+                }
+                OutResults.Add(RunScenario(Session, Scenario, Settings, Counter.Get()));
+                Session.EndScenario();
+
+                const FRiftlineBenchmarkResult& Result = OutResults.Last();
+                UE_LOG(LogRiftlineBenchmark, Display, TEXT("%-18s mean %8.2fus p50 %8.2fus p90 %8.2fus p99 %8.2fus allocs %6.1f"),
+                    *Result.Name, Result.MeanUs, Result.P50Us, Result.P90Us, Result.P99Us, Result.AllocsPerIteration);
+            }
+        }
+
+        Session.Teardown();
+        return OutResults.Num() > 0;
+    }
+
+    FString ToJson(const TArray<FRiftlineBenchmarkResult>& Results)
+    {
+        TArray<TSharedPtr<FJsonValue>> Entries;
+        for (const FRiftlineBenchmarkResult& Result : Results)
+        {
+            Entries.Add(MakeShared<FJsonValueObject>(ResultToJson(Result)));
+        }
+
+        const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+        Root->SetStringField(TEXT("platform"), FString(FPlatformProperties::IniPlatformName()));
+        Root->SetStringField(TEXT("capturedAt"), FDateTime::UtcNow().ToIso8601());
+        Root->SetArrayField(TEXT("scenarios"), Entries);
+
+        FString Output;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+        FJsonSerializer::Serialize(Root, Writer);
+        return Output;
+    }
+
+    FString ToCsv(const TArray<FRiftlineBenchmarkResult>& Results)
+    {
+        FString Output = TEXT("scenario,iterations,mean_us,p50_us,p90_us,p99_us,max_us,allocs_per_iteration,bytes_per_iteration\n");
+        for (const FRiftlineBenchmarkResult& Result : Results)
+        {
+            Output += FString::Printf(TEXT("%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.2f,%.1f\n"),
+                *Result.Name, Result.Iterations, Result.MeanUs, Result.P50Us, Result.P90Us, Result.P99Us, Result.MaxUs,
+                Result.AllocsPerIteration, Result.BytesPerIteration);
+        }
+        return Output;
+    }
+
+    bool FromJson(const FString& Json, TArray<FRiftlineBenchmarkResult>& OutResults)
+    {
+        OutResults.Reset();
+
+        TSharedPtr<FJsonObject> Root;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+        const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+        if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !Root->TryGetArrayField(TEXT("scenarios"), Entries))
+        {
+            return false;
+        }
+
+        for (const TSharedPtr<FJsonValue>& Value : *Entries)
+        {
+            const TSharedPtr<FJsonObject>* Entry = nullptr;
+            if (!Value.IsValid() || !Value->TryGetObject(Entry))
+            {
+                continue;
+            }
+
+            FRiftlineBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+            (*Entry)->TryGetStringField(TEXT("name"), Result.Name);
+            (*Entry)->TryGetNumberField(TEXT("iterations"), Result.Iterations);
+            (*Entry)->TryGetNumberField(TEXT("meanUs"), Result.MeanUs);
+            (*Entry)->TryGetNumberField(TEXT("p50Us"), Result.P50Us);
+            (*Entry)->TryGetNumberField(TEXT("p90Us"), Result.P90Us);
+            (*Entry)->TryGetNumberField(TEXT("p99Us"), Result.P99Us);
+            (*Entry)->TryGetNumberField(TEXT("maxUs"), Result.MaxUs);
+            (*Entry)->TryGetNumberField(TEXT("allocsPerIteration"), Result.AllocsPerIteration);
+            (*Entry)->TryGetNumberField(TEXT("bytesPerIteration"), Result.BytesPerIteration);
+        }
+        return true;
+    }
+
+    TArray<FString> Compare(
+        const TArray<FRiftlineBenchmarkResult>& Baseline,
+        const TArray<FRiftlineBenchmarkResult>& Current,
+        const FRiftlineBenchmarkThresholds& Thresholds)
+    {
+        TArray<FString> Regressions;
+        for (const FRiftlineBenchmarkResult& Before : Baseline)
+        {
+            const FRiftlineBenchmarkResult* After = Current.FindByPredicate([&Before](const FRiftlineBenchmarkResult& Result)
+            {
+                return Result.Name == Before.Name;
+            });
+            if (!After)
+            {
+                // A renamed or crashed scenario would otherwise pass the gate by measuring nothing.
+                Regressions.Add(FString::Printf(TEXT("%s missing from this run"), *Before.Name));
+                continue;
+            }
+
+            auto Check = [&Regressions, &Before](const TCHAR* Metric, double Old, double New, double Ratio, double Slack)
+            {
+                if (New > Old * (1.0 + Ratio) + Slack)
+                {
+                    Regressions.Add(FString::Printf(TEXT("%s %s %.2f -> %.2f"), *Before.Name, Metric, Old, New));
+                }
+            };
+            // The median catches steady cost growth; p90 catches new slow paths that only some iterations take.
+            Check(TEXT("p50Us"), Before.P50Us, After->P50Us, Thresholds.Time, Thresholds.TimeSlackUs);
+            Check(TEXT("p90Us"), Before.P90Us, After->P90Us, Thresholds.Time, Thresholds.TimeSlackUs);
+            Check(TEXT("allocsPerIteration"), Before.AllocsPerIteration, After->AllocsPerIteration, Thresholds.Allocations, Thresholds.AllocationSlack);
+        }
+        return Regressions;
+    }
+}
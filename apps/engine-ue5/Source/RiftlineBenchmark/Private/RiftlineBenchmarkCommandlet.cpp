@@ -0,0 +1,91 @@
+#include "RiftlineBenchmarkCommandlet.h"
+
+#include "HAL/PlatformProperties.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "RiftlineBenchmark.h"
+
+namespace
+{
+    constexpr int32 ExitRegressed = 2;
+    constexpr int32 ExitNoBaseline = 3;
+}
+
+URiftlineBenchmarkCommandlet::URiftlineBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 URiftlineBenchmarkCommandlet::Main(const FString& Params)
+{
+    FRiftlineBenchmarkSettings Settings;
+    FParse::Value(*Params, TEXT("iterations="), Settings.Iterations);
+    FParse::Value(*Params, TEXT("warmup="), Settings.WarmupIterations);
+
+    FString ScenarioList;
+    if (FParse::Value(*Params, TEXT("scenarios="), ScenarioList, false))
+    {
+        ScenarioList.ParseIntoArray(Settings.Scenarios, TEXT(","));
+    }
+
+    FRiftlineBenchmarkThresholds Thresholds;
+    FParse::Value(*Params, TEXT("threshold="), Thresholds.Time);
+    FParse::Value(*Params, TEXT("allocthreshold="), Thresholds.Allocations);
+
+    const FString Platform(FPlatformProperties::IniPlatformName());
+    FString OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"));
+    FParse::Value(*Params, TEXT("output="), OutputDir);
+    FString BaselinePath = FPaths::Combine(FPaths::ProjectDir(), TEXT("Benchmarks"), FString::Printf(TEXT("Baseline-%s.json"), *Platform));
+    FParse::Value(*Params, TEXT("baseline="), BaselinePath);
+
+    TArray<FRiftlineBenchmarkResult> Results;
+    if (!RiftlineBenchmark::Run(Settings, Results))
+    {
+        UE_LOG(LogRiftlineBenchmark, Error, TEXT("Benchmark did not produce any results"));
+        return 1;
+    }
+
+    const FString Json = RiftlineBenchmark::ToJson(Results);
+    const FString Stem = FPaths::Combine(OutputDir, FString::Printf(TEXT("Riftline-%s-%s"), *Platform, *FDateTime::UtcNow().ToString()));
+    FFileHelper::SaveStringToFile(Json, *(Stem + TEXT(".json")));
+    FFileHelper::SaveStringToFile(RiftlineBenchmark::ToCsv(Results), *(Stem + TEXT(".csv")));
+    UE_LOG(LogRiftlineBenchmark, Display, TEXT("Benchmark results written to %s.{json,csv}"), *Stem);
+
+    if (FParse::Param(*Params, TEXT("updatebaseline")))
+    {
+        FFileHelper::SaveStringToFile(Json, *BaselinePath);
+        UE_LOG(LogRiftlineBenchmark, Display, TEXT("Baseline updated at %s"), *BaselinePath);
+        return 0;
+    }
+
+    FString BaselineJson;
+    TArray<FRiftlineBenchmarkResult> Baseline;
+    if (!FFileHelper::LoadFileToString(BaselineJson, *BaselinePath) || !RiftlineBenchmark::FromJson(BaselineJson, Baseline))
+    {
+        // A gate without a baseline would pass every run; recording one has to be asked for.
+        UE_LOG(LogRiftlineBenchmark, Error, TEXT("No readable baseline at %s; run with -updatebaseline to record one"), *BaselinePath);
+        return ExitNoBaseline;
+    }
+    if (Settings.Scenarios.Num() > 0)
+    {
+        // Scenarios left out on purpose are not missing.
+        Baseline.RemoveAll([&Settings](const FRiftlineBenchmarkResult& Result) { return !Settings.Scenarios.Contains(Result.Name); });
+    }
+
+    const TArray<FString> Regressions = RiftlineBenchmark::Compare(Baseline, Results, Thresholds);
+    for (const FString& Regression : Regressions)
+    {
+        UE_LOG(LogRiftlineBenchmark, Error, TEXT("Benchmark regression: %s"), *Regression);
+    }
+    if (Regressions.Num() > 0)
+    {
+        return ExitRegressed;
+    }
+
+    UE_LOG(LogRiftlineBenchmark, Display, TEXT("Benchmark within thresholds of %s"), *BaselinePath);
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "RiftlineBenchmarkFixtures.h"
+
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "RiftlineGameInstance.h"
+#include "RiftlineInteractionSubsystem.h"
+
+ARiftlineBenchmarkTarget::ARiftlineBenchmarkTarget()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    Box = CreateDefaultSubobject<UBoxComponent>(TEXT("Box"));
+    Box->SetBoxExtent(FVector(60.f, 60.f, 120.f));
+    Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+    RootComponent = Box;
+
+    Interactable = CreateDefaultSubobject<URiftlineInteractableComponent>(TEXT("Interactable"));
+    Interactable->SetupAttachment(Box);
+}
+
+void ARiftlineBenchmarkTarget::GetInteractionOptions_Implementation(TArray<FRiftlineInteractionOption>& Options, APawn* RequestingPawn) const
+{
+    static const FName OptionIds[] = { TEXT("inspect"), TEXT("buy"), TEXT("steal") };
+    for (const FName& Id : OptionIds)
+    {
+        FRiftlineInteractionOption& Option = Options.AddDefaulted_GetRef();
+        Option.Id = Id;
+        Option.Label = FText::FromName(Id);
+    }
+}
+
+void ARiftlineBenchmarkTarget::PerformInteraction_Implementation(FName OptionId, APawn* RequestingPawn)
+{
+}
+
+void URiftlineBenchmarkHUDWidget::Bind(URiftlineGameInstance* GameInstance)
+{
+    GameInstance->OnWantedStateChanged.AddDynamic(this, &URiftlineBenchmarkHUDWidget::HandleWanted);
+    GameInstance->OnComplianceChanged.AddDynamic(this, &URiftlineBenchmarkHUDWidget::HandleCompliance);
+}
+
+void URiftlineBenchmarkHUDWidget::HandleWanted(const FRiftlineWantedState& State)
+{
+    SetHeat(State.Heat);
+    SetWantedLevel(static_cast<int32>(State.Level));
+}
+
+void URiftlineBenchmarkHUDWidget::HandleCompliance(const FRiftlineComplianceState& State)
+{
+    SetComplianceState(State);
+}
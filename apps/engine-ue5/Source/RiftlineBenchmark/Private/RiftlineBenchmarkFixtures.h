@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "RiftlineHUDWidget.h"
+#include "RiftlineInteractionComponent.h"
+#include "RiftlinePhoneWidget.h"
+#include "RiftlineBenchmarkFixtures.generated.h"
+
+class UBoxComponent;
+class URiftlineGameInstance;
+class URiftlineInteractableComponent;
+
+/** Interactable placed along the benchmark route; blocks the visibility channel like a kiosk or vehicle would. */
+UCLASS(NotBlueprintable, NotPlaceable, Transient, HideDropdown)
+class ARiftlineBenchmarkTarget : public AActor, public IRiftlineInteractable
+{
+    GENERATED_BODY()
+
+public:
+    ARiftlineBenchmarkTarget();
+
+    virtual void GetInteractionOptions_Implementation(TArray<FRiftlineInteractionOption>& Options, APawn* RequestingPawn) const override;
+    virtual void PerformInteraction_Implementation(FName OptionId, APawn* RequestingPawn) override;
+
+private:
+    UPROPERTY()
+    UBoxComponent* Box;
+
+    UPROPERTY()
+    URiftlineInteractableComponent* Interactable;
+};
+
+/** Phone widget without a widget tree, so the native update paths run without UMG assets. */
+UCLASS(NotBlueprintable, Transient, HideDropdown)
+class URiftlineBenchmarkPhoneWidget : public URiftlinePhoneWidget
+{
+    GENERATED_BODY()
+};
+
+/** HUD widget bound straight to the game instance; ARiftlineHUD needs a player controller the benchmark does not spawn. */
+UCLASS(NotBlueprintable, Transient, HideDropdown)
+class URiftlineBenchmarkHUDWidget : public URiftlineHUDWidget
+{
+    GENERATED_BODY()
+
+public:
+    void Bind(URiftlineGameInstance* GameInstance);
+
+private:
+    UFUNCTION()
+    void HandleWanted(const FRiftlineWantedState& State);
+
+    UFUNCTION()
+    void HandleCompliance(const FRiftlineComplianceState& State);
+};
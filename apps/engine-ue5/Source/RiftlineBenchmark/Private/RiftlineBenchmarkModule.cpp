@@ -0,0 +1,6 @@
+#include "RiftlineBenchmark.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, RiftlineBenchmark);
+
+DEFINE_LOG_CATEGORY(LogRiftlineBenchmark);
@@ -0,0 +1,76 @@
+#include "Misc/AutomationTest.h"
+#include "RiftlineBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FRiftlineBenchmarkSpec, "Riftline.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    FRiftlineBenchmarkResult MakeResult(double P50Us, double P90Us, double Allocs) const
+    {
+        FRiftlineBenchmarkResult Result;
+        Result.Name = TEXT("phone.tabs");
+        Result.Iterations = 100;
+        Result.P50Us = P50Us;
+        Result.P90Us = P90Us;
+        Result.AllocsPerIteration = Allocs;
+        return Result;
+    }
+END_DEFINE_SPEC(FRiftlineBenchmarkSpec)
+
+void FRiftlineBenchmarkSpec::Define()
+{
+    Describe("Compare", [this]()
+    {
+        It("passes results within the thresholds", [this]()
+        {
+            const TArray<FString> Regressions = RiftlineBenchmark::Compare({ MakeResult(20.0, 30.0, 4.0) }, { MakeResult(22.0, 33.0, 4.0) }, FRiftlineBenchmarkThresholds());
+            TestEqual(TEXT("Regressions"), Regressions.Num(), 0);
+        });
+
+        It("flags time and allocation growth past the thresholds", [this]()
+        {
+            const TArray<FString> Regressions = RiftlineBenchmark::Compare({ MakeResult(20.0, 30.0, 4.0) }, { MakeResult(40.0, 30.0, 12.0) }, FRiftlineBenchmarkThresholds());
+            TestEqual(TEXT("Regressions"), Regressions.Num(), 2);
+        });
+
+        It("absorbs noise on near-zero figures with the slack", [this]()
+        {
+            const TArray<FString> Regressions = RiftlineBenchmark::Compare({ MakeResult(0.2, 0.3, 0.0) }, { MakeResult(0.6, 0.9, 1.0) }, FRiftlineBenchmarkThresholds());
+            TestEqual(TEXT("Regressions"), Regressions.Num(), 0);
+        });
+
+        It("fails baseline scenarios missing from the current run", [this]()
+        {
+            FRiftlineBenchmarkResult Added = MakeResult(20.0, 30.0, 4.0);
+            Added.Name = TEXT("phone.renamed");
+            TestEqual(TEXT("Missing"), RiftlineBenchmark::Compare({ MakeResult(20.0, 30.0, 4.0) }, { Added }, FRiftlineBenchmarkThresholds()).Num(), 1);
+            TestEqual(TEXT("New only"), RiftlineBenchmark::Compare({}, { Added }, FRiftlineBenchmarkThresholds()).Num(), 0);
+        });
+
+        It("round-trips results through JSON", [this]()
+        {
+            TArray<FRiftlineBenchmarkResult> Parsed;
+            TestTrue(TEXT("Parsed"), RiftlineBenchmark::FromJson(RiftlineBenchmark::ToJson({ MakeResult(20.0, 30.0, 4.0) }), Parsed));
+            if (TestEqual(TEXT("Count"), Parsed.Num(), 1))
+            {
+                TestEqual(TEXT("Name"), Parsed[0].Name, FString(TEXT("phone.tabs")));
+                TestEqual(TEXT("P90"), Parsed[0].P90Us, 30.0);
+            }
+        });
+    });
+
+    Describe("Run", [this]()
+    {
+        It("produces a result for every scenario", [this]()
+        {
+            FRiftlineBenchmarkSettings Settings;
+            Settings.Iterations = 20;
+            Settings.WarmupIterations = 2;
+
+            TArray<FRiftlineBenchmarkResult> Results;
+            TestTrue(TEXT("Ran"), RiftlineBenchmark::Run(Settings, Results));
+            TestEqual(TEXT("Scenarios"), Results.Num(), RiftlineBenchmark::GetScenarioNames().Num());
+        });
+    });
+}
+
+#endif
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogRiftlineBenchmark, Log, All);
+
+/** Timing and allocation figures for one benchmark scenario; times are per iteration. */
+struct FRiftlineBenchmarkResult
+{
+    FString Name;
+    int32 Iterations = 0;
+    double MeanUs = 0.0;
+    double P50Us = 0.0;
+    double P90Us = 0.0;
+    double P99Us = 0.0;
+    double MaxUs = 0.0;
+
+    /** Counted process-wide, so allocations made by worker threads during a scenario are included. */
+    double AllocsPerIteration = 0.0;
+    double BytesPerIteration = 0.0;
+};
+
+struct FRiftlineBenchmarkSettings
+{
+    int32 Iterations = 2000;
+    int32 WarmupIterations = 200;
+
+    /** Scenario names to run; empty runs all of them. */
+    TArray<FString> Scenarios;
+};
+
+/** Allowed growth over the baseline as a fraction; the slack keeps near-zero figures from tripping on noise. */
+struct FRiftlineBenchmarkThresholds
+{
+    double Time = 0.15;
+    double Allocations = 0.10;
+    double TimeSlackUs = 2.0;
+    double AllocationSlack = 1.0;
+};
+
+/**
+ * Headless game-thread benchmark: boots a transient game world with a Riftline game instance, pawn, HUD and
+ * phone widgets, then times a scripted interaction route, phone toggles, tab switches, wanted, compliance and
+ * auction update storms, frame ticks and heartbeat windows. Run through URiftlineBenchmarkCommandlet.
+ */
+namespace RiftlineBenchmark
+{
+    RIFTLINEBENCHMARK_API TArray<FString> GetScenarioNames();
+
+    RIFTLINEBENCHMARK_API bool Run(const FRiftlineBenchmarkSettings& Settings, TArray<FRiftlineBenchmarkResult>& OutResults);
+
+    RIFTLINEBENCHMARK_API FString ToJson(const TArray<FRiftlineBenchmarkResult>& Results);
+    RIFTLINEBENCHMARK_API FString ToCsv(const TArray<FRiftlineBenchmarkResult>& Results);
+    RIFTLINEBENCHMARK_API bool FromJson(const FString& Json, TArray<FRiftlineBenchmarkResult>& OutResults);
+
+    /** Returns one line per regressed metric and per baseline scenario missing from Current; new scenarios are skipped. */
+    RIFTLINEBENCHMARK_API TArray<FString> Compare(
+        const TArray<FRiftlineBenchmarkResult>& Baseline,
+        const TArray<FRiftlineBenchmarkResult>& Current,
+        const FRiftlineBenchmarkThresholds& Thresholds);
+}
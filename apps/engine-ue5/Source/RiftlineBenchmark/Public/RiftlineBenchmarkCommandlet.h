@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RiftlineBenchmarkCommandlet.generated.h"
+
+/**
+ * Runs the Riftline benchmark headless and gates on regressions:
+ *   UnrealEditor-Cmd Riftline.uproject -run=RiftlineBenchmark -nullrhi -unattended
+ *     [-iterations=2000] [-warmup=200] [-scenarios=phone.tabs,wanted.storm] [-output=<dir>]
+ *     [-baseline=<file>] [-threshold=0.15] [-allocthreshold=0.10] [-updatebaseline]
+ * Results are written as JSON and CSV. Returns 0 on success, 1 if the run failed, 2 if any scenario regressed
+ * against the baseline (Benchmarks/Baseline-<platform>.json under the project unless overridden) and 3 if there is
+ * no baseline to compare with; -updatebaseline records one instead of comparing.
+ */
+UCLASS()
+class RIFTLINEBENCHMARK_API URiftlineBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    URiftlineBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,24 @@
+using UnrealBuildTool;
+
+/** Headless benchmark and its fixtures; a DeveloperTool module, so shipping builds never contain it. */
+public class RiftlineBenchmark : ModuleRules
+{
+    public RiftlineBenchmark(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(new[]
+        {
+            "Core",
+            "CoreUObject",
+            "Engine"
+        });
+
+        PrivateDependencyModuleNames.AddRange(new[]
+        {
+            "Json",
+            "Riftline",
+            "UMG"
+        });
+    }
+}
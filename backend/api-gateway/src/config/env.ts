@@ -25,6 +25,8 @@ export interface AppConfig {
   rpcUrl: string;
   operatorKey: string;
   nakamaRpcUrl?: string;
+  heartbeatIntervalSec: number;
+  heartbeatTargetRps: number;
   deployments: DeploymentAddresses;
 }
 
@@ -75,6 +77,8 @@ export function loadConfig(): AppConfig {
     rpcUrl: process.env.RPC_URL,
     operatorKey: process.env.OPERATOR_KEY,
     nakamaRpcUrl: process.env.NAKAMA_RPC_URL,
+    heartbeatIntervalSec: Number(process.env.HEARTBEAT_INTERVAL_SEC ?? 15),
+    heartbeatTargetRps: Number(process.env.HEARTBEAT_TARGET_RPS ?? 0),
     deployments: readDeployment()
   };
 }
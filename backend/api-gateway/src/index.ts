@@ -6,6 +6,7 @@ import pinoHttp from "pino-http";
 import { loadConfig } from "./config/env";
 import { rateLimit } from "./middleware/rateLimit";
 import { errorHandler } from "./middleware/errors";
+import { serverTime } from "./middleware/serverTime";
 import { logger } from "./services/logger";
 import authRoutes from "./routes/auth";
 import playerRoutes from "./routes/players";
@@ -29,6 +30,7 @@ import adminRoutes from "./routes/admin";
 const config = loadConfig();
 const app = express();
 
+app.use(serverTime());
 app.use(pinoHttp({ logger }));
 app.use(helmet());
 app.use(cors({ origin: config.corsOrigin, credentials: true }));
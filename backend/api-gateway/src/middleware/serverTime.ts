@@ -0,0 +1,25 @@
+import type { Request, Response, NextFunction } from "express";
+
+/**
+ * Stamps every response with the time the request arrived (`X-Server-Time`, Unix ms) and how long it took to handle
+ * (`Server-Timing: app;dur=`). Clients pair these with their own send and receive times to estimate round-trip time
+ * and clock offset the way NTP does, without a dedicated time endpoint.
+ */
+export function serverTime() {
+  return (_req: Request, res: Response, next: NextFunction) => {
+    const receivedAt = Date.now();
+    const started = process.hrtime.bigint();
+    const writeHead = res.writeHead;
+
+    res.writeHead = function (this: Response, ...args: any[]) {
+      if (!res.headersSent) {
+        const durationMs = Number(process.hrtime.bigint() - started) / 1e6;
+        res.setHeader("X-Server-Time", receivedAt.toString());
+        res.setHeader("Server-Timing", `app;dur=${durationMs.toFixed(1)}`);
+      }
+      return (writeHead as (...params: any[]) => Response).apply(this, args);
+    } as typeof res.writeHead;
+
+    next();
+  };
+}
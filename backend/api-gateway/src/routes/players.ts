@@ -1,10 +1,13 @@
-import { Router } from "express";
+import express, { Router } from "express";
 import jwt from "jsonwebtoken";
 import { prisma } from "../services/db";
 import { loadConfig } from "../config/env";
 import { createGuestSchema, heartbeatSchema, updateProfileSchema } from "../validators/players";
 import { requireAuth } from "../middleware/auth";
 import { serializeBigInt } from "../utils/serialization";
+import { heartbeatPacer } from "../services/heartbeat";
+import { ingestTelemetryBatch } from "../services/telemetryIngest";
+import { decodeHeartbeat, HEARTBEAT_BINARY_TYPE, TelemetryWireError } from "../services/telemetryWire";
 
 const router = Router();
 const { jwtSecret } = loadConfig();
@@ -50,17 +53,24 @@ router.patch("/me", requireAuth, async (req, res, next) => {
   }
 });
 
-router.post("/heartbeat", requireAuth, async (req, res, next) => {
+router.post("/heartbeat", requireAuth, express.raw({ type: HEARTBEAT_BINARY_TYPE, limit: "1mb" }), async (req, res, next) => {
   try {
-    const { shardId } = heartbeatSchema.parse(req.body ?? {});
+    const body = Buffer.isBuffer(req.body) ? decodeHeartbeat(req.body) : req.body;
+    const { shardId, playerId, dropped, events } = heartbeatSchema.parse(body ?? {});
     await prisma.player.update({
       where: { id: req.auth!.id },
       data: {
         shardId: typeof shardId === "number" ? shardId : undefined
       }
     });
-    res.json({ ok: true });
+    const accepted = events && events.length > 0
+      ? await ingestTelemetryBatch({ playerId, dropped, events }, req.auth!.wallet)
+      : 0;
+    res.json({ ok: true, accepted, nextHeartbeatSec: heartbeatPacer.record() });
   } catch (err) {
+    if (err instanceof TelemetryWireError) {
+      return res.status(400).json({ error: "invalid_heartbeat" });
+    }
     next(err);
   }
 });
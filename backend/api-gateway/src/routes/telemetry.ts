@@ -1,8 +1,11 @@
 import type { Request } from "express";
-import { Router } from "express";
+import express, { Router } from "express";
 import jwt from "jsonwebtoken";
 import { prisma } from "../services/db";
 import { loadConfig } from "../config/env";
+import { ingestTelemetryBatch } from "../services/telemetryIngest";
+import { telemetryBatchSchema } from "../validators/telemetry";
+import { decodeTelemetryBatch, TELEMETRY_BINARY_TYPE, TelemetryWireError } from "../services/telemetryWire";
 
 const router = Router();
 const { jwtSecret } = loadConfig();
@@ -49,6 +52,24 @@ router.post("/", async (req, res, next) => {
   }
 });
 
+router.post("/events", express.raw({ type: TELEMETRY_BINARY_TYPE, limit: "1mb" }), async (req, res, next) => {
+  try {
+    const body = Buffer.isBuffer(req.body) ? decodeTelemetryBatch(req.body) : req.body;
+    const parsed = telemetryBatchSchema.safeParse(body ?? {});
+    if (!parsed.success) {
+      return res.status(400).json({ error: "invalid_batch" });
+    }
+
+    const count = await ingestTelemetryBatch(parsed.data, resolveWallet(req) ?? undefined);
+    res.json({ ok: true, accepted: count });
+  } catch (err) {
+    if (err instanceof TelemetryWireError) {
+      return res.status(400).json({ error: "invalid_batch" });
+    }
+    next(err);
+  }
+});
+
 router.get("/stats", async (_req, res, next) => {
   try {
     const [total, lastHour] = await Promise.all([
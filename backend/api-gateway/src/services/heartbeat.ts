@@ -0,0 +1,58 @@
+import { loadConfig } from "../config/env";
+
+export const MIN_HEARTBEAT_SEC = 5;
+export const MAX_HEARTBEAT_SEC = 300;
+
+const WINDOW_MS = 10_000;
+
+/**
+ * Picks the interval returned to clients in each heartbeat response. Below the target rate every client gets the
+ * configured base interval; above it the interval grows with the observed rate, so the fleet's heartbeat load settles
+ * back near the target within one interval instead of compounding during a reconnect wave. A target of 0 disables
+ * the stretch.
+ */
+export class HeartbeatPacer {
+  private windowStart = 0;
+  private current = 0;
+  private previous = 0;
+
+  constructor(
+    private readonly baseSec: number,
+    private readonly targetRps: number
+  ) {}
+
+  record(now = Date.now()): number {
+    this.roll(now);
+    this.current++;
+    return this.nextIntervalSec(now);
+  }
+
+  /** Requests per second over the last full window plus the elapsed part of the current one. */
+  rate(now = Date.now()): number {
+    this.roll(now);
+    const elapsed = Math.max(now - this.windowStart, 1);
+    return (this.previous + this.current) / ((WINDOW_MS + elapsed) / 1000);
+  }
+
+  nextIntervalSec(now = Date.now()): number {
+    const base = clamp(this.baseSec, MIN_HEARTBEAT_SEC, MAX_HEARTBEAT_SEC);
+    if (this.targetRps <= 0) return base;
+    const stretch = Math.max(1, this.rate(now) / this.targetRps);
+    return Math.round(clamp(base * stretch, MIN_HEARTBEAT_SEC, MAX_HEARTBEAT_SEC));
+  }
+
+  private roll(now: number) {
+    if (now - this.windowStart < WINDOW_MS) return;
+    this.previous = now - this.windowStart < 2 * WINDOW_MS ? this.current : 0;
+    this.current = 0;
+    this.windowStart = now - ((now - this.windowStart) % WINDOW_MS);
+  }
+}
+
+function clamp(value: number, min: number, max: number) {
+  return Number.isFinite(value) ? Math.min(Math.max(value, min), max) : min;
+}
+
+const { heartbeatIntervalSec, heartbeatTargetRps } = loadConfig();
+
+export const heartbeatPacer = new HeartbeatPacer(heartbeatIntervalSec, heartbeatTargetRps);
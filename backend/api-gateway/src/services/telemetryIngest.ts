@@ -0,0 +1,24 @@
+import { prisma } from "./db";
+import { logger } from "./logger";
+import type { TelemetryBatch } from "../validators/telemetry";
+
+/** Stores a validated batch in one insert; shared by /telemetry/events and batches piggybacked on heartbeats. */
+export async function ingestTelemetryBatch(batch: TelemetryBatch, wallet?: string): Promise<number> {
+  const { playerId, dropped, events } = batch;
+  if (dropped && dropped > 0) {
+    logger.warn({ playerId, dropped }, "client telemetry queue dropped events");
+  }
+  const { count } = await prisma.telemetryEvent.createMany({
+    data: events.map((event) => ({
+      wallet,
+      kind: event.event,
+      shardId: event.shardId,
+      payload: {
+        ...(event.properties ?? {}),
+        playerId,
+        clientTs: event.ts
+      }
+    }))
+  });
+  return count;
+}
@@ -0,0 +1,152 @@
+import type { TelemetryBatch } from "../validators/telemetry";
+
+export const TELEMETRY_BINARY_TYPE = "application/vnd.riftline.telemetry+bin";
+export const HEARTBEAT_BINARY_TYPE = "application/vnd.riftline.heartbeat+bin";
+
+const BATCH_MAGIC = "RLT1";
+const HEARTBEAT_MAGIC = "RLH1";
+
+// Mirrors ERiftlineTelemetryValueType in the client; enum values always arrive as names.
+const enum ValueType {
+  Int = 0,
+  Float = 1,
+  Bool = 2,
+  Name = 3,
+  String = 5
+}
+
+export class TelemetryWireError extends Error {}
+
+class Reader {
+  private offset = 0;
+
+  constructor(private readonly buffer: Buffer) {}
+
+  magic(expected: string) {
+    if (this.buffer.length < 4 || this.buffer.toString("latin1", 0, 4) !== expected) {
+      throw new TelemetryWireError("bad_magic");
+    }
+    this.offset = 4;
+  }
+
+  byte(): number {
+    if (this.offset >= this.buffer.length) throw new TelemetryWireError("truncated");
+    return this.buffer[this.offset++];
+  }
+
+  // Timestamps exceed 32 bits, so accumulate with multiplication instead of bit shifts. Seven bytes (49 bits) stay
+  // exact in a double; the client writes full int64 values, so the last three of the ten bytes finish in BigInt.
+  private raw(): number | bigint {
+    let result = 0;
+    let scale = 1;
+    for (let i = 0; i < 7; i++) {
+      const b = this.byte();
+      result += (b & 0x7f) * scale;
+      if ((b & 0x80) === 0) return result;
+      scale *= 128;
+    }
+    let wide = BigInt(result);
+    for (let shift = 49n; shift < 70n; shift += 7n) {
+      const b = this.byte();
+      wide |= BigInt(b & 0x7f) << shift;
+      if ((b & 0x80) === 0) return BigInt.asUintN(64, wide);
+    }
+    throw new TelemetryWireError("varint_overflow");
+  }
+
+  varint(): number {
+    const n = this.raw();
+    return typeof n === "number" ? n : Number(n);
+  }
+
+  zigzag(): number {
+    const n = this.raw();
+    if (typeof n === "bigint") return Number((n >> 1n) ^ -(n & 1n));
+    return n % 2 === 0 ? n / 2 : -(n + 1) / 2;
+  }
+
+  float(): number {
+    if (this.offset + 4 > this.buffer.length) throw new TelemetryWireError("truncated");
+    const value = this.buffer.readFloatLE(this.offset);
+    this.offset += 4;
+    return value;
+  }
+
+  remaining(): Buffer {
+    const rest = this.buffer.subarray(this.offset);
+    this.offset = this.buffer.length;
+    return rest;
+  }
+
+  string(): string {
+    const length = this.varint();
+    if (this.offset + length > this.buffer.length) throw new TelemetryWireError("truncated");
+    const value = this.buffer.toString("utf8", this.offset, this.offset + length);
+    this.offset += length;
+    return value;
+  }
+}
+
+function lookup(dictionary: string[], index: number): string {
+  const value = dictionary[index];
+  if (value === undefined) throw new TelemetryWireError("bad_dictionary_index");
+  return value;
+}
+
+/** Decodes an RLT1 batch into the same shape the JSON body takes; the result still goes through the zod schema. */
+export function decodeTelemetryBatch(buffer: Buffer): TelemetryBatch {
+  const reader = new Reader(buffer);
+  reader.magic(BATCH_MAGIC);
+
+  const playerId = reader.string();
+  const dropped = reader.varint();
+  const dictionary = Array.from({ length: reader.varint() }, () => reader.string());
+
+  const events: TelemetryBatch["events"] = [];
+  const eventCount = reader.varint();
+  let ts = 0;
+  for (let i = 0; i < eventCount; i++) {
+    const event = lookup(dictionary, reader.varint());
+    ts += reader.zigzag();
+    const shardId = reader.zigzag();
+    const properties: Record<string, unknown> = {};
+    const fieldCount = reader.varint();
+    for (let f = 0; f < fieldCount; f++) {
+      const key = lookup(dictionary, reader.varint());
+      switch (reader.byte()) {
+        case ValueType.Int:
+          properties[key] = reader.zigzag();
+          break;
+        case ValueType.Float:
+          properties[key] = reader.float();
+          break;
+        case ValueType.Bool:
+          properties[key] = reader.byte() !== 0;
+          break;
+        case ValueType.Name:
+          properties[key] = lookup(dictionary, reader.varint());
+          break;
+        case ValueType.String:
+          properties[key] = reader.string();
+          break;
+        default:
+          throw new TelemetryWireError("bad_value_type");
+      }
+    }
+    events.push({ event, ts, shardId: shardId >= 0 ? shardId : undefined, properties });
+  }
+
+  return { playerId: playerId.length > 0 ? playerId : undefined, dropped, events };
+}
+
+/** Decodes an RLH1 heartbeat; a piggybacked RLT1 batch may follow the shard id. */
+export function decodeHeartbeat(buffer: Buffer): { shardId?: number } & Partial<TelemetryBatch> {
+  const reader = new Reader(buffer);
+  reader.magic(HEARTBEAT_MAGIC);
+  const shardId = reader.zigzag();
+  const batch = reader.remaining();
+  return {
+    shardId: shardId >= 0 ? shardId : undefined,
+    ...(batch.length > 0 ? decodeTelemetryBatch(batch) : {})
+  };
+}
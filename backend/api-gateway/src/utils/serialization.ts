@@ -6,6 +6,8 @@ export function serializeBigInt(input: any): any {
   if (input === null || input === undefined) return input;
   if (typeof input === "bigint") return input.toString();
   if (isDecimal(input)) return input.toString();
+  // Dates have no own enumerable keys, so the object walk below would turn them into {}.
+  if (input instanceof Date) return input.toISOString();
   if (Array.isArray(input)) return input.map((item) => serializeBigInt(item));
   if (typeof input === "object") {
     const out: Record<string, any> = {};
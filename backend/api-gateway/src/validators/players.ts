@@ -1,4 +1,5 @@
 import { z } from "zod";
+import { MAX_TELEMETRY_BATCH, telemetryEventSchema } from "./telemetry";
 
 export const createGuestSchema = z.object({
   username: z.string().trim().min(3).max(32).optional()
@@ -9,6 +10,10 @@ export const updateProfileSchema = z.object({
   pushToken: z.string().trim().max(256).optional()
 });
 
+// Telemetry fields are optional: clients attach their pending batch when one is ready.
 export const heartbeatSchema = z.object({
-  shardId: z.number().int().optional()
+  shardId: z.number().int().optional(),
+  playerId: z.string().trim().max(128).optional(),
+  dropped: z.number().int().nonnegative().optional(),
+  events: z.array(telemetryEventSchema).max(MAX_TELEMETRY_BATCH).optional()
 });
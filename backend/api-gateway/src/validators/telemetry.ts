@@ -0,0 +1,18 @@
+import { z } from "zod";
+
+export const MAX_TELEMETRY_BATCH = 500;
+
+export const telemetryEventSchema = z.object({
+  event: z.string().trim().min(1).max(64),
+  ts: z.number().int().nonnegative().optional(),
+  shardId: z.number().int().optional(),
+  properties: z.record(z.string(), z.unknown()).optional()
+});
+
+export const telemetryBatchSchema = z.object({
+  playerId: z.string().trim().max(128).optional(),
+  dropped: z.number().int().nonnegative().optional(),
+  events: z.array(telemetryEventSchema).min(1).max(MAX_TELEMETRY_BATCH)
+});
+
+export type TelemetryBatch = z.infer<typeof telemetryBatchSchema>;
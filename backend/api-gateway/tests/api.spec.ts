@@ -1,11 +1,19 @@
+import { Prisma } from "@prisma/client";
 import express from "express";
+import { readFileSync } from "fs";
+import jwt from "jsonwebtoken";
 import request from "supertest";
+import { fileURLToPath } from "url";
 import { afterEach, beforeAll, describe, expect, it, vi } from "vitest";
 
 let playersRoute: express.Router;
 let shardsRoute: express.Router;
+let telemetryRoute: express.Router;
 let errorHandler: express.ErrorRequestHandler;
 let prisma: typeof import("../src/services/db").prisma;
+let HeartbeatPacer: typeof import("../src/services/heartbeat").HeartbeatPacer;
+let serverTime: typeof import("../src/middleware/serverTime").serverTime;
+let serializeBigInt: typeof import("../src/utils/serialization").serializeBigInt;
 
 beforeAll(async () => {
   process.env.JWT_SECRET = process.env.JWT_SECRET ?? "test_jwt_secret";
@@ -18,7 +26,11 @@ beforeAll(async () => {
   ({ prisma } = await import("../src/services/db"));
   ({ default: playersRoute } = await import("../src/routes/players"));
   ({ default: shardsRoute } = await import("../src/routes/shards"));
+  ({ default: telemetryRoute } = await import("../src/routes/telemetry"));
   ({ errorHandler } = await import("../src/middleware/errors"));
+  ({ HeartbeatPacer } = await import("../src/services/heartbeat"));
+  ({ serverTime } = await import("../src/middleware/serverTime"));
+  ({ serializeBigInt } = await import("../src/utils/serialization"));
 });
 
 afterEach(() => {
@@ -64,4 +76,187 @@ describe("core API routes", () => {
     expect(Array.isArray(shardResp.body)).toBe(true);
     expect(shardResp.body[0]?.name).toBe("Alpha");
   });
+
+  it("ingests a batched telemetry payload in a single insert", async () => {
+    const createMany = vi.spyOn(prisma.telemetryEvent, "createMany").mockResolvedValue({ count: 2 } as any);
+
+    const app = express();
+    app.use(express.json());
+    app.use("/telemetry", telemetryRoute);
+    app.use(errorHandler);
+
+    const resp = await request(app)
+      .post("/telemetry/events")
+      .send({
+        playerId: "player1",
+        events: [
+          { event: "ui.phone.open", ts: 1700000000000, properties: { source: "toggle" } },
+          { event: "ui.phone.tab", ts: 1700000000500, shardId: 1, properties: { tab: "Map" } }
+        ]
+      });
+    expect(resp.status).toBe(200);
+    expect(resp.body.accepted).toBe(2);
+    expect(createMany).toHaveBeenCalledTimes(1);
+    expect(createMany.mock.calls[0][0]?.data).toHaveLength(2);
+
+    const empty = await request(app).post("/telemetry/events").send({ events: [] });
+    expect(empty.status).toBe(400);
+  });
+
+  it("decodes the binary telemetry wire format", async () => {
+    const createMany = vi.spyOn(prisma.telemetryEvent, "createMany").mockResolvedValue({ count: 1 } as any);
+
+    const app = express();
+    app.use(express.json());
+    app.use("/telemetry", telemetryRoute);
+    app.use(errorHandler);
+
+    // RLT1, playerId "p1", dropped 0, dictionary [ui.phone.tab, tab, Map], one event at ts 1000 on shard 2 with tab=Map.
+    const utf8 = (value: string) => [value.length, ...Buffer.from(value)];
+    const body = Buffer.from([
+      ...Buffer.from("RLT1"),
+      ...utf8("p1"),
+      0,
+      3,
+      ...utf8("ui.phone.tab"),
+      ...utf8("tab"),
+      ...utf8("Map"),
+      1,
+      0, 0xd0, 0x0f, 4, 1,
+      1, 3, 2
+    ]);
+
+    const resp = await request(app)
+      .post("/telemetry/events")
+      .set("Content-Type", "application/vnd.riftline.telemetry+bin")
+      .send(body);
+    expect(resp.status).toBe(200);
+    expect(createMany.mock.calls[0][0]?.data).toEqual([
+      expect.objectContaining({ kind: "ui.phone.tab", shardId: 2, payload: { tab: "Map", playerId: "p1", clientTs: 1000 } })
+    ]);
+
+    const truncated = await request(app)
+      .post("/telemetry/events")
+      .set("Content-Type", "application/vnd.riftline.telemetry+bin")
+      .send(body.subarray(0, body.length - 2));
+    expect(truncated.status).toBe(400);
+  });
+
+  it("decodes the batch the client encodes for the shared golden fixture", async () => {
+    const { decodeTelemetryBatch } = await import("../src/services/telemetryWire");
+    const fixture = JSON.parse(
+      readFileSync(fileURLToPath(new URL("../../../tests/fixtures/telemetry-wire-batch.json", import.meta.url)), "utf8")
+    );
+
+    expect(decodeTelemetryBatch(Buffer.from(fixture.hex, "hex"))).toEqual(fixture.decoded);
+  });
+
+  it("answers heartbeats with the next interval and ingests a piggybacked batch", async () => {
+    const update = vi.spyOn(prisma.player, "update").mockResolvedValue({} as any);
+    const createMany = vi.spyOn(prisma.telemetryEvent, "createMany").mockResolvedValue({ count: 1 } as any);
+
+    const app = express();
+    app.use(express.json());
+    app.use("/players", playersRoute);
+    app.use(errorHandler);
+
+    const token = jwt.sign({ id: "player1", wallet: "guest:mock" }, process.env.JWT_SECRET!);
+    const plain = await request(app).post("/players/heartbeat").set("Authorization", `Bearer ${token}`).send({ shardId: 2 });
+    expect(plain.status).toBe(200);
+    expect(plain.body.nextHeartbeatSec).toBeGreaterThanOrEqual(5);
+    expect(plain.body.accepted).toBe(0);
+    expect(update).toHaveBeenCalledTimes(1);
+    expect(createMany).not.toHaveBeenCalled();
+
+    const carrying = await request(app)
+      .post("/players/heartbeat")
+      .set("Authorization", `Bearer ${token}`)
+      .send({ shardId: 2, playerId: "p1", events: [{ event: "client.frametime", ts: 1000, properties: { p50: 16.6 } }] });
+    expect(carrying.status).toBe(200);
+    expect(carrying.body.accepted).toBe(1);
+    expect(createMany.mock.calls[0][0]?.data).toEqual([
+      expect.objectContaining({ kind: "client.frametime", wallet: "guest:mock", payload: { p50: 16.6, playerId: "p1", clientTs: 1000 } })
+    ]);
+
+    // RLH1 shard 2 followed by an RLT1 batch with one ui.phone.open event and no fields.
+    const utf8 = (value: string) => [value.length, ...Buffer.from(value)];
+    const binary = Buffer.from([
+      ...Buffer.from("RLH1"), 4,
+      ...Buffer.from("RLT1"), ...utf8("p1"), 0, 1, ...utf8("ui.phone.open"),
+      1, 0, 0xd0, 0x0f, 4, 0
+    ]);
+    const binaryResp = await request(app)
+      .post("/players/heartbeat")
+      .set("Authorization", `Bearer ${token}`)
+      .set("Content-Type", "application/vnd.riftline.heartbeat+bin")
+      .send(binary);
+    expect(binaryResp.status).toBe(200);
+    expect(binaryResp.body.accepted).toBe(1);
+    expect(createMany.mock.calls[1][0]?.data).toEqual([expect.objectContaining({ kind: "ui.phone.open", shardId: 2 })]);
+  });
+
+  it("rejects heartbeats without the session token and paces authenticated ones", async () => {
+    const update = vi.spyOn(prisma.player, "update").mockResolvedValue({} as any);
+
+    const app = express();
+    app.use(express.json());
+    app.use("/players", playersRoute);
+    app.use(errorHandler);
+
+    const anonymous = await request(app).post("/players/heartbeat").send({ shardId: 2 });
+    expect(anonymous.status).toBe(401);
+    expect(anonymous.body.nextHeartbeatSec).toBeUndefined();
+    expect(update).not.toHaveBeenCalled();
+
+    // No target rate is configured here, so every client gets the base interval.
+    const token = jwt.sign({ id: "player1", wallet: "guest:mock" }, process.env.JWT_SECRET!);
+    const authed = await request(app).post("/players/heartbeat").set("Authorization", `Bearer ${token}`).send({ shardId: 2 });
+    expect(authed.status).toBe(200);
+    expect(authed.body.nextHeartbeatSec).toBe(Number(process.env.HEARTBEAT_INTERVAL_SEC ?? 15));
+    expect(update).toHaveBeenCalledWith(expect.objectContaining({ where: { id: "player1" } }));
+  });
+
+  it("stretches the heartbeat interval when the fleet exceeds the target rate", () => {
+    const pacer = new HeartbeatPacer(15, 10);
+    const start = 1_700_000_000_000;
+    expect(pacer.record(start)).toBe(15);
+
+    // 400 heartbeats in eight seconds is well above a target of 10/s.
+    for (let i = 0; i < 400; i++) pacer.record(start + i * 20);
+    expect(pacer.nextIntervalSec(start + 9_000)).toBeGreaterThan(30);
+    expect(pacer.nextIntervalSec(start + 9_000)).toBeLessThanOrEqual(300);
+
+    // Two quiet windows later the base interval is back.
+    expect(pacer.nextIntervalSec(start + 35_000)).toBe(15);
+    expect(new HeartbeatPacer(15, 0).nextIntervalSec(start)).toBe(15);
+  });
+
+  it("serializes auction rows with ISO timestamps and string amounts", () => {
+    const endTime = new Date("2030-01-01T12:00:00.000Z");
+    const row = {
+      id: 7,
+      endTime,
+      leaseEnd: null,
+      reserve: new Prisma.Decimal("10"),
+      highestBid: new Prisma.Decimal("125.5"),
+      softBalance: BigInt(42)
+    };
+    expect(JSON.parse(JSON.stringify(serializeBigInt([row])))).toEqual([
+      { id: 7, endTime: "2030-01-01T12:00:00.000Z", leaseEnd: null, reserve: "10", highestBid: "125.5", softBalance: "42" }
+    ]);
+  });
+
+  it("stamps responses with the server receive time and handling duration", async () => {
+    const app = express();
+    app.use(serverTime());
+    app.get("/health", (_req, res) => res.json({ ok: true }));
+
+    const before = Date.now();
+    const resp = await request(app).get("/health");
+    expect(resp.status).toBe(200);
+    const stamped = Number(resp.headers["x-server-time"]);
+    expect(stamped).toBeGreaterThanOrEqual(before);
+    expect(stamped).toBeLessThanOrEqual(Date.now());
+    expect(resp.headers["server-timing"]).toMatch(/^app;dur=\d+(\.\d)?$/);
+  });
 });
@@ -0,0 +1,2 @@
+insert into telemetry_bucket_def(key,description) values
+ ('client.frametime','Client frame-time percentiles and hitch count per reporting window');
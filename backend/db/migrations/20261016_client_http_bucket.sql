@@ -0,0 +1,2 @@
+insert into telemetry_bucket_def(key,description) values
+ ('client.http','Client HTTP request counts, retries, failures and latency percentiles per priority class and reporting window');
@@ -0,0 +1,2 @@
+insert into telemetry_bucket_def(key,description) values
+ ('client.net','Client round-trip percentiles, failures and measured clock offset per host and reporting window');
@@ -0,0 +1,2 @@
+insert into telemetry_bucket_def(key,description) values
+ ('client.governor','Client scalability governor steps with the reason and thermal state behind each change');
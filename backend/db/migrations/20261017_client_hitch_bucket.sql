@@ -0,0 +1,2 @@
+insert into telemetry_bucket_def(key,description) values
+ ('client.hitch','Client hitch frames with per-thread timings and phone, shard, wanted and interaction context');
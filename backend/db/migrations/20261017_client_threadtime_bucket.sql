@@ -0,0 +1,2 @@
+insert into telemetry_bucket_def(key,description) values
+ ('client.threadtime','Client game, render, RHI and GPU thread-time percentiles per timer and reporting window');
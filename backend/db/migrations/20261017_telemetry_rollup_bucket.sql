@@ -0,0 +1,2 @@
+insert into telemetry_bucket_def(key,description) values
+ ('telemetry.rollup','Per-kind counts, suppressed counts and value sums for telemetry aggregated or rate limited on the client');
@@ -4,6 +4,7 @@ import { registerWantedRpcs } from "./rpc/wanted";
 import { registerFactionRpcs } from "./rpc/factions";
 import { registerCraftingRpc } from "./economy/crafting";
 import { registerShardMatch } from "./match/shard";
+import { registerShardMatchRpc } from "./rpc/shard";
 import { registerTransferRpc } from "./rpc/transfer";
 
 const Init: nkruntime.InitModule = (ctx) => {
@@ -26,6 +27,9 @@ const Init: nkruntime.InitModule = (ctx) => {
   const shardMatch = registerShardMatch(ctx);
   ctx.registerMatch(shardMatch.id, shardMatch.handler);
 
+  const shardMatchRpc = registerShardMatchRpc(ctx);
+  ctx.registerRpc(shardMatchRpc.id, shardMatchRpc.handler);
+
   const transferRpc = registerTransferRpc(ctx);
   ctx.registerRpc(transferRpc.id, transferRpc.handler);
 };
@@ -43,6 +43,7 @@ export const registerShardMatch = (ctx: nkruntime.InitContext) => {
         state.players.set(presence.userId, { presence, heat: 0, lastUpdate: now });
         logger.info(`player joined shard user=${presence.userId}`);
       }
+      dispatcher.broadcastMessage(4, JSON.stringify({ label: state.label, population: state.players.size }));
       return { state };
     },
     matchLeave: (_matchCtx, logger, nk, dispatcher, state, presences) => {
@@ -50,6 +51,7 @@ export const registerShardMatch = (ctx: nkruntime.InitContext) => {
         state.players.delete(presence.userId);
         logger.info(`player left shard user=${presence.userId}`);
       }
+      dispatcher.broadcastMessage(4, JSON.stringify({ label: state.label, population: state.players.size }));
       return { state };
     },
     matchLoop: async (matchCtx, logger, nk, dispatcher, state, messages) => {
@@ -0,0 +1,29 @@
+import type { nkruntime } from "@heroiclabs/nakama-runtime";
+
+interface ShardMatchPayload {
+  shardId?: number;
+}
+
+export const registerShardMatchRpc = (ctx: nkruntime.InitContext) => {
+  const moduleName = ctx.env?.MODULE_NAME ?? "riftline";
+  const rpcId = `${moduleName}_shardMatch`;
+
+  // One authoritative match per shard, found by label and created by whichever player asks first.
+  const handler: nkruntime.RpcFunction = (rpcCtx, logger, nk, payload) => {
+    if (!rpcCtx.userId) throw new Error("missing_user");
+    const input = (payload ? JSON.parse(payload) : {}) as ShardMatchPayload;
+    if (!Number.isInteger(input.shardId) || Number(input.shardId) < 0) throw new Error("invalid_shard");
+
+    const label = `${moduleName}_shard_${input.shardId}`;
+    const existing = nk.matchList(1, true, label);
+    if (existing.length > 0) {
+      return JSON.stringify({ matchId: existing[0].matchId });
+    }
+
+    const matchId = nk.matchCreate(`${moduleName}_match`, { label });
+    logger.info(`shard match created label=${label} match=${matchId}`);
+    return JSON.stringify({ matchId });
+  };
+
+  return { id: rpcId, handler };
+};
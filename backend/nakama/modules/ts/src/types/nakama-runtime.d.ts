@@ -48,6 +48,22 @@ declare namespace nkruntime {
     sessionUpdate(sessionId: string, vars: Record<string, string>): void;
     binaryToString?(value: unknown): string;
     rpc(id: string, payload?: string, userId?: string, username?: string): string | Promise<string>;
+    matchCreate(module: string, params?: Record<string, string>): string;
+    matchList(
+      limit: number,
+      authoritative?: boolean | null,
+      label?: string | null,
+      minSize?: number | null,
+      maxSize?: number | null,
+      query?: string | null
+    ): Match[];
+  }
+
+  interface Match {
+    matchId: string;
+    authoritative: boolean;
+    label: string;
+    size: number;
   }
 
   type RpcFunction = (
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""Stand-in for the slice of Nakama the UE client's realtime subsystem talks to.
+
+Serves device authentication, session refresh, the notification listing and the JSON WebSocket on one port, plus
+control endpoints for driving the client from a shell:
+
+  POST /standin/notify  {"subject": "wanted", "content": {...}}   persistent notification, pushed to open sockets
+  POST /standin/match   {"op_code": 2, "data": {...}}             match data broadcast to open sockets
+  POST /standin/drop                                              closes every socket (exercises reconnect)
+  POST /standin/mute    {"muted": true}                           stops answering pings (exercises dead-socket detection)
+
+Only the standard library is used so it runs on any Linux box:
+  ./scripts/dev/nakama-standin.py --port 7350
+  RIFTLINE_NAKAMA_URL=http://127.0.0.1:7350 <run the game>
+"""
+
+import argparse
+import base64
+import datetime
+import hashlib
+import json
+import socketserver
+import struct
+import threading
+import time
+import uuid
+from http import HTTPStatus
+from urllib.parse import parse_qs, urlparse
+
+WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+
+class State:
+    def __init__(self, token_ttl):
+        self.token_ttl = token_ttl
+        self.lock = threading.Lock()
+        self.sockets = []
+        self.notifications = []
+        self.muted = False
+
+    def issue_session(self, user_id):
+        def segment(value):
+            return base64.urlsafe_b64encode(json.dumps(value).encode()).rstrip(b"=").decode()
+
+        claims = {"uid": user_id, "usn": user_id[:8], "exp": int(time.time()) + self.token_ttl}
+        token = ".".join([segment({"alg": "none", "typ": "JWT"}), segment(claims), "standin"])
+        refresh = ".".join([segment({"alg": "none", "typ": "JWT"}), segment({"uid": user_id}), "refresh"])
+        return {"created": False, "token": token, "refresh_token": refresh}
+
+    def broadcast(self, envelope):
+        with self.lock:
+            sockets = list(self.sockets)
+        for sock in sockets:
+            sock.send_text(json.dumps(envelope))
+
+
+def user_from_token(token):
+    try:
+        payload = token.split(".")[1]
+        payload += "=" * (-len(payload) % 4)
+        return json.loads(base64.urlsafe_b64decode(payload))["uid"]
+    except (IndexError, KeyError, ValueError):
+        return None
+
+
+class Handler(socketserver.StreamRequestHandler):
+    state = None
+
+    def handle(self):
+        request_line = self.rfile.readline().decode("latin-1").strip()
+        if not request_line:
+            return
+        method, target, _ = request_line.split(" ", 2)
+        headers = {}
+        while True:
+            line = self.rfile.readline().decode("latin-1").strip()
+            if not line:
+                break
+            name, _, value = line.partition(":")
+            headers[name.strip().lower()] = value.strip()
+        length = int(headers.get("content-length", "0") or 0)
+        body = self.rfile.read(length) if length else b""
+
+        url = urlparse(target)
+        query = parse_qs(url.query)
+        if url.path == "/ws" and headers.get("upgrade", "").lower() == "websocket":
+            self.serve_socket(headers, query)
+        else:
+            self.serve_http(method, url.path, query, body)
+
+    # HTTP
+
+    def reply(self, status, payload=None):
+        data = json.dumps(payload if payload is not None else {}).encode()
+        self.wfile.write(
+            f"HTTP/1.1 {status.value} {status.phrase}\r\nContent-Type: application/json\r\n"
+            f"Content-Length: {len(data)}\r\nConnection: close\r\n\r\n".encode() + data
+        )
+
+    def serve_http(self, method, path, query, body):
+        state = self.state
+        payload = json.loads(body) if body else {}
+        if method == "POST" and path == "/v2/account/authenticate/device":
+            device = payload.get("id", "")
+            if len(device) < 10:
+                return self.reply(HTTPStatus.BAD_REQUEST, {"error": "device id too short"})
+            return self.reply(HTTPStatus.OK, state.issue_session(str(uuid.uuid5(uuid.NAMESPACE_OID, device))))
+        if method == "POST" and path == "/v2/account/session/refresh":
+            user_id = user_from_token(payload.get("token", ""))
+            if not user_id:
+                return self.reply(HTTPStatus.UNAUTHORIZED, {"error": "invalid refresh token"})
+            return self.reply(HTTPStatus.OK, state.issue_session(user_id))
+        if method == "GET" and path == "/v2/notification":
+            limit = int(query.get("limit", ["100"])[0])
+            start = int(query.get("cacheable_cursor", ["0"])[0] or 0)
+            with state.lock:
+                page = state.notifications[start:start + limit]
+                cursor = str(start + len(page))
+            return self.reply(HTTPStatus.OK, {"notifications": page, "cacheable_cursor": cursor})
+        if method == "POST" and path == "/standin/notify":
+            notification = {
+                "id": str(uuid.uuid4()),
+                "subject": payload["subject"],
+                "content": json.dumps(payload.get("content", {})),
+                "code": 1,
+                "persistent": True,
+                "create_time": datetime.datetime.now(datetime.timezone.utc).isoformat(timespec="milliseconds").replace("+00:00", "Z"),
+            }
+            with state.lock:
+                state.notifications.append(notification)
+            state.broadcast({"notifications": {"notifications": [notification]}})
+            return self.reply(HTTPStatus.OK, notification)
+        if method == "POST" and path == "/standin/match":
+            data = base64.b64encode(json.dumps(payload.get("data", {})).encode()).decode()
+            state.broadcast({"match_data": {"match_id": "standin.shard", "op_code": str(payload.get("op_code", 0)), "data": data}})
+            return self.reply(HTTPStatus.OK)
+        if method == "POST" and path == "/standin/drop":
+            with state.lock:
+                sockets = list(state.sockets)
+            for sock in sockets:
+                sock.close_socket()
+            return self.reply(HTTPStatus.OK, {"dropped": len(sockets)})
+        if method == "POST" and path == "/standin/mute":
+            state.muted = bool(payload.get("muted", True))
+            return self.reply(HTTPStatus.OK, {"muted": state.muted})
+        return self.reply(HTTPStatus.NOT_FOUND, {"error": path})
+
+    # WebSocket
+
+    def serve_socket(self, headers, query):
+        if user_from_token(query.get("token", [""])[0]) is None:
+            return self.reply(HTTPStatus.UNAUTHORIZED, {"error": "invalid token"})
+        accept = base64.b64encode(hashlib.sha1((headers["sec-websocket-key"] + WS_GUID).encode()).digest()).decode()
+        self.wfile.write(
+            "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+            f"Sec-WebSocket-Accept: {accept}\r\n\r\n".encode()
+        )
+        self.send_lock = threading.Lock()
+        self.closed = False
+        with self.state.lock:
+            self.state.sockets.append(self)
+        try:
+            while not self.closed:
+                frame = self.read_frame()
+                if frame is None:
+                    break
+                opcode, data = frame
+                if opcode == 0x8:
+                    break
+                if opcode == 0x9:
+                    self.send_frame(0xA, data)
+                elif opcode == 0x1:
+                    self.handle_envelope(json.loads(data))
+        except (ConnectionError, OSError, ValueError):
+            pass
+        finally:
+            with self.state.lock:
+                if self in self.state.sockets:
+                    self.state.sockets.remove(self)
+
+    def handle_envelope(self, envelope):
+        cid = envelope.get("cid", "")
+        if "ping" in envelope:
+            if not self.state.muted:
+                self.send_text(json.dumps({"cid": cid, "pong": {}}))
+        elif "match_join" in envelope:
+            match_id = envelope["match_join"].get("match_id", "")
+            self.send_text(json.dumps({"cid": cid, "match": {"match_id": match_id, "authoritative": True, "size": 1}}))
+        else:
+            self.send_text(json.dumps({"cid": cid, "error": {"code": 3, "message": "unsupported by the stand-in"}}))
+
+    def read_exact(self, count):
+        data = self.rfile.read(count)
+        if len(data) < count:
+            raise ConnectionError("socket closed")
+        return data
+
+    def read_frame(self):
+        head = self.rfile.read(2)
+        if len(head) < 2:
+            return None
+        opcode = head[0] & 0x0F
+        masked = head[1] & 0x80
+        length = head[1] & 0x7F
+        if length == 126:
+            length = struct.unpack("!H", self.read_exact(2))[0]
+        elif length == 127:
+            length = struct.unpack("!Q", self.read_exact(8))[0]
+        mask = self.read_exact(4) if masked else b"\0\0\0\0"
+        payload = bytes(b ^ mask[i % 4] for i, b in enumerate(self.read_exact(length)))
+        return opcode, payload
+
+    def send_frame(self, opcode, payload):
+        header = bytes([0x80 | opcode])
+        if len(payload) < 126:
+            header += bytes([len(payload)])
+        elif len(payload) < 65536:
+            header += bytes([126]) + struct.pack("!H", len(payload))
+        else:
+            header += bytes([127]) + struct.pack("!Q", len(payload))
+        with self.send_lock:
+            self.wfile.write(header + payload)
+            self.wfile.flush()
+
+    def send_text(self, text):
+        try:
+            self.send_frame(0x1, text.encode())
+        except OSError:
+            pass
+
+    def close_socket(self):
+        self.closed = True
+        try:
+            self.send_frame(0x8, struct.pack("!H", 1001))
+        except OSError:
+            pass
+        self.connection.close()
+
+
+class Server(socketserver.ThreadingTCPServer):
+    allow_reuse_address = True
+    daemon_threads = True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=7350)
+    parser.add_argument("--token-ttl", type=int, default=3600, help="session lifetime in seconds")
+    args = parser.parse_args()
+
+    Handler.state = State(args.token_ttl)
+    with Server((args.host, args.port), Handler) as server:
+        print(f"Nakama stand-in listening on http://{args.host}:{args.port}")
+        server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
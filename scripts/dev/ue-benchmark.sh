@@ -0,0 +1,10 @@
+#!/usr/bin/env bash
+set -euo pipefail
+# Runs the Riftline headless benchmark and exits non-zero on a regression against the stored baseline.
+# Needs UE_ROOT pointing at an Unreal Engine 5.3 install; extra arguments go to the commandlet,
+# e.g. -updatebaseline or -scenarios=phone.tabs,auction.storm.
+: "${UE_ROOT:?Set UE_ROOT to the Unreal Engine install}"
+ROOT="$(cd "$(dirname "$0")/../.." && pwd)"
+echo "Running Riftline benchmark..."
+"$UE_ROOT/Engine/Binaries/Linux/UnrealEditor-Cmd" "$ROOT/apps/engine-ue5/Riftline.uproject" \
+  -run=RiftlineBenchmark -nullrhi -unattended -nopause -nosplash -stdout "$@"